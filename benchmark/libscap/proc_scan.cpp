@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap.h>
+#include <libscap/scap-int.h>
+#include <libscap/scap_procs.h>
+#include <libscap/linux/scap_linux_platform.h>
+#include <benchmark/benchmark.h>
+
+extern "C" {
+#include <libscap/linux/scap_linux_int.h>
+}
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace std::string_literals;
+
+static constexpr uint32_t PROCFS_PROCS = 1000;
+static constexpr uint32_t PROCFS_THREADS = 4;
+static constexpr uint32_t PROCFS_FDS = 16;
+
+static void write_file(const fs::path& path, const std::string& content) {
+	std::ofstream f(path, std::ios::binary);
+	f << content;
+}
+
+static void make_fake_task(const fs::path& dir, uint32_t pid, uint32_t tid) {
+	fs::create_directories(dir / "fd");
+	const std::string p = std::to_string(pid);
+	const std::string t = std::to_string(tid);
+	write_file(dir / "cmdline", "/usr/bin/app\0--id\0"s + p + "\0"s);
+	write_file(dir / "comm", "app\n");
+	write_file(dir / "environ", "HOME=/root\0PATH=/usr/bin\0"s);
+	write_file(dir / "status",
+	           "Name:\tapp\nState:\tS (sleeping)\nTgid:\t" + p + "\nPid:\t" + t +
+	                   "\nPPid:\t1\nUid:\t0\t0\t0\t0\nGid:\t0\t0\t0\t0\nNStgid:\t" + p +
+	                   "\nNSpid:\t" + t + "\nNSpgid:\t" + p +
+	                   "\nVmSize:\t1000 kB\nVmRSS:\t100 kB\nVmSwap:\t0 kB\n");
+	write_file(dir / "stat", t + " (app) S 1 " + p + " " + p + " 0 -1 4194560 10 0 2 0\n");
+	write_file(dir / "loginuid", "0");
+	fs::create_symlink("/usr/bin/env", dir / "exe");
+	fs::create_symlink("/", dir / "cwd");
+	fs::create_symlink("/", dir / "root");
+	for(uint32_t fd = 0; fd < PROCFS_FDS; fd++) {
+		fs::create_symlink(fd % 2 ? "/" : "/dev/null", dir / "fd" / std::to_string(fd));
+	}
+}
+
+// Build a fake procfs once, it is shared by all the benchmarks.
+static const std::string& procfs_path() {
+	static std::string path = [] {
+		char tmpl[] = "/tmp/scap_bench_procfs_XXXXXX";
+		if(mkdtemp(tmpl) == nullptr) {
+			return std::string();
+		}
+		for(uint32_t j = 0; j < PROCFS_PROCS; j++) {
+			const uint32_t pid = 1000 + j * 100;
+			const fs::path dir = fs::path(tmpl) / std::to_string(pid);
+			make_fake_task(dir, pid, pid);
+			for(uint32_t k = 0; k < PROCFS_THREADS; k++) {
+				make_fake_task(dir / "task" / std::to_string(pid + k), pid, pid + k);
+			}
+		}
+		std::atexit([] { fs::remove_all(procfs_path()); });
+		return std::string(tmpl);
+	}();
+	return path;
+}
+
+// Time to scan the fake procfs with `state.range(0)` threads, `0` being the serial scan.
+static void BM_proc_scan(benchmark::State& state) {
+	std::string path = procfs_path();
+	if(path.empty()) {
+		state.SkipWithError("cannot create the fake procfs");
+		return;
+	}
+
+	scap_linux_platform platform = {};
+	char error[SCAP_LASTERR_SIZE];
+	platform.m_lasterr = error;
+	platform.m_proc_scan_threads = state.range(0);
+
+	scap_proc_callbacks callbacks{};
+	callbacks.m_refresh_start_cb = default_refresh_start_end_callback;
+	callbacks.m_refresh_end_cb = default_refresh_start_end_callback;
+	scap_proclist proclist;
+
+	for(auto _ : state) {
+		init_proclist(&proclist, callbacks);
+		if(scap_linux_scan_proc_dir(&platform, &proclist, path.data(), error) != SCAP_SUCCESS) {
+			state.SkipWithError(error);
+			return;
+		}
+		state.PauseTiming();
+		scap_proc_free_table(&proclist);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * PROCFS_PROCS * PROCFS_THREADS);
+}
+BENCHMARK(BM_proc_scan)->Arg(0)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap.h>
+#include <sys/param.h>
+#include <libscap/ringbuffer/ringbuffer.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+// Number of events written in every per-CPU buffer, enough to stay above
+// `BUFFER_EMPTY_THRESHOLD_B` so that a refill never sleeps.
+static constexpr uint32_t EVENTS_PER_DEVICE = 1024;
+
+// Per-event cost of `ringbuffer_next()` merging `state.range(0)` per-CPU buffers whose events
+// interleave randomly in time. With the heap-based merge this should grow with log(ncpus) rather
+// than linearly.
+static void BM_ringbuffer_next(benchmark::State& state) {
+	const uint32_t ndevs = state.range(0);
+	const unsigned long buffer_size = (EVENTS_PER_DEVICE + 1) * sizeof(scap_evt);
+	std::vector<std::vector<char>> buffers(ndevs, std::vector<char>(buffer_size));
+	std::vector<ppm_ring_buffer_info> bufinfos(ndevs);
+	char lasterr[SCAP_LASTERR_SIZE];
+	scap_device_set devset;
+
+	if(devset_init(&devset, ndevs, lasterr) != SCAP_SUCCESS) {
+		state.SkipWithError(lasterr);
+		return;
+	}
+
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<uint64_t> gap(1, 1000);
+	for(uint32_t j = 0; j < ndevs; j++) {
+		scap_device* dev = &devset.m_devs[j];
+		dev->m_buffer = buffers[j].data();
+		dev->m_buffer_size = buffer_size;
+		dev->m_bufinfo = &bufinfos[j];
+
+		uint64_t ts = 0;
+		for(uint32_t i = 0; i < EVENTS_PER_DEVICE; i++) {
+			scap_evt evt = {};
+			ts += gap(rng);
+			evt.ts = ts;
+			evt.len = sizeof(scap_evt);
+			memcpy(dev->m_buffer + i * sizeof(scap_evt), &evt, sizeof(evt));
+		}
+		bufinfos[j].head = EVENTS_PER_DEVICE * sizeof(scap_evt);
+	}
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	uint64_t remaining = 0;
+	for(auto _ : state) {
+		if(remaining == 0) {
+			// Pretend the producers have written the same events again.
+			state.PauseTiming();
+			for(uint32_t j = 0; j < ndevs; j++) {
+				devset.m_devs[j].m_lastreadsize = 0;
+				devset.m_devs[j].m_sn_len = 0;
+				bufinfos[j].tail = 0;
+			}
+			ts_heap_clear(&devset.m_heap);
+			devset.m_last_devid = DEVSET_NO_DEVICE;
+			ringbuffer_next(&devset, &evt, &devid, &flags);
+			remaining = (uint64_t)ndevs * EVENTS_PER_DEVICE;
+			state.ResumeTiming();
+		}
+		benchmark::DoNotOptimize(ringbuffer_next(&devset, &evt, &devid, &flags));
+		remaining--;
+	}
+
+	free(devset.m_devs);
+	ts_heap_free(&devset.m_heap);
+}
+BENCHMARK(BM_ringbuffer_next)->RangeMultiplier(4)->Range(1, 256);
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap.h>
+#include <libscap/scap_engines.h>
+#include <libscap/scap_procs.h>
+#include <libscap/scap_platform.h>
+#include <libscap/scap_savefile_api.h>
+#include <libscap/engine/savefile/savefile_public.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+static constexpr uint32_t SAVEFILE_EVENTS = 100000;
+
+// Write a capture of `SAVEFILE_EVENTS` generic events once, it is shared by all the benchmarks.
+static const std::string& savefile_path() {
+	static std::string path = [] {
+		char tmpl[] = "/tmp/scap_bench_XXXXXX";
+		int fd = mkstemp(tmpl);
+		if(fd < 0) {
+			return std::string();
+		}
+		close(fd);
+
+		char error[SCAP_LASTERR_SIZE];
+		scap_dumper_t* d = scap_dump_open(nullptr, tmpl, SCAP_COMPRESSION_NONE, error);
+		if(d == nullptr) {
+			return std::string();
+		}
+		for(uint32_t j = 0; j < SAVEFILE_EVENTS; j++) {
+			scap_evt* evt =
+			        scap_create_event(error, j + 1, 1, PPME_GENERIC_X, 2, (uint16_t)j, (uint16_t)j);
+			scap_dump(d, evt, j % 8, 0);
+			free(evt);
+		}
+		scap_dump_close(d);
+		std::atexit([] { remove(savefile_path().c_str()); });
+		return std::string(tmpl);
+	}();
+	return path;
+}
+
+// Time to read the whole capture, fetching `state.range(0)` events per call: `1` uses
+// `scap_next()`, anything else `scap_next_batch()`. `state.range(1)` maps the file instead
+// of reading it through zlib.
+static void BM_savefile_next_batch(benchmark::State& state) {
+	const uint32_t batch_size = state.range(0);
+	const bool use_mmap = state.range(1) != 0;
+	const std::string& path = savefile_path();
+	if(path.empty()) {
+		state.SkipWithError("cannot write the capture");
+		return;
+	}
+
+	scap_proc_callbacks callbacks{};
+	callbacks.m_refresh_start_cb = default_refresh_start_end_callback;
+	callbacks.m_refresh_end_cb = default_refresh_start_end_callback;
+	callbacks.m_proc_entry_cb = default_proc_entry_callback;
+
+	std::vector<scap_evt*> evts(batch_size);
+	std::vector<uint16_t> devids(batch_size);
+	std::vector<uint32_t> flags(batch_size);
+	uint64_t sum = 0;
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		scap_savefile_engine_params params{};
+		params.fname = path.c_str();
+		params.use_mmap = use_mmap;
+		params.platform = scap_savefile_alloc_platform(callbacks);
+		scap_open_args oargs{};
+		oargs.engine_params = &params;
+		char error[SCAP_LASTERR_SIZE];
+		int32_t rc;
+		scap_t* h = scap_open(&oargs, &scap_savefile_engine, error, &rc);
+		if(h == nullptr) {
+			state.SkipWithError(error);
+			return;
+		}
+		state.ResumeTiming();
+
+		if(batch_size == 1) {
+			while(scap_next(h, evts.data(), devids.data(), flags.data()) == SCAP_SUCCESS) {
+				sum += evts[0]->ts;
+			}
+		} else {
+			uint32_t n = 0;
+			while(scap_next_batch(h, evts.data(), devids.data(), flags.data(), batch_size, &n) ==
+			      SCAP_SUCCESS) {
+				for(uint32_t j = 0; j < n; j++) {
+					sum += evts[j]->ts;
+				}
+			}
+		}
+
+		state.PauseTiming();
+		scap_platform_close(params.platform);
+		scap_platform_free(params.platform);
+		scap_close(h);
+		state.ResumeTiming();
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * SAVEFILE_EVENTS);
+}
+BENCHMARK(BM_savefile_next_batch)->ArgsProduct({{1, 16, 64, 256}, {0, 1}});
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+
+#include <libsinsp/sinsp.h>
+#include <libscap/scap.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+static constexpr uint32_t PIPELINE_EVENTS = 200000;
+static constexpr uint32_t PIPELINE_THREADS = 64;
+static constexpr uint32_t PIPELINE_BATCH_SIZE = 256;
+
+// Write a capture of file opens and reads from `PIPELINE_THREADS` threads
+// once, it is shared by all the runs.
+static const std::string& pipeline_capture_path() {
+	static std::string path = [] {
+		char tmpl[] = "/tmp/sinsp_bench_XXXXXX";
+		int fd = mkstemp(tmpl);
+		if(fd < 0) {
+			return std::string();
+		}
+		close(fd);
+
+		char error[SCAP_LASTERR_SIZE];
+		scap_dumper_t* d = scap_dump_open(nullptr, tmpl, SCAP_COMPRESSION_NONE, error);
+		if(d == nullptr) {
+			return std::string();
+		}
+		char data[64] = {};
+		for(uint32_t j = 0; j < PIPELINE_EVENTS; j++) {
+			const uint64_t ts = j + 1;
+			const int64_t tid = 100 + j % PIPELINE_THREADS;
+			const int64_t evt_fd = 3 + (j / PIPELINE_THREADS) % 16;
+			scap_evt* evt;
+			if((j / PIPELINE_THREADS) % 16 == 0) {
+				std::string name = "/tmp/file_" + std::to_string(evt_fd);
+				evt = scap_create_event(error,
+				                        ts,
+				                        tid,
+				                        PPME_SYSCALL_OPEN_X,
+				                        6,
+				                        evt_fd,
+				                        name.c_str(),
+				                        (uint32_t)0,
+				                        (uint32_t)0,
+				                        (uint32_t)0,
+				                        (uint64_t)j);
+			} else {
+				evt = scap_create_event(error,
+				                        ts,
+				                        tid,
+				                        PPME_SYSCALL_READ_X,
+				                        4,
+				                        (int64_t)sizeof(data),
+				                        scap_const_sized_buffer{data, sizeof(data)},
+				                        evt_fd,
+				                        (uint32_t)sizeof(data));
+			}
+			if(evt == nullptr) {
+				scap_dump_close(d);
+				return std::string();
+			}
+			scap_dump(d, evt, j % 8, 0);
+			free(evt);
+		}
+		scap_dump_close(d);
+		std::atexit([] { remove(pipeline_capture_path().c_str()); });
+		return std::string(tmpl);
+	}();
+	return path;
+}
+
+// Time to parse the whole capture with `state.range(0)` decoding threads,
+// 0 decodes the events on the parsing thread as usual. Real time is measured,
+// as the work of the decoding threads is not accounted in the CPU time of the
+// benchmark thread; the speedup depends on the cores available to them.
+static void BM_sinsp_next_decode_workers(benchmark::State& state) {
+	const std::string& path = pipeline_capture_path();
+	if(path.empty()) {
+		state.SkipWithError("cannot write the capture");
+		return;
+	}
+
+	uint64_t nevts = 0;
+	for(auto _ : state) {
+		state.PauseTiming();
+		auto inspector = std::make_unique<sinsp>();
+		inspector->set_scap_batch_size(PIPELINE_BATCH_SIZE);
+		inspector->set_decode_workers(state.range(0));
+		inspector->open_savefile(path);
+		state.ResumeTiming();
+
+		sinsp_evt* evt;
+		int32_t res;
+		while((res = inspector->next(&evt)) == SCAP_SUCCESS || res == SCAP_TIMEOUT) {
+			nevts++;
+		}
+
+		state.PauseTiming();
+		inspector.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(nevts);
+}
+BENCHMARK(BM_sinsp_next_decode_workers)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
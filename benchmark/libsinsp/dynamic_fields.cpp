@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/state/extensible_struct.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace libsinsp::state;
+
+namespace {
+
+struct sample_entry : public extensible_struct {
+	sample_entry(const std::shared_ptr<dynamic_field_infos>& i): extensible_struct(i) {}
+};
+
+// A table whose entries carry the fields a few plugins would add.
+struct sample_table {
+	sample_table(size_t n):
+	        defs(dynamic_field_infos::make<sample_entry>()),
+	        u64(defs->add_field("u64", SS_PLUGIN_ST_UINT64).into<uint64_t>()),
+	        u32(defs->add_field("u32", SS_PLUGIN_ST_UINT32).into<uint32_t>()),
+	        flag(defs->add_field("flag", SS_PLUGIN_ST_BOOL).into<bool>()),
+	        str(defs->add_field("str", SS_PLUGIN_ST_STRING).into<std::string>()),
+	        u16(defs->add_field("u16", SS_PLUGIN_ST_UINT16).into<uint16_t>()),
+	        s64(defs->add_field("s64", SS_PLUGIN_ST_INT64).into<int64_t>()) {
+		entries.reserve(n);
+		for(size_t i = 0; i < n; i++) {
+			write(entries.emplace_back(defs), i);
+		}
+	}
+
+	void write(sample_entry& e, uint64_t i) {
+		e.write_field(u64, i);
+		e.write_field(u32, (uint32_t)i);
+		e.write_field(flag, true);
+		e.write_field(str, std::string("container-id"));
+		e.write_field(u16, (uint16_t)i);
+		e.write_field(s64, -(int64_t)i);
+	}
+
+	std::shared_ptr<dynamic_field_infos> defs;
+	accessor::typed_ptr<uint64_t> u64;
+	accessor::typed_ptr<uint32_t> u32;
+	accessor::typed_ptr<bool> flag;
+	accessor::typed_ptr<std::string> str;
+	accessor::typed_ptr<uint16_t> u16;
+	accessor::typed_ptr<int64_t> s64;
+	std::vector<sample_entry> entries;
+};
+
+}  // namespace
+
+static void BM_dynamic_fields_read(benchmark::State& state) {
+	sample_table table(state.range(0));
+	size_t i = 0;
+	for(auto _ : state) {
+		auto& e = table.entries[i++ % table.entries.size()];
+		uint64_t u64;
+		uint32_t u32;
+		e.read_field(table.u64, u64);
+		e.read_field(table.u32, u32);
+		benchmark::DoNotOptimize(u64 + u32);
+	}
+}
+BENCHMARK(BM_dynamic_fields_read)->Arg(1000)->Arg(100000);
+
+static void BM_dynamic_fields_read_string(benchmark::State& state) {
+	sample_table table(state.range(0));
+	size_t i = 0;
+	for(auto _ : state) {
+		auto& e = table.entries[i++ % table.entries.size()];
+		const char* str = nullptr;
+		e.read_field(table.str, str);
+		benchmark::DoNotOptimize(str);
+	}
+}
+BENCHMARK(BM_dynamic_fields_read_string)->Arg(1000)->Arg(100000);
+
+static void BM_dynamic_fields_write(benchmark::State& state) {
+	sample_table table(state.range(0));
+	size_t i = 0;
+	for(auto _ : state) {
+		auto& e = table.entries[i % table.entries.size()];
+		table.write(e, i++);
+	}
+}
+BENCHMARK(BM_dynamic_fields_write)->Arg(1000)->Arg(100000);
+
+// New entries: the storage of the fields is allocated on the first write.
+static void BM_dynamic_fields_create(benchmark::State& state) {
+	sample_table table(0);
+	for(auto _ : state) {
+		sample_entry e(table.defs);
+		table.write(e, 1);
+		benchmark::DoNotOptimize(e);
+	}
+}
+BENCHMARK(BM_dynamic_fields_create);
+
+// Entries are copied when threads are cloned.
+static void BM_dynamic_fields_copy(benchmark::State& state) {
+	sample_table table(1);
+	for(auto _ : state) {
+		sample_entry e(table.entries[0]);
+		benchmark::DoNotOptimize(e);
+	}
+}
+BENCHMARK(BM_dynamic_fields_copy);
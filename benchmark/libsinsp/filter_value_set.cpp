@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_value_set.h>
+#include <libsinsp/prefix_search.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// `state.range(0)` values looking like the binaries of an `in (...)` list, and as many
+// lookups, half of which are misses.
+struct in_list {
+	in_list(size_t n) {
+		for(size_t i = 0; i < n; i++) {
+			values.push_back("/usr/bin/binary" + std::to_string(i * 7919));
+			lookups.push_back(values.back());
+			lookups.push_back("/usr/sbin/other" + std::to_string(i));
+		}
+	}
+
+	static filter_value_t to_value(const std::string& str) {
+		return filter_value_t((uint8_t*)str.data(), (uint32_t)str.size());
+	}
+
+	std::vector<std::string> values;
+	std::vector<std::string> lookups;
+};
+
+static void BM_filter_in_unordered_set(benchmark::State& state) {
+	in_list list(state.range(0));
+	std::unordered_set<filter_value_t, g_hash_membuf, g_equal_to_membuf> set;
+	for(const auto& v : list.values) {
+		set.insert(in_list::to_value(v));
+	}
+
+	size_t i = 0;
+	for(auto _ : state) {
+		const auto& v = list.lookups[i++ % list.lookups.size()];
+		benchmark::DoNotOptimize(set.find(in_list::to_value(v)) != set.end());
+	}
+}
+BENCHMARK(BM_filter_in_unordered_set)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_filter_in_value_set(benchmark::State& state) {
+	in_list list(state.range(0));
+	filter_value_set set;
+	for(const auto& v : list.values) {
+		set.insert(in_list::to_value(v));
+	}
+
+	size_t i = 0;
+	for(auto _ : state) {
+		const auto& v = list.lookups[i++ % list.lookups.size()];
+		benchmark::DoNotOptimize(set.contains(in_list::to_value(v)));
+	}
+}
+BENCHMARK(BM_filter_in_value_set)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_filter_pmatch(benchmark::State& state) {
+	std::vector<std::string> paths;
+	path_prefix_search search;
+	for(int64_t i = 0; i < state.range(0); i++) {
+		search.add_search_path("/opt/app" + std::to_string(i) + "/lib");
+		paths.push_back("/opt/app" + std::to_string(i) + "/lib/libfoo.so");
+		paths.push_back("/opt/app" + std::to_string(i) + "/bin/foo");
+	}
+
+	size_t i = 0;
+	for(auto _ : state) {
+		const auto& p = paths[i++ % paths.size()];
+		benchmark::DoNotOptimize(search.match(in_list::to_value(p)));
+	}
+}
+BENCHMARK(BM_filter_pmatch)->Arg(10)->Arg(100)->Arg(1000);
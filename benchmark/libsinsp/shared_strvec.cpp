@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/shared_strvec.h>
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+// An environment like the ones of the processes in a container.
+static std::vector<std::string> make_env(size_t n) {
+	std::vector<std::string> env;
+	for(size_t i = 0; i < n; i++) {
+		env.push_back("VARIABLE_" + std::to_string(i) + "=/some/value/of/average/length");
+	}
+	return env;
+}
+
+// Copy done for every clone() of a process.
+static void BM_strvec_copy_vector(benchmark::State& state) {
+	auto env = make_env(state.range(0));
+	for(auto _ : state) {
+		std::vector<std::string> copy = env;
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(BM_strvec_copy_vector)->Arg(8)->Arg(64);
+
+static void BM_strvec_copy_shared(benchmark::State& state) {
+	sinsp_shared_strvec env = make_env(state.range(0));
+	for(auto _ : state) {
+		sinsp_shared_strvec copy = env;
+		benchmark::DoNotOptimize(copy.shared_id());
+	}
+}
+BENCHMARK(BM_strvec_copy_shared)->Arg(8)->Arg(64);
+
+// Values set from an event or from /proc, and found in the pool.
+static void BM_strvec_assign_interned(benchmark::State& state) {
+	sinsp_shared_strvec env = make_env(state.range(0));
+	auto values = make_env(state.range(0));
+	for(auto _ : state) {
+		sinsp_shared_strvec other = std::vector<std::string>(values);
+		benchmark::DoNotOptimize(other.shared_id());
+	}
+}
+BENCHMARK(BM_strvec_assign_interned)->Arg(8)->Arg(64);
+
+static void BM_strvec_assign_vector(benchmark::State& state) {
+	auto values = make_env(state.range(0));
+	for(auto _ : state) {
+		std::vector<std::string> other = std::vector<std::string>(values);
+		benchmark::DoNotOptimize(other.data());
+	}
+}
+BENCHMARK(BM_strvec_assign_vector)->Arg(8)->Arg(64);
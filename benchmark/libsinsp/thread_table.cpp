@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/tid_map.h>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// The objects are tiny: we measure the table and not the thread infos, so
+// that tables of up to 1M entries fit in memory.
+struct fake_threadinfo {
+	int64_t tid;
+	uint64_t lastaccess_ts = 0;
+};
+
+using fake_ptr_t = std::shared_ptr<fake_threadinfo>;
+
+// tids as assigned by the kernel: mostly sequential, with gaps
+static std::vector<int64_t> make_tids(size_t n) {
+	std::mt19937_64 rng(42);
+	std::vector<int64_t> tids;
+	int64_t tid = 1;
+	for(size_t i = 0; i < n; i++) {
+		tid += 1 + rng() % 8;
+		tids.push_back(tid);
+	}
+	return tids;
+}
+
+// lookups of the tids in random order, as events come from random threads
+static std::vector<int64_t> make_lookups(const std::vector<int64_t>& tids) {
+	std::vector<int64_t> lookups = tids;
+	std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(7));
+	return lookups;
+}
+
+static void BM_thread_table_lookup_unordered_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	auto lookups = make_lookups(tids);
+	std::unordered_map<int64_t, fake_ptr_t> map;
+	for(auto tid : tids) {
+		map[tid] = std::make_shared<fake_threadinfo>(fake_threadinfo{tid});
+	}
+
+	size_t i = 0;
+	for(auto _ : state) {
+		auto it = map.find(lookups[i++ % lookups.size()]);
+		it->second->lastaccess_ts++;
+		benchmark::DoNotOptimize(it);
+	}
+}
+BENCHMARK(BM_thread_table_lookup_unordered_map)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+static void BM_thread_table_lookup_tid_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	auto lookups = make_lookups(tids);
+	tid_map<fake_threadinfo> map;
+	for(auto tid : tids) {
+		map.put(tid, std::make_shared<fake_threadinfo>(fake_threadinfo{tid}));
+	}
+
+	size_t i = 0;
+	for(auto _ : state) {
+		auto tinfo = map.get(lookups[i++ % lookups.size()]);
+		tinfo->lastaccess_ts++;
+		benchmark::DoNotOptimize(tinfo);
+	}
+}
+BENCHMARK(BM_thread_table_lookup_tid_map)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+// A thread exits and a new one is created, with the table at a steady size.
+static void BM_thread_table_churn_unordered_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	std::unordered_map<int64_t, fake_ptr_t> map;
+	for(auto tid : tids) {
+		map[tid] = std::make_shared<fake_threadinfo>(fake_threadinfo{tid});
+	}
+	auto obj = std::make_shared<fake_threadinfo>(fake_threadinfo{0});
+
+	size_t i = 0;
+	int64_t next_tid = tids.back() + 1;
+	for(auto _ : state) {
+		auto& tid = tids[i++ % tids.size()];
+		map.erase(tid);
+		tid = next_tid++;
+		map[tid] = obj;
+	}
+}
+BENCHMARK(BM_thread_table_churn_unordered_map)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+static void BM_thread_table_churn_tid_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	tid_map<fake_threadinfo> map;
+	for(auto tid : tids) {
+		map.put(tid, std::make_shared<fake_threadinfo>(fake_threadinfo{tid}));
+	}
+	auto obj = std::make_shared<fake_threadinfo>(fake_threadinfo{0});
+
+	size_t i = 0;
+	int64_t next_tid = tids.back() + 1;
+	for(auto _ : state) {
+		auto& tid = tids[i++ % tids.size()];
+		map.erase(tid);
+		tid = next_tid++;
+		map.put(tid, obj);
+	}
+}
+BENCHMARK(BM_thread_table_churn_tid_map)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+static void BM_thread_table_insert_unordered_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	auto obj = std::make_shared<fake_threadinfo>(fake_threadinfo{0});
+	for(auto _ : state) {
+		std::unordered_map<int64_t, fake_ptr_t> map;
+		for(auto tid : tids) {
+			map[tid] = obj;
+		}
+		benchmark::DoNotOptimize(map.size());
+	}
+	state.SetItemsProcessed(state.iterations() * tids.size());
+}
+BENCHMARK(BM_thread_table_insert_unordered_map)->Arg(10000)->Arg(100000)->Arg(1000000);
+
+static void BM_thread_table_insert_tid_map(benchmark::State& state) {
+	auto tids = make_tids(state.range(0));
+	auto obj = std::make_shared<fake_threadinfo>(fake_threadinfo{0});
+	for(auto _ : state) {
+		tid_map<fake_threadinfo> map;
+		for(auto tid : tids) {
+			map.put(tid, obj);
+		}
+		benchmark::DoNotOptimize(map.size());
+	}
+	state.SetItemsProcessed(state.iterations() * tids.size());
+}
+BENCHMARK(BM_thread_table_insert_tid_map)->Arg(10000)->Arg(100000)->Arg(1000000);
@@ -0,0 +1,28 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Copyright (C) 2026 The Falco Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied. See the License for the specific language governing permissions and limitations under
+# the License.
+#
+
+if(ZSTD_INCLUDE)
+	# we already have zstd
+else()
+	find_path(ZSTD_INCLUDE zstd.h)
+	find_library(ZSTD_LIB NAMES zstd)
+	if(ZSTD_INCLUDE AND ZSTD_LIB)
+		message(STATUS "Found zstd: include: ${ZSTD_INCLUDE}, lib: ${ZSTD_LIB}")
+	else()
+		message(FATAL_ERROR "Couldn't find system zstd")
+	endif()
+endif()
+
+include_directories(${ZSTD_INCLUDE})
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <libscap/scap_engines.h>
+#include <libscap/scap_procs.h>
+#include <libscap/scap_platform.h>
+#include <libscap/scap_savefile_api.h>
+#include <libscap/engine/savefile/savefile_public.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+// A capture with `nevts` generic events, timestamps go from 1 to `nevts`.
+class savefile_capture {
+public:
+	savefile_capture(uint32_t nevts, bool use_mmap = false) {
+		char path[] = "/tmp/scap_batch_XXXXXX";
+		int fd = mkstemp(path);
+		EXPECT_GE(fd, 0);
+		close(fd);
+		m_path = path;
+
+		char error[SCAP_LASTERR_SIZE] = {};
+		scap_dumper_t* d = scap_dump_open(nullptr, m_path.c_str(), SCAP_COMPRESSION_NONE, error);
+		EXPECT_NE(d, nullptr) << error;
+		for(uint32_t j = 0; j < nevts; j++) {
+			scap_evt* evt =
+			        scap_create_event(error, j + 1, 1, PPME_GENERIC_X, 2, (uint16_t)j, (uint16_t)j);
+			EXPECT_NE(evt, nullptr) << error;
+			EXPECT_EQ(scap_dump(d, evt, j % 4, 0), SCAP_SUCCESS);
+			free(evt);
+		}
+		scap_dump_close(d);
+
+		scap_proc_callbacks callbacks{};
+		callbacks.m_refresh_start_cb = default_refresh_start_end_callback;
+		callbacks.m_refresh_end_cb = default_refresh_start_end_callback;
+		callbacks.m_proc_entry_cb = default_proc_entry_callback;
+
+		m_params.fname = m_path.c_str();
+		m_params.use_mmap = use_mmap;
+		m_params.platform = scap_savefile_alloc_platform(callbacks);
+
+		scap_open_args oargs{};
+		oargs.engine_params = &m_params;
+		int32_t rc = SCAP_FAILURE;
+		m_h = scap_open(&oargs, &scap_savefile_engine, error, &rc);
+		EXPECT_NE(m_h, nullptr) << error;
+	}
+
+	~savefile_capture() {
+		scap_platform_close(m_params.platform);
+		scap_platform_free(m_params.platform);
+		if(m_h != nullptr) {
+			scap_close(m_h);
+		}
+		remove(m_path.c_str());
+	}
+
+	scap_t* m_h = nullptr;
+
+private:
+	std::string m_path;
+	scap_savefile_engine_params m_params{};
+};
+
+}  // namespace
+
+TEST(savefile_next_batch, returns_all_events) {
+	savefile_capture capture(10);
+	ASSERT_NE(capture.m_h, nullptr);
+
+	scap_evt* evts[4];
+	uint16_t devids[4];
+	uint32_t flags[4];
+	uint32_t n = 0;
+	std::vector<uint32_t> sizes;
+	std::vector<uint64_t> tss;
+	int32_t res;
+	while((res = scap_next_batch(capture.m_h, evts, devids, flags, 4, &n)) == SCAP_SUCCESS) {
+		sizes.push_back(n);
+		// All the events of the batch are still valid.
+		for(uint32_t j = 0; j < n; j++) {
+			tss.push_back(evts[j]->ts);
+			ASSERT_EQ(devids[j], (evts[j]->ts - 1) % 4);
+		}
+	}
+	ASSERT_EQ(res, SCAP_EOF);
+	ASSERT_EQ(n, 0);
+
+	std::vector<uint32_t> expected_sizes = {4, 4, 2};
+	ASSERT_EQ(sizes, expected_sizes);
+	for(uint64_t j = 0; j < tss.size(); j++) {
+		ASSERT_EQ(tss[j], j + 1);
+	}
+	ASSERT_EQ(tss.size(), 10);
+}
+
+TEST(savefile_next_batch, mixes_with_next) {
+	savefile_capture capture(3);
+	ASSERT_NE(capture.m_h, nullptr);
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flag = 0;
+	ASSERT_EQ(scap_next(capture.m_h, &evt, &devid, &flag), SCAP_SUCCESS);
+	ASSERT_EQ(uint64_t(evt->ts), 1);
+
+	scap_evt* evts[8];
+	uint16_t devids[8];
+	uint32_t flags[8];
+	uint32_t n = 0;
+	// The end of the capture interrupts the batch, it is reported by the next call.
+	ASSERT_EQ(scap_next_batch(capture.m_h, evts, devids, flags, 8, &n), SCAP_SUCCESS);
+	ASSERT_EQ(n, 2);
+	ASSERT_EQ(uint64_t(evts[0]->ts), 2);
+	ASSERT_EQ(uint64_t(evts[1]->ts), 3);
+	ASSERT_EQ(scap_next(capture.m_h, &evt, &devid, &flag), SCAP_EOF);
+}
+
+TEST(savefile_next_batch, mapped_file) {
+	savefile_capture capture(10, true);
+	ASSERT_NE(capture.m_h, nullptr);
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flag = 0;
+	ASSERT_EQ(scap_next(capture.m_h, &evt, &devid, &flag), SCAP_SUCCESS);
+	ASSERT_EQ(uint64_t(evt->ts), 1);
+
+	scap_evt* evts[16];
+	uint16_t devids[16];
+	uint32_t flags[16];
+	uint32_t n = 0;
+	ASSERT_EQ(scap_next_batch(capture.m_h, evts, devids, flags, 16, &n), SCAP_SUCCESS);
+	ASSERT_EQ(n, 9);
+	// The first event is read in place, it is still valid.
+	ASSERT_EQ(uint64_t(evt->ts), 1);
+	for(uint32_t j = 0; j < n; j++) {
+		ASSERT_EQ(uint64_t(evts[j]->ts), j + 2);
+		ASSERT_EQ(devids[j], (j + 1) % 4);
+	}
+	ASSERT_EQ(scap_next_batch(capture.m_h, evts, devids, flags, 16, &n), SCAP_EOF);
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <libscap/scap_engines.h>
+#include <libscap/scap_procs.h>
+#include <libscap/scap_platform.h>
+#include <libscap/scap_savefile_api.h>
+#include <libscap/engine/savefile/savefile_public.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t NEVTS = 1000;
+
+// A capture with `NEVTS` generic events, timestamps go from 1 to `NEVTS`, indexed every
+// `chunk_events` events if non-zero.
+class indexed_capture {
+public:
+	indexed_capture(compression_mode compress, uint32_t chunk_events, bool use_mmap = false) {
+		char path[] = "/tmp/scap_index_XXXXXX";
+		int fd = mkstemp(path);
+		EXPECT_GE(fd, 0);
+		close(fd);
+		m_path = path;
+
+		char error[SCAP_LASTERR_SIZE] = {};
+		scap_dumper_t* d = scap_dump_open(nullptr, m_path.c_str(), compress, error);
+		EXPECT_NE(d, nullptr) << error;
+		if(chunk_events != 0) {
+			EXPECT_EQ(scap_dump_enable_index(d, chunk_events, 0), SCAP_SUCCESS)
+			        << scap_dump_getlasterr(d);
+		}
+		for(uint32_t j = 0; j < NEVTS; j++) {
+			scap_evt* evt =
+			        scap_create_event(error, j + 1, 1, PPME_GENERIC_X, 2, (uint16_t)j, (uint16_t)j);
+			EXPECT_NE(evt, nullptr) << error;
+			EXPECT_EQ(scap_dump(d, evt, 0, 0), SCAP_SUCCESS);
+			free(evt);
+		}
+		scap_dump_close(d);
+
+		scap_proc_callbacks callbacks{};
+		callbacks.m_refresh_start_cb = default_refresh_start_end_callback;
+		callbacks.m_refresh_end_cb = default_refresh_start_end_callback;
+		callbacks.m_proc_entry_cb = default_proc_entry_callback;
+
+		m_params.fname = m_path.c_str();
+		m_params.use_mmap = use_mmap;
+		m_params.platform = scap_savefile_alloc_platform(callbacks);
+
+		scap_open_args oargs{};
+		oargs.engine_params = &m_params;
+		int32_t rc = SCAP_FAILURE;
+		m_h = scap_open(&oargs, &scap_savefile_engine, error, &rc);
+		EXPECT_NE(m_h, nullptr) << error;
+	}
+
+	~indexed_capture() {
+		scap_platform_close(m_params.platform);
+		scap_platform_free(m_params.platform);
+		if(m_h != nullptr) {
+			scap_close(m_h);
+		}
+		remove(m_path.c_str());
+	}
+
+	// The timestamp of the next event, 0 at the end of the capture
+	uint64_t next_ts() {
+		scap_evt* evt = nullptr;
+		uint16_t devid = 0;
+		uint32_t flags = 0;
+		return scap_next(m_h, &evt, &devid, &flags) == SCAP_SUCCESS ? evt->ts : 0;
+	}
+
+	scap_t* m_h = nullptr;
+
+private:
+	std::string m_path;
+	scap_savefile_engine_params m_params{};
+};
+
+void check_seeks(indexed_capture& capture) {
+	ASSERT_NE(capture.m_h, nullptr);
+	ASSERT_EQ(capture.next_ts(), 1);
+
+	// Forward, in the middle of a chunk
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 550), SCAP_SUCCESS);
+	for(uint64_t ts = 550; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	ASSERT_EQ(capture.next_ts(), 0);
+
+	// Backward, at the start of a chunk
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 201), SCAP_SUCCESS);
+	ASSERT_EQ(capture.next_ts(), 201);
+	ASSERT_EQ(capture.next_ts(), 202);
+
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 0), SCAP_SUCCESS);
+	ASSERT_EQ(capture.next_ts(), 1);
+
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, NEVTS + 1), SCAP_SUCCESS);
+	ASSERT_EQ(capture.next_ts(), 0);
+}
+
+}  // namespace
+
+TEST(savefile_seek_timestamp, uncompressed) {
+	indexed_capture capture(SCAP_COMPRESSION_NONE, 100);
+	check_seeks(capture);
+}
+
+TEST(savefile_seek_timestamp, uncompressed_mmap) {
+	indexed_capture capture(SCAP_COMPRESSION_NONE, 100, true);
+	check_seeks(capture);
+}
+
+TEST(savefile_seek_timestamp, gzip) {
+	indexed_capture capture(SCAP_COMPRESSION_GZIP, 100);
+	check_seeks(capture);
+
+	// The offsets are still the ones of the whole capture
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 1), SCAP_SUCCESS);
+	ASSERT_EQ(capture.next_ts(), 1);
+	ASSERT_EQ(capture.next_ts(), 2);
+	uint64_t off = scap_ftell(capture.m_h);
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 700), SCAP_SUCCESS);
+	ASSERT_GT(scap_ftell(capture.m_h), off);
+	scap_fseek(capture.m_h, off);
+	ASSERT_EQ(capture.next_ts(), 3);
+}
+
+TEST(savefile_seek_timestamp, reads_indexed_capture) {
+	indexed_capture capture(SCAP_COMPRESSION_NONE, 64);
+	ASSERT_NE(capture.m_h, nullptr);
+	for(uint64_t ts = 1; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	ASSERT_EQ(scap_next(capture.m_h, &evt, &devid, &flags), SCAP_EOF);
+}
+
+TEST(savefile_seek_timestamp, no_index) {
+	indexed_capture capture(SCAP_COMPRESSION_GZIP, 0);
+	ASSERT_NE(capture.m_h, nullptr);
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 10), SCAP_FAILURE);
+	ASSERT_EQ(capture.next_ts(), 1);
+}
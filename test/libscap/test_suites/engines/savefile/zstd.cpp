@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <libscap/scap_engines.h>
+#include <libscap/scap_procs.h>
+#include <libscap/scap_platform.h>
+#include <libscap/scap_savefile_api.h>
+#include <libscap/engine/savefile/savefile_public.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t NEVTS = 1000;
+
+bool zstd_supported() {
+	char error[SCAP_LASTERR_SIZE] = {};
+	scap_dumper_t* d = scap_dump_open(nullptr, "/dev/null", SCAP_COMPRESSION_ZSTD, error);
+	if(d == nullptr) {
+		return false;
+	}
+	scap_dump_close(d);
+	return true;
+}
+
+// A capture with `NEVTS` generic events written with the given compression,
+// timestamps go from 1 to `NEVTS`, indexed every `chunk_events` events if non-zero.
+class compressed_capture {
+public:
+	compressed_capture(const scap_compression_params& compression, uint32_t chunk_events = 0) {
+		char path[] = "/tmp/scap_zstd_XXXXXX";
+		int fd = mkstemp(path);
+		EXPECT_GE(fd, 0);
+		close(fd);
+		m_path = path;
+
+		char error[SCAP_LASTERR_SIZE] = {};
+		scap_dumper_t* d = scap_dump_open_compressed(nullptr, m_path.c_str(), &compression, error);
+		EXPECT_NE(d, nullptr) << error;
+		if(chunk_events != 0) {
+			EXPECT_EQ(scap_dump_enable_index(d, chunk_events, 0), SCAP_SUCCESS)
+			        << scap_dump_getlasterr(d);
+		}
+		for(uint32_t j = 0; j < NEVTS; j++) {
+			scap_evt* evt =
+			        scap_create_event(error, j + 1, 1, PPME_GENERIC_X, 2, (uint16_t)j, (uint16_t)j);
+			EXPECT_NE(evt, nullptr) << error;
+			EXPECT_EQ(scap_dump(d, evt, 0, 0), SCAP_SUCCESS);
+			free(evt);
+		}
+		scap_dump_close(d);
+
+		FILE* f = fopen(m_path.c_str(), "rb");
+		EXPECT_NE(f, nullptr);
+		EXPECT_EQ(fread(m_magic, 1, sizeof(m_magic), f), sizeof(m_magic));
+		fclose(f);
+
+		scap_proc_callbacks callbacks{};
+		callbacks.m_refresh_start_cb = default_refresh_start_end_callback;
+		callbacks.m_refresh_end_cb = default_refresh_start_end_callback;
+		callbacks.m_proc_entry_cb = default_proc_entry_callback;
+
+		m_params.fname = m_path.c_str();
+		m_params.platform = scap_savefile_alloc_platform(callbacks);
+
+		scap_open_args oargs{};
+		oargs.engine_params = &m_params;
+		int32_t rc = SCAP_FAILURE;
+		m_h = scap_open(&oargs, &scap_savefile_engine, error, &rc);
+		EXPECT_NE(m_h, nullptr) << error;
+	}
+
+	~compressed_capture() {
+		scap_platform_close(m_params.platform);
+		scap_platform_free(m_params.platform);
+		if(m_h != nullptr) {
+			scap_close(m_h);
+		}
+		remove(m_path.c_str());
+	}
+
+	// The timestamp of the next event, 0 at the end of the capture
+	uint64_t next_ts() {
+		scap_evt* evt = nullptr;
+		uint16_t devid = 0;
+		uint32_t flags = 0;
+		return scap_next(m_h, &evt, &devid, &flags) == SCAP_SUCCESS ? evt->ts : 0;
+	}
+
+	bool is_zstd() const {
+		return m_magic[0] == 0x28 && m_magic[1] == 0xb5 && m_magic[2] == 0x2f &&
+		       m_magic[3] == 0xfd;
+	}
+
+	scap_t* m_h = nullptr;
+
+private:
+	std::string m_path;
+	uint8_t m_magic[4] = {};
+	scap_savefile_engine_params m_params{};
+};
+
+}  // namespace
+
+TEST(savefile_zstd, read_write) {
+	if(!zstd_supported()) {
+		GTEST_SKIP() << "zstd compression is not supported by this build";
+	}
+
+	compressed_capture capture({SCAP_COMPRESSION_ZSTD, 3, 0});
+	ASSERT_NE(capture.m_h, nullptr);
+	ASSERT_TRUE(capture.is_zstd());
+	for(uint64_t ts = 1; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	ASSERT_EQ(capture.next_ts(), 0);
+}
+
+TEST(savefile_zstd, workers) {
+	if(!zstd_supported()) {
+		GTEST_SKIP() << "zstd compression is not supported by this build";
+	}
+
+	compressed_capture capture({SCAP_COMPRESSION_ZSTD, 0, 2});
+	ASSERT_NE(capture.m_h, nullptr);
+	for(uint64_t ts = 1; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	ASSERT_EQ(capture.next_ts(), 0);
+}
+
+TEST(savefile_zstd, fseek) {
+	if(!zstd_supported()) {
+		GTEST_SKIP() << "zstd compression is not supported by this build";
+	}
+
+	compressed_capture capture({SCAP_COMPRESSION_ZSTD, 0, 0});
+	ASSERT_NE(capture.m_h, nullptr);
+	ASSERT_EQ(capture.next_ts(), 1);
+	uint64_t off = scap_ftell(capture.m_h);
+	for(uint64_t ts = 2; ts <= 500; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+
+	// Going back decompresses the data again from the start
+	scap_fseek(capture.m_h, off);
+	ASSERT_EQ(capture.next_ts(), 2);
+}
+
+TEST(savefile_zstd, seek_timestamp) {
+	if(!zstd_supported()) {
+		GTEST_SKIP() << "zstd compression is not supported by this build";
+	}
+
+	compressed_capture capture({SCAP_COMPRESSION_ZSTD, 0, 0}, 100);
+	ASSERT_NE(capture.m_h, nullptr);
+	ASSERT_EQ(capture.next_ts(), 1);
+
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 550), SCAP_SUCCESS);
+	for(uint64_t ts = 550; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	ASSERT_EQ(capture.next_ts(), 0);
+
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 201), SCAP_SUCCESS);
+	ASSERT_EQ(capture.next_ts(), 201);
+
+	// The offsets are still the ones of the whole capture
+	uint64_t off = scap_ftell(capture.m_h);
+	ASSERT_EQ(scap_seek_to_timestamp(capture.m_h, 700), SCAP_SUCCESS);
+	ASSERT_GT(scap_ftell(capture.m_h), off);
+	scap_fseek(capture.m_h, off);
+	ASSERT_EQ(capture.next_ts(), 202);
+}
+
+TEST(savefile_zstd, unsupported) {
+	if(zstd_supported()) {
+		GTEST_SKIP() << "zstd compression is supported by this build";
+	}
+
+	char error[SCAP_LASTERR_SIZE] = {};
+	ASSERT_EQ(scap_dump_open(nullptr, "/dev/null", SCAP_COMPRESSION_ZSTD, error), nullptr);
+	ASSERT_STREQ(error, "zstd compression is not supported by this build");
+}
+
+TEST(savefile_compression, gzip_level) {
+	compressed_capture capture({SCAP_COMPRESSION_GZIP, 9, 0});
+	ASSERT_NE(capture.m_h, nullptr);
+	for(uint64_t ts = 1; ts <= NEVTS; ts++) {
+		ASSERT_EQ(capture.next_ts(), ts);
+	}
+	ASSERT_EQ(capture.next_ts(), 0);
+
+	char error[SCAP_LASTERR_SIZE] = {};
+	scap_compression_params params = {SCAP_COMPRESSION_GZIP, 10, 0};
+	ASSERT_EQ(scap_dump_open_compressed(nullptr, "/dev/null", &params, error), nullptr);
+}
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <sys/param.h>
+#include <libscap/ringbuffer/ringbuffer.h>
+
+#include <vector>
+
+namespace {
+
+// A set of fake devices backed by plain memory: events are written at the head of every buffer
+// as the driver would do.
+class fake_devset {
+public:
+	fake_devset(uint32_t ndevs, unsigned long buffer_size = 4096):
+	        m_buffers(ndevs, std::vector<char>(buffer_size)),
+	        m_bufinfos(ndevs) {
+		EXPECT_EQ(devset_init(&m_devset, ndevs, m_lasterr), SCAP_SUCCESS);
+		for(uint32_t j = 0; j < ndevs; j++) {
+			scap_device* dev = &m_devset.m_devs[j];
+			dev->m_buffer = m_buffers[j].data();
+			dev->m_buffer_size = buffer_size;
+			dev->m_bufinfo = &m_bufinfos[j];
+		}
+	}
+
+	~fake_devset() {
+		// The memory is not mapped, so we don't call `devset_free()` on the devices.
+		free(m_devset.m_devs);
+		ts_heap_free(&m_devset.m_heap);
+		for(uint32_t j = 0; j < m_devset.m_nshards; j++) {
+			ts_heap_free(&m_devset.m_shards[j].m_heap);
+		}
+		free(m_devset.m_shards);
+	}
+
+	void push(uint32_t devid, uint64_t ts) {
+		scap_device* dev = &m_devset.m_devs[devid];
+		scap_evt evt = {};
+		evt.ts = ts;
+		evt.len = sizeof(scap_evt);
+		memcpy(dev->m_buffer + dev->m_bufinfo->head, &evt, sizeof(evt));
+		dev->m_bufinfo->head += sizeof(evt);
+	}
+
+	// Consume events until the buffers are empty, return their (ts, devid).
+	std::vector<std::pair<uint64_t, uint16_t>> drain() { return drain(&m_devset); }
+
+	std::vector<std::pair<uint64_t, uint16_t>> drain(scap_device_set* devset) {
+		std::vector<std::pair<uint64_t, uint16_t>> res;
+		scap_evt* evt = nullptr;
+		uint16_t devid = 0;
+		uint32_t flags = 0;
+		int timeouts = 0;
+		while(timeouts < 2) {
+			int32_t ret = ringbuffer_next(devset, &evt, &devid, &flags);
+			if(ret == SCAP_TIMEOUT) {
+				timeouts++;
+				continue;
+			}
+			EXPECT_EQ(ret, SCAP_SUCCESS);
+			timeouts = 0;
+			res.emplace_back(uint64_t(evt->ts), devid);
+		}
+		return res;
+	}
+
+	scap_device_set m_devset;
+	char m_lasterr[SCAP_LASTERR_SIZE];
+
+private:
+	std::vector<std::vector<char>> m_buffers;
+	std::vector<ppm_ring_buffer_info> m_bufinfos;
+};
+
+}  // namespace
+
+TEST(ringbuffer, next_merges_devices_in_ts_order) {
+	fake_devset devs(3);
+	devs.push(0, 10);
+	devs.push(0, 40);
+	devs.push(0, 50);
+	devs.push(1, 20);
+	devs.push(1, 60);
+	devs.push(2, 30);
+	devs.push(2, 35);
+
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {
+	        {10, 0},
+	        {20, 1},
+	        {30, 2},
+	        {35, 2},
+	        {40, 0},
+	        {50, 0},
+	        {60, 1},
+	};
+	ASSERT_EQ(devs.drain(), expected);
+
+	// All the blocks have been released to the producer.
+	for(uint32_t j = 0; j < devs.m_devset.m_ndevs; j++) {
+		const ppm_ring_buffer_info* bufinfo = devs.m_devset.m_devs[j].m_bufinfo;
+		ASSERT_EQ(uint32_t(bufinfo->tail), uint32_t(bufinfo->head));
+	}
+}
+
+TEST(ringbuffer, next_breaks_ties_on_lowest_device) {
+	fake_devset devs(4);
+	devs.push(3, 100);
+	devs.push(1, 100);
+	devs.push(2, 100);
+	devs.push(0, 200);
+
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {
+	        {100, 1},
+	        {100, 2},
+	        {100, 3},
+	        {200, 0},
+	};
+	ASSERT_EQ(devs.drain(), expected);
+}
+
+TEST(ringbuffer, next_releases_consumed_block_before_refill) {
+	fake_devset devs(2);
+	devs.push(0, 1);
+	devs.push(1, 2);
+	devs.push(1, 3);
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	ASSERT_EQ(ringbuffer_next(&devs.m_devset, &evt, &devid, &flags), SCAP_TIMEOUT);
+	ASSERT_EQ(ringbuffer_next(&devs.m_devset, &evt, &devid, &flags), SCAP_SUCCESS);
+	ASSERT_EQ(uint64_t(evt->ts), 1);
+	// The event returned is still in use, so the tail is not moved yet.
+	ASSERT_EQ(uint32_t(devs.m_devset.m_devs[0].m_bufinfo->tail), 0);
+
+	ASSERT_EQ(ringbuffer_next(&devs.m_devset, &evt, &devid, &flags), SCAP_SUCCESS);
+	ASSERT_EQ(uint64_t(evt->ts), 2);
+	// Device 0 has been entirely consumed, so its block is released while device 1 is still
+	// being consumed.
+	ASSERT_EQ(uint32_t(devs.m_devset.m_devs[0].m_bufinfo->tail), sizeof(scap_evt));
+	ASSERT_EQ(uint32_t(devs.m_devset.m_devs[1].m_bufinfo->tail), 0);
+}
+
+TEST(ringbuffer, flush_discards_read_blocks) {
+	fake_devset devs(2);
+	devs.push(0, 1);
+	devs.push(0, 2);
+	devs.push(1, 3);
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	ASSERT_EQ(ringbuffer_next(&devs.m_devset, &evt, &devid, &flags), SCAP_TIMEOUT);
+	ASSERT_EQ(ringbuffer_next(&devs.m_devset, &evt, &devid, &flags), SCAP_SUCCESS);
+	ASSERT_EQ(uint64_t(evt->ts), 1);
+
+	ringbuffer_flush_read_buffers(&devs.m_devset);
+	devs.push(1, 4);
+
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {{4, 1}};
+	ASSERT_EQ(devs.drain(), expected);
+}
+
+TEST(ringbuffer, relaxed_ordering_drains_batches) {
+	fake_devset devs(2);
+	relaxed_order_init(&devs.m_devset.m_relaxed, 2, 0);
+	devs.push(0, 10);
+	devs.push(0, 30);
+	devs.push(0, 50);
+	devs.push(1, 20);
+	devs.push(1, 40);
+
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {
+	        {10, 0},
+	        {30, 0},
+	        {20, 1},
+	        {40, 1},
+	        {50, 0},
+	};
+	ASSERT_EQ(devs.drain(), expected);
+	// `20` was served after `30`.
+	ASSERT_EQ(devs.m_devset.m_relaxed.m_max_reorder_ns, 10);
+}
+
+TEST(ringbuffer, relaxed_ordering_window_ends_batch) {
+	fake_devset devs(2);
+	relaxed_order_init(&devs.m_devset.m_relaxed, 100, 15);
+	devs.push(0, 10);
+	devs.push(0, 20);
+	devs.push(0, 30);
+	devs.push(1, 25);
+
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {
+	        {10, 0},
+	        {20, 0},
+	        {25, 1},
+	        {30, 0},
+	};
+	ASSERT_EQ(devs.drain(), expected);
+	ASSERT_EQ(devs.m_devset.m_relaxed.m_max_reorder_ns, 0);
+}
+
+TEST(ringbuffer, shards_split_devices) {
+	fake_devset devs(5);
+	ASSERT_EQ(devset_init_shards(&devs.m_devset, 2, devs.m_lasterr), SCAP_SUCCESS);
+	ASSERT_EQ(devs.m_devset.m_nshards, 2);
+	ASSERT_EQ(devs.m_devset.m_shards[0].m_ndevs, 3);
+	ASSERT_EQ(devs.m_devset.m_shards[1].m_ndevs, 2);
+
+	devs.push(0, 50);
+	devs.push(2, 10);
+	devs.push(3, 40);
+	devs.push(4, 20);
+
+	// Every shard only serves its own devices, ids are relative to the shard.
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {{10, 2}, {50, 0}};
+	ASSERT_EQ(devs.drain(&devs.m_devset.m_shards[0]), expected);
+	expected = {{20, 1}, {40, 0}};
+	ASSERT_EQ(devs.drain(&devs.m_devset.m_shards[1]), expected);
+}
+
+TEST(ringbuffer, shards_capped_to_devices) {
+	fake_devset devs(2);
+	ASSERT_EQ(devset_init_shards(&devs.m_devset, 8, devs.m_lasterr), SCAP_SUCCESS);
+	ASSERT_EQ(devs.m_devset.m_nshards, 2);
+
+	fake_devset single(2);
+	ASSERT_EQ(devset_init_shards(&single.m_devset, 1, single.m_lasterr), SCAP_SUCCESS);
+	ASSERT_EQ(single.m_devset.m_nshards, 0);
+	ASSERT_EQ(single.m_devset.m_shards, nullptr);
+}
+
+TEST(ringbuffer, next_batch_stops_at_block_end) {
+	fake_devset devs(2);
+	devs.push(0, 10);
+	devs.push(0, 30);
+	devs.push(1, 20);
+	devs.push(1, 40);
+
+	scap_evt* evts[8];
+	uint16_t devids[8];
+	uint32_t flags[8];
+	uint32_t n = 0;
+	ASSERT_EQ(ringbuffer_next_batch(&devs.m_devset, evts, devids, flags, 8, &n), SCAP_TIMEOUT);
+	ASSERT_EQ(n, 0);
+
+	// `30` is the last event of the block of device 0: the block is released by the next call,
+	// so the batch stops here.
+	ASSERT_EQ(ringbuffer_next_batch(&devs.m_devset, evts, devids, flags, 8, &n), SCAP_SUCCESS);
+	ASSERT_EQ(n, 3);
+	ASSERT_EQ(uint64_t(evts[0]->ts), 10);
+	ASSERT_EQ(uint64_t(evts[1]->ts), 20);
+	ASSERT_EQ(uint64_t(evts[2]->ts), 30);
+	ASSERT_EQ(uint32_t(devs.m_devset.m_devs[0].m_bufinfo->tail), 0);
+
+	ASSERT_EQ(ringbuffer_next_batch(&devs.m_devset, evts, devids, flags, 8, &n), SCAP_SUCCESS);
+	ASSERT_EQ(n, 1);
+	ASSERT_EQ(uint64_t(evts[0]->ts), 40);
+	ASSERT_EQ(devids[0], 1);
+	ASSERT_EQ(uint32_t(devs.m_devset.m_devs[0].m_bufinfo->tail), 2 * sizeof(scap_evt));
+}
@@ -20,6 +20,11 @@ limitations under the License.
 #include <libscap/linux/scap_cgroup.h>
 #include <libscap/linux/scap_cgroup.c>
 
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+
 TEST(cgroups, path_relative) {
 	char final_path[4096];
 	const char* prefix = "/1/2/3";
@@ -91,3 +96,43 @@ TEST(cgroups, path_empty) {
 	         path + path_strip_len);
 	ASSERT_STREQ(final_path, "/1/2/3");
 }
+
+TEST(cgroups, file_reader_matches_fgets) {
+	// Longer than the buffer of the reader, with a line longer than the line buffer and a final
+	// line without '\n'.
+	std::string content;
+	for(int i = 0; i < 300; i++) {
+		content += std::to_string(i) + ":cpu,cpuacct:/system.slice/service-" + std::to_string(i) +
+		           ".service\n";
+	}
+	content += "0::" + std::string(200, 'x') + "\n";
+	content += "1:name=systemd:/last";
+
+	char tmpl[] = "/tmp/scap_cgroup_reader_XXXXXX";
+	int fd = mkstemp(tmpl);
+	ASSERT_NE(fd, -1);
+	ASSERT_EQ(write(fd, content.data(), content.size()), (ssize_t)content.size());
+	ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+
+	FILE* expected = fmemopen((void*)content.data(), content.size(), "r");
+	ASSERT_NE(expected, nullptr);
+
+	struct cgroup_file_reader f;
+	f.fd = fd;
+	f.start = 0;
+	f.end = 0;
+	char line[64];
+	char expected_line[64];
+	int lines = 0;
+	while(cgroup_file_gets(&f, line, sizeof(line)) != NULL) {
+		ASSERT_NE(fgets(expected_line, sizeof(expected_line), expected), nullptr);
+		ASSERT_STREQ(line, expected_line);
+		lines++;
+	}
+	ASSERT_EQ(fgets(expected_line, sizeof(expected_line), expected), nullptr);
+	ASSERT_GT(lines, 300);
+
+	fclose(expected);
+	close(fd);
+	unlink(tmpl);
+}
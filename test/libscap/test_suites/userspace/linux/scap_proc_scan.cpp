@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <libscap/scap-int.h>
+#include <libscap/linux/scap_linux_platform.h>
+
+extern "C" {
+#include <libscap/linux/scap_linux_int.h>
+}
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::string_literals;
+
+namespace {
+
+void write_file(const fs::path& path, const std::string& content) {
+	std::ofstream f(path, std::ios::binary);
+	f << content;
+}
+
+void make_fake_task(const fs::path& dir, uint32_t pid, uint32_t tid, uint32_t num_fds) {
+	fs::create_directories(dir);
+	const std::string p = std::to_string(pid);
+	const std::string t = std::to_string(tid);
+	write_file(dir / "cmdline", "/usr/bin/app\0--id\0"s + p + "\0"s);
+	write_file(dir / "comm", "app\n");
+	write_file(dir / "environ", "HOME=/root\0PATH=/usr/bin\0"s);
+	write_file(dir / "status",
+	           "Name:\tapp\nState:\tS (sleeping)\nTgid:\t" + p + "\nPid:\t" + t +
+	                   "\nPPid:\t1\nUid:\t0\t0\t0\t0\nGid:\t0\t0\t0\t0\nNStgid:\t" + p +
+	                   "\nNSpid:\t" + t + "\nNSpgid:\t" + p +
+	                   "\nVmSize:\t1000 kB\nVmRSS:\t100 kB\nVmSwap:\t0 kB\n"
+	                   "CapInh:\t0000000000000000\nCapPrm:\t000001ffffffffff\n"
+	                   "CapEff:\t000001ffffffffff\n");
+	write_file(dir / "stat", t + " (app) S 1 " + p + " " + p + " 0 -1 4194560 10 0 2 0\n");
+	write_file(dir / "loginuid", "0");
+	fs::create_symlink("/usr/bin/env", dir / "exe");
+	fs::create_symlink("/", dir / "cwd");
+	fs::create_symlink("/", dir / "root");
+	fs::create_directories(dir / "fd");
+	for(uint32_t fd = 0; fd < num_fds; fd++) {
+		fs::create_symlink(fd % 2 ? "/" : "/dev/null", dir / "fd" / std::to_string(fd));
+	}
+}
+
+// A fake procfs with `num_procs` processes, having `num_threads` threads and `num_fds` fds each.
+class fake_procfs {
+public:
+	fake_procfs(uint32_t num_procs, uint32_t num_threads, uint32_t num_fds) {
+		char tmpl[] = "/tmp/scap_proc_scan_XXXXXX";
+		m_root = mkdtemp(tmpl);
+		for(uint32_t j = 0; j < num_procs; j++) {
+			const uint32_t pid = 1000 + j * 100;
+			const fs::path dir = m_root / std::to_string(pid);
+			make_fake_task(dir, pid, pid, num_fds);
+			for(uint32_t k = 0; k < num_threads; k++) {
+				const uint32_t tid = k == 0 ? pid : pid + k;
+				make_fake_task(dir / "task" / std::to_string(tid), pid, tid, num_fds);
+			}
+		}
+	}
+
+	~fake_procfs() { fs::remove_all(m_root); }
+
+	std::string path() const { return m_root.string(); }
+
+private:
+	fs::path m_root;
+};
+
+// (tid, fd or -1 for a thread, whether the callback ran on the scanning thread)
+using scan_entry = std::tuple<int64_t, int64_t, bool>;
+
+struct scan_result {
+	std::vector<scan_entry> entries;
+	std::thread::id caller;
+};
+
+int32_t record_proc_entry(void* context,
+                          char* error,
+                          int64_t tid,
+                          scap_threadinfo* tinfo,
+                          scap_fdinfo* fdinfo,
+                          scap_threadinfo** new_tinfo) {
+	auto* res = static_cast<scan_result*>(context);
+	const bool on_caller = std::this_thread::get_id() == res->caller;
+	res->entries.emplace_back(tid, fdinfo ? fdinfo->fd : -1, on_caller);
+	return SCAP_SUCCESS;
+}
+
+int32_t scan(const fake_procfs& procfs, uint32_t threads, scan_result& res) {
+	scap_linux_platform platform = {};
+	char lasterr[SCAP_LASTERR_SIZE];
+	platform.m_lasterr = lasterr;
+	platform.m_proc_scan_threads = threads;
+
+	scap_proclist proclist;
+	scap_proc_callbacks callbacks = {default_refresh_start_end_callback,
+	                                 default_refresh_start_end_callback,
+	                                 record_proc_entry,
+	                                 &res};
+	init_proclist(&proclist, callbacks);
+
+	res.caller = std::this_thread::get_id();
+	std::string dir = procfs.path();
+	return scap_linux_scan_proc_dir(&platform, &proclist, dir.data(), lasterr);
+}
+
+// The order of the processes must match, the order of the threads and fds of a process depends on
+// the iteration order of the proc table.
+void expect_same_scan(const scan_result& parallel, const scan_result& serial) {
+	std::vector<int64_t> parallel_procs, serial_procs;
+	for(const auto& entry : parallel.entries) {
+		parallel_procs.push_back(std::get<0>(entry) / 100);
+	}
+	for(const auto& entry : serial.entries) {
+		serial_procs.push_back(std::get<0>(entry) / 100);
+	}
+	ASSERT_EQ(parallel_procs, serial_procs);
+
+	std::vector<scan_entry> parallel_entries = parallel.entries;
+	std::vector<scan_entry> serial_entries = serial.entries;
+	std::sort(parallel_entries.begin(), parallel_entries.end());
+	std::sort(serial_entries.begin(), serial_entries.end());
+	ASSERT_EQ(parallel_entries, serial_entries);
+}
+
+}  // namespace
+
+TEST(scap_proc_scan, parallel_scan_matches_serial) {
+	fake_procfs procfs(40, 3, 4);
+
+	scan_result serial;
+	ASSERT_EQ(scan(procfs, 0, serial), SCAP_SUCCESS);
+	// Every process has 3 threads, and its main thread 4 fds.
+	ASSERT_EQ(serial.entries.size(), 40 * (3 + 4));
+
+	for(uint32_t threads : {2, 4, 64}) {
+		scan_result parallel;
+		ASSERT_EQ(scan(procfs, threads, parallel), SCAP_SUCCESS);
+		// Same callbacks for the same processes in the same order, all of them on the scanning
+		// thread.
+		SCOPED_TRACE(std::to_string(threads) + " threads");
+		expect_same_scan(parallel, serial);
+	}
+	for(const auto& entry : serial.entries) {
+		ASSERT_TRUE(std::get<2>(entry));
+	}
+}
+
+TEST(scap_proc_scan, parallel_scan_skips_unreadable_processes) {
+	fake_procfs procfs(8, 2, 1);
+	// Neither a cmdline nor an exe: skipped as a kernel thread, as the serial scan does.
+	const fs::path dir = fs::path(procfs.path()) / "1300";
+	fs::remove(dir / "cmdline");
+	fs::remove(dir / "exe");
+
+	scan_result serial;
+	ASSERT_EQ(scan(procfs, 0, serial), SCAP_SUCCESS);
+	scan_result parallel;
+	ASSERT_EQ(scan(procfs, 3, parallel), SCAP_SUCCESS);
+	expect_same_scan(parallel, serial);
+	ASSERT_EQ(serial.entries.size(), 7 * (2 + 1));
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap.h>
+#include <libscap/scap_shard_merge.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <vector>
+
+namespace {
+
+// Every stream replays a list of return codes, `SCAP_SUCCESS` entries come with a timestamp.
+struct fake_stream {
+	std::deque<std::pair<int32_t, uint64_t>> results;
+	scap_evt evt = {};
+	bool in_use = false;  // the last event returned has not been released yet
+};
+
+int32_t fake_next(void* ctx,
+                  uint32_t stream,
+                  scap_evt** pevent,
+                  uint16_t* pdevid,
+                  uint32_t* pflags) {
+	auto& s = (*static_cast<std::vector<fake_stream>*>(ctx))[stream];
+	s.in_use = false;
+	if(s.results.empty()) {
+		return SCAP_EOF;
+	}
+	auto [res, ts] = s.results.front();
+	s.results.pop_front();
+	if(res == SCAP_SUCCESS) {
+		s.evt.ts = ts;
+		s.in_use = true;
+		*pevent = &s.evt;
+		*pdevid = (uint16_t)stream;
+		*pflags = 0;
+	}
+	return res;
+}
+
+}  // namespace
+
+TEST(scap_shard_merge, merges_in_ts_order) {
+	std::vector<fake_stream> streams(3);
+	streams[0].results = {{SCAP_SUCCESS, 10}, {SCAP_SUCCESS, 40}};
+	streams[1].results = {{SCAP_TIMEOUT, 0}, {SCAP_SUCCESS, 20}, {SCAP_SUCCESS, 50}};
+	streams[2].results = {{SCAP_SUCCESS, 30}};
+
+	scap_shard_merge merge;
+	ASSERT_EQ(scap_shard_merge_init(&merge, 3, fake_next, &streams), SCAP_SUCCESS);
+
+	std::vector<std::pair<uint64_t, uint16_t>> res;
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	int32_t ret;
+	while((ret = scap_shard_merge_next(&merge, &evt, &devid, &flags)) != SCAP_EOF) {
+		if(ret == SCAP_TIMEOUT) {
+			continue;
+		}
+		ASSERT_EQ(ret, SCAP_SUCCESS);
+		// The event we got back is still owned by its stream.
+		ASSERT_TRUE(streams[devid].in_use);
+		res.emplace_back(uint64_t(evt->ts), devid);
+	}
+	scap_shard_merge_free(&merge);
+
+	// Stream 1 was idle at the beginning, so its events are merged starting from the next round.
+	std::vector<std::pair<uint64_t, uint16_t>> expected = {
+	        {10, 0},
+	        {30, 2},
+	        {40, 0},
+	        {20, 1},
+	        {50, 1},
+	};
+	ASSERT_EQ(res, expected);
+}
+
+TEST(scap_shard_merge, forwards_failures) {
+	std::vector<fake_stream> streams(2);
+	streams[0].results = {{SCAP_SUCCESS, 10}};
+	streams[1].results = {{SCAP_FAILURE, 0}};
+
+	scap_shard_merge merge;
+	ASSERT_EQ(scap_shard_merge_init(&merge, 2, fake_next, &streams), SCAP_SUCCESS);
+
+	scap_evt* evt = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	ASSERT_EQ(scap_shard_merge_next(&merge, &evt, &devid, &flags), SCAP_FAILURE);
+	scap_shard_merge_free(&merge);
+}
@@ -64,6 +64,19 @@ int pman_init_state(falcosecurity_log_fn log_fn,
                     bool allocate_online_only,
                     bool disable_iterators);
 
+/**
+ * @brief [EXPERIMENTAL] Consume the ring buffers in relaxed ordering mode: instead of
+ * searching for the event with the lowest timestamp across all the ring buffers, drain up to
+ * `max_batch` events from a ring buffer before moving to the next one. Must be called after
+ * `pman_init_state`.
+ *
+ * @param max_batch max number of events consumed from a ring buffer in a row, `0` disables the
+ * relaxed ordering mode.
+ * @param window_ns a batch also ends when the next event is more than `window_ns` ns newer than
+ * the first event of the batch. `0` means no limit.
+ */
+void pman_set_relaxed_ordering(uint32_t max_batch, uint64_t window_ns);
+
 /**
  * @brief Return the number of allocated ring buffers.
  *
@@ -150,6 +163,51 @@ int pman_finalize_ringbuf_array_after_loading(void);
  */
 void pman_consume_first_event(void** event_ptr, int16_t* buffer_id);
 
+/**
+ * @brief Same as calling `pman_consume_first_event` up to `max_events` times, but the consumer
+ * positions are published to the producers once per batch. The events returned stay valid until
+ * the next call to `pman_consume_batch` or `pman_consume_first_event`.
+ *
+ * @param events array of `max_events` elements, filled with the events found.
+ * @param buffer_ids array of `max_events` elements, filled with the ids of the ring buffers
+ * from which we retrieved the events.
+ * @param max_events size of the arrays.
+ * @param n_events number of events returned, `0` if the ring buffers are empty.
+ */
+void pman_consume_batch(void** events,
+                        int16_t* buffer_ids,
+                        uint32_t max_events,
+                        uint32_t* n_events);
+
+/**
+ * @brief Split the ring buffers into `n_shards` groups of contiguous buffers that can be consumed
+ * by different threads through `pman_consume_first_event_from_shard`. Must be called after
+ * `pman_init_state` and before `pman_prepare_ringbuf_array_before_loading`. The number of shards
+ * is capped to the number of ring buffers, `0` and `1` mean no sharding.
+ *
+ * @param n_shards number of shards requested.
+ */
+void pman_set_n_shards(uint32_t n_shards);
+
+/**
+ * @brief Return the number of shards the ring buffers are split into. Without sharding there is a
+ * single shard with all the ring buffers.
+ */
+uint32_t pman_get_n_shards(void);
+
+/**
+ * @brief Search for the event with the lowest timestamp in the ring buffers of a shard. Different
+ * shards can be consumed concurrently, but a shard must be consumed by a single thread and
+ * `pman_consume_first_event` must not be used at the same time.
+ *
+ * @param shard shard to consume, must be lower than `pman_get_n_shards()`.
+ * @param event_ptr in case of success return a pointer
+ * to the event, otherwise return NULL.
+ * @param buffer_id in case of success returns the id of the ring buffer
+ * from which we retrieved the event, otherwise return `-1`.
+ */
+void pman_consume_first_event_from_shard(uint32_t shard, void** event_ptr, int16_t* buffer_id);
+
 /////////////////////////////
 // CAPTURE (EXCHANGE VALUES WITH BPF SIDE)
 /////////////////////////////
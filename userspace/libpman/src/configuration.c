@@ -87,8 +87,21 @@ static void clear_state() {
 	g_state.prod_pos = NULL;
 	g_state.inner_ringbuf_map_fd = -1;
 	g_state.buffer_bytes_dim = 0;
-	g_state.last_ring_read = -1;
-	g_state.last_event_size = 0;
+	g_state.consumer.first_ring = 0;
+	g_state.consumer.n_rings = 0;
+	g_state.consumer.last_ring_read = -1;
+	g_state.consumer.last_event_size = 0;
+	g_state.consumer.ring_heap.m_nodes = NULL;
+	g_state.consumer.ring_heap.m_size = 0;
+	g_state.consumer.ring_heap.m_capacity = 0;
+	g_state.consumer.idle_rings = NULL;
+	g_state.consumer.n_idle_rings = 0;
+	relaxed_order_init(&g_state.consumer.relaxed, 0, 0);
+	g_state.consumer.batching = false;
+	g_state.consumer.unpublished = false;
+	g_state.n_requested_shards = 0;
+	g_state.shards = NULL;
+	g_state.n_shards = 0;
 
 	for(int j = 0; j < MODERN_BPF_PROG_ATTACHED_MAX; j++) {
 		g_state.attached_progs_fds[j] = -1;
@@ -225,16 +238,20 @@ int pman_init_state(falcosecurity_log_fn log_fn,
 	/* Set the dimension of a single ring buffer */
 	g_state.buffer_bytes_dim = buf_bytes_dim;
 
-	/* These will be used during the ring buffer consumption phase. */
-	g_state.last_ring_read = -1;
-	g_state.last_event_size = 0;
-
 	/* BPF iterators state initialization. */
 	init_iter_state(disable_iterators);
 
 	return 0;
 }
 
+void pman_set_relaxed_ordering(uint32_t max_batch, uint64_t window_ns) {
+	relaxed_order_init(&g_state.consumer.relaxed, max_batch, window_ns);
+}
+
+void pman_set_n_shards(uint32_t n_shards) {
+	g_state.n_requested_shards = n_shards;
+}
+
 int pman_get_required_buffers() {
 	return g_state.n_required_buffers;
 }
@@ -275,6 +275,8 @@ void pman_close_probe() {
 		g_state.prod_pos = NULL;
 	}
 
+	free_ring_consumers();
+
 	if(g_state.skel) {
 		bpf_probe__detach(g_state.skel);
 		bpf_probe__destroy(g_state.skel);
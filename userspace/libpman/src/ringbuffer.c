@@ -77,6 +77,89 @@ static int allocate_consumer_producer_positions() {
 	return 0;
 }
 
+static int ring_consumer_init(struct ring_consumer *consumer,
+                              uint32_t first_ring,
+                              uint32_t n_rings,
+                              const struct relaxed_order *relaxed) {
+	consumer->first_ring = first_ring;
+	consumer->n_rings = n_rings;
+	consumer->last_ring_read = -1;
+	consumer->last_event_size = 0;
+	consumer->batching = false;
+	consumer->unpublished = false;
+	relaxed_order_init(&consumer->relaxed, relaxed->m_max_batch, relaxed->m_window_ns);
+	if(!ts_heap_init(&consumer->ring_heap, n_rings)) {
+		log_errorf("failed to alloc memory for the ring heap");
+		return errno;
+	}
+	consumer->idle_rings = (uint32_t *)calloc(n_rings, sizeof(uint32_t));
+	if(consumer->idle_rings == NULL) {
+		log_errorf("failed to alloc memory for idle_rings");
+		return errno;
+	}
+	/* At the beginning no ring has an event ready */
+	for(uint32_t i = 0; i < n_rings; i++) {
+		consumer->idle_rings[i] = first_ring + i;
+	}
+	consumer->n_idle_rings = n_rings;
+	return 0;
+}
+
+static void ring_consumer_free(struct ring_consumer *consumer) {
+	ts_heap_free(&consumer->ring_heap);
+	if(consumer->idle_rings) {
+		free(consumer->idle_rings);
+		consumer->idle_rings = NULL;
+	}
+	consumer->n_idle_rings = 0;
+}
+
+void free_ring_consumers() {
+	ring_consumer_free(&g_state.consumer);
+	if(g_state.shards) {
+		for(uint32_t i = 0; i < g_state.n_shards; i++) {
+			ring_consumer_free(&g_state.shards[i]);
+		}
+		free(g_state.shards);
+		g_state.shards = NULL;
+	}
+	g_state.n_shards = 0;
+}
+
+/* The main consumer merges all the rings. If the user asked for shards we also split the rings
+ * into contiguous ranges of (almost) the same size, one for each shard.
+ */
+static int allocate_ring_consumers() {
+	const struct relaxed_order *relaxed = &g_state.consumer.relaxed;
+	int err = ring_consumer_init(&g_state.consumer, 0, g_state.n_required_buffers, relaxed);
+	if(err || g_state.n_requested_shards <= 1) {
+		return err;
+	}
+
+	uint32_t n_shards = g_state.n_requested_shards;
+	if(n_shards > g_state.n_required_buffers) {
+		n_shards = g_state.n_required_buffers;
+	}
+	g_state.shards = (struct ring_consumer *)calloc(n_shards, sizeof(struct ring_consumer));
+	if(g_state.shards == NULL) {
+		log_errorf("failed to alloc memory for the shards");
+		return errno;
+	}
+	g_state.n_shards = n_shards;
+
+	uint32_t first_ring = 0;
+	for(uint32_t i = 0; i < n_shards; i++) {
+		uint32_t n_rings = g_state.n_required_buffers / n_shards +
+		                   (i < g_state.n_required_buffers % n_shards ? 1 : 0);
+		err = ring_consumer_init(&g_state.shards[i], first_ring, n_rings, relaxed);
+		if(err) {
+			return err;
+		}
+		first_ring += n_rings;
+	}
+	return 0;
+}
+
 /* Before loading */
 int pman_prepare_ringbuf_array_before_loading() {
 	int err = ringbuf_array_set_inner_map(g_state.skel,
@@ -89,6 +172,8 @@ int pman_prepare_ringbuf_array_before_loading() {
 	err = err ?: ringbuf_array_set_max_entries(g_state.skel, g_state.n_possible_cpus);
 	/* Allocate consumer positions and producer positions for the ringbuffer. */
 	err = err ?: allocate_consumer_producer_positions();
+	/* Allocate the structures used to merge the ring buffers in timestamp order. */
+	err = err ?: allocate_ring_consumers();
 	return err;
 }
 
@@ -250,7 +335,9 @@ clean_percpu_ring_buffers:
 	return last_errno;
 }
 
-static inline void *ringbuf__get_first_ring_event(struct ring *r, int pos) {
+static inline void *ringbuf__get_first_ring_event(struct ring *r,
+                                                   int pos,
+                                                   unsigned long *event_size) {
 	int *len_ptr = NULL;
 	int len = 0;
 
@@ -278,7 +365,7 @@ static inline void *ringbuf__get_first_ring_event(struct ring *r, int pos) {
 	/* the sample is not discarded kernel side. */
 	if((len & BPF_RINGBUF_DISCARD_BIT) == 0) {
 		/* Save the size of the event if we need to increment the consumer */
-		g_state.last_event_size = roundup_len(len);
+		*event_size = roundup_len(len);
 		return (void *)len_ptr + BPF_RINGBUF_HDR_SZ;
 	} else {
 		/* Discard the event kernel side and update the consumer position */
@@ -288,49 +375,205 @@ static inline void *ringbuf__get_first_ring_event(struct ring *r, int pos) {
 	}
 }
 
+/* Move the consumer position of a ring after the last event we have read from it. While reading a
+ * batch the new position is not published to the producer: the events of the batch must stay
+ * valid until the next call.
+ */
+static inline void ring_consumer_advance(struct ring_buffer *rb,
+                                         struct ring_consumer *consumer,
+                                         uint32_t pos) {
+	g_state.cons_pos[pos] += consumer->last_event_size;
+	if(consumer->batching) {
+		consumer->unpublished = true;
+		return;
+	}
+	smp_store_release(rb->rings[pos]->consumer_pos, g_state.cons_pos[pos]);
+}
+
+static void ring_consumer_publish(struct ring_buffer *rb, struct ring_consumer *consumer) {
+	uint32_t end = consumer->first_ring + consumer->n_rings;
+	for(uint32_t pos = consumer->first_ring; pos < end; pos++) {
+		smp_store_release(rb->rings[pos]->consumer_pos, g_state.cons_pos[pos]);
+	}
+	consumer->unpublished = false;
+}
+
+/* Rings that have an event ready are kept in `consumer->ring_heap`, keyed on the timestamp of that
+ * event. Since the events inside a ring are ordered, after consuming an event we only need to
+ * update the key of the ring we have read from, instead of looking at the first event of every
+ * ring.
+ *
+ * Rings without an event ready (empty, or with the first event not yet committed) are kept in
+ * `consumer->idle_rings` and polled at every call: a producer can write into them at any time, and
+ * the new event could have a timestamp lower than all the events in the heap. Under load almost all
+ * the rings have an event ready, so the cost per event is O(log(n_rings)).
+ */
 static void ringbuf__consume_first_event(struct ring_buffer *rb,
+                                         struct ring_consumer *consumer,
                                          struct ppm_evt_hdr **event_ptr,
                                          int16_t *buffer_id) {
-	uint64_t min_ts = 0xffffffffffffffffLL;
+	struct ts_heap *heap = &consumer->ring_heap;
 	struct ppm_evt_hdr *tmp_pointer = NULL;
-	int tmp_ring = -1;
-	unsigned long tmp_cons_increment = 0;
+	uint32_t pos = 0;
 
 	/* If the last consume operation was successful we can push the consumer position */
-	if(g_state.last_ring_read != -1) {
-		struct ring *r = rb->rings[g_state.last_ring_read];
-		g_state.cons_pos[g_state.last_ring_read] += g_state.last_event_size;
-		smp_store_release(r->consumer_pos, g_state.cons_pos[g_state.last_ring_read]);
+	if(consumer->last_ring_read != -1) {
+		pos = consumer->last_ring_read;
+		struct ring *r = rb->rings[pos];
+		ring_consumer_advance(rb, consumer, pos);
+
+		/* The ring we have just read from is on top of the heap, update it with its next event. */
+		tmp_pointer = ringbuf__get_first_ring_event(r, pos, &consumer->last_event_size);
+		R_D_EVENT(tmp_pointer, pos);
+		if(tmp_pointer != NULL) {
+			ts_heap_replace_top(heap, tmp_pointer->ts);
+		} else {
+			ts_heap_pop(heap);
+			consumer->idle_rings[consumer->n_idle_rings++] = pos;
+		}
 	}
 
-	R_D_MSG("\n-----------------------------\nIterate over all the buffers\n");
-	for(uint16_t pos = 0; pos < rb->ring_cnt; pos++) {
-		*event_ptr = ringbuf__get_first_ring_event(rb->rings[pos], pos);
-		R_D_EVENT(*event_ptr, pos);
+	R_D_MSG("\n-----------------------------\nIterate over the idle buffers\n");
+	for(uint32_t i = 0; i < consumer->n_idle_rings;) {
+		pos = consumer->idle_rings[i];
+		tmp_pointer =
+		        ringbuf__get_first_ring_event(rb->rings[pos], pos, &consumer->last_event_size);
+		R_D_EVENT(tmp_pointer, pos);
 
 		/* if NULL search for events in another buffer */
-		if(*event_ptr == NULL) {
+		if(tmp_pointer == NULL) {
+			i++;
 			continue;
 		}
 
-		if((*event_ptr)->ts < min_ts) {
-			min_ts = (*event_ptr)->ts;
-			tmp_pointer = *event_ptr;
-			tmp_ring = pos;
-			tmp_cons_increment = g_state.last_event_size;
-			R_D_MSG("Found new min with ts '%ld' on buffer %d\n", (*event_ptr)->ts, pos);
-		}
+		ts_heap_push(heap, tmp_pointer->ts, pos);
+		consumer->idle_rings[i] = consumer->idle_rings[--consumer->n_idle_rings];
+	}
+
+	if(ts_heap_empty(heap)) {
+		*event_ptr = NULL;
+		*buffer_id = -1;
+		consumer->last_ring_read = -1;
+		consumer->last_event_size = 0;
+		return;
 	}
 
-	*event_ptr = tmp_pointer;
-	*buffer_id = tmp_ring;
-	g_state.last_ring_read = tmp_ring;
-	g_state.last_event_size = tmp_cons_increment;
+	/* Reading again the first event of the ring on top also sets `consumer->last_event_size`. The
+	 * event is already committed so we are guaranteed to get it back.
+	 */
+	pos = ts_heap_top(heap)->id;
+	*event_ptr = ringbuf__get_first_ring_event(rb->rings[pos], pos, &consumer->last_event_size);
+	*buffer_id = pos;
+	consumer->last_ring_read = pos;
 	R_D_MSG("Send event -> ");
-	R_D_EVENT(*event_ptr, tmp_ring);
+	R_D_EVENT(*event_ptr, pos);
+}
+
+/* Relaxed ordering variant of `ringbuf__consume_first_event` (see `relaxed_order.h`): drain a
+ * batch of events from a ring before moving to the next one, without looking at the other rings.
+ */
+static void ringbuf__consume_next_event_relaxed(struct ring_buffer *rb,
+                                                struct ring_consumer *consumer,
+                                                struct ppm_evt_hdr **event_ptr,
+                                                int16_t *buffer_id) {
+	struct relaxed_order *ro = &consumer->relaxed;
+	struct ppm_evt_hdr *tmp_pointer = NULL;
+	uint32_t pos = 0;
+
+	/* If the last consume operation was successful we can push the consumer position */
+	if(consumer->last_ring_read != -1) {
+		ring_consumer_advance(rb, consumer, consumer->last_ring_read);
+	}
+
+	/* We visit the ring we are draining twice: if its batch is over but all the other rings are
+	 * empty, it can start a new batch.
+	 */
+	for(uint32_t i = 0; i <= consumer->n_rings; i++) {
+		if(i > 0) {
+			relaxed_order_next_buffer(ro, consumer->n_rings);
+		}
+		pos = consumer->first_ring + ro->m_cur;
+		tmp_pointer =
+		        ringbuf__get_first_ring_event(rb->rings[pos], pos, &consumer->last_event_size);
+		R_D_EVENT(tmp_pointer, pos);
+		if(tmp_pointer != NULL && relaxed_order_accept(ro, tmp_pointer->ts)) {
+			*event_ptr = tmp_pointer;
+			*buffer_id = pos;
+			consumer->last_ring_read = pos;
+			return;
+		}
+	}
+
+	*event_ptr = NULL;
+	*buffer_id = -1;
+	consumer->last_ring_read = -1;
+	consumer->last_event_size = 0;
+}
+
+static void ring_consumer_next(struct ring_consumer *consumer,
+                               void **event_ptr,
+                               int16_t *buffer_id) {
+	if(relaxed_order_enabled(&consumer->relaxed)) {
+		ringbuf__consume_next_event_relaxed(g_state.rb_manager,
+		                                    consumer,
+		                                    (struct ppm_evt_hdr **)event_ptr,
+		                                    buffer_id);
+	} else {
+		ringbuf__consume_first_event(g_state.rb_manager,
+		                             consumer,
+		                             (struct ppm_evt_hdr **)event_ptr,
+		                             buffer_id);
+	}
+
+	/* The events of a previous batch are not used anymore. */
+	if(consumer->unpublished && !consumer->batching) {
+		ring_consumer_publish(g_state.rb_manager, consumer);
+	}
+}
+
+static void ring_consumer_next_batch(struct ring_consumer *consumer,
+                                     void **events,
+                                     int16_t *buffer_ids,
+                                     uint32_t max_events,
+                                     uint32_t *n_events) {
+	uint32_t n = 0;
+
+	consumer->batching = true;
+	while(n < max_events) {
+		ring_consumer_next(consumer, &events[n], &buffer_ids[n]);
+		/* The events of the previous batch are not used anymore. */
+		if(n == 0 && consumer->unpublished) {
+			ring_consumer_publish(g_state.rb_manager, consumer);
+		}
+		if(events[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+	consumer->batching = false;
+	*n_events = n;
 }
 
 /* Consume */
 void pman_consume_first_event(void **event_ptr, int16_t *buffer_id) {
-	ringbuf__consume_first_event(g_state.rb_manager, (struct ppm_evt_hdr **)event_ptr, buffer_id);
+	ring_consumer_next(&g_state.consumer, event_ptr, buffer_id);
+}
+
+void pman_consume_batch(void **events,
+                        int16_t *buffer_ids,
+                        uint32_t max_events,
+                        uint32_t *n_events) {
+	ring_consumer_next_batch(&g_state.consumer, events, buffer_ids, max_events, n_events);
+}
+
+uint32_t pman_get_n_shards() {
+	return g_state.n_shards ? g_state.n_shards : 1;
+}
+
+void pman_consume_first_event_from_shard(uint32_t shard, void **event_ptr, int16_t *buffer_id) {
+	if(g_state.n_shards == 0) {
+		ring_consumer_next(&g_state.consumer, event_ptr, buffer_id);
+		return;
+	}
+	ring_consumer_next(&g_state.shards[shard], event_ptr, buffer_id);
 }
@@ -19,6 +19,8 @@ limitations under the License.
 #pragma once
 
 #include <libscap/scap_log.h>
+#include <libscap/ringbuffer/ts_heap.h>
+#include <libscap/ringbuffer/relaxed_order.h>
 
 #include <bpf/libbpf.h>
 #include <bpf/bpf.h>
@@ -53,6 +55,25 @@ struct bpf_iter_link_info_support_info {
 
 #endif /* BPF_ITERATOR_SUPPORT */
 
+/* State used to consume the rings `[first_ring, first_ring + n_rings)`. Consumers that don't share
+ * any ring can be used by different threads at the same time.
+ */
+struct ring_consumer {
+	uint32_t first_ring; /* first ring consumed. */
+	uint32_t n_rings;    /* number of rings consumed. */
+	int last_ring_read; /* Last ring from which we have correctly read an event. Could be `-1` if
+	               there were no successful reads. */
+	unsigned long last_event_size; /* Last event correctly read. Could be `0` if there were no
+	                                  successful reads. */
+	struct ts_heap ring_heap; /* rings with an event ready to be consumed, keyed on the timestamp
+	                             of that event. */
+	uint32_t* idle_rings;     /* rings without an event ready the last time we checked them. */
+	uint32_t n_idle_rings;    /* number of entries in `idle_rings`. */
+	struct relaxed_order relaxed; /* used instead of `ring_heap` in relaxed ordering mode. */
+	bool batching;    /* we are reading a batch of events, see `pman_consume_batch`. */
+	bool unpublished; /* some consumer positions have not been published to the producers. */
+};
+
 struct internal_state {
 	struct bpf_probe* skel;         /* bpf skeleton with all programs and maps. */
 	struct ring_buffer* rb_manager; /* ring_buffer manager with all per-CPU ringbufs. */
@@ -71,10 +92,10 @@ struct internal_state {
 	int32_t inner_ringbuf_map_fd;   /* inner map used to configure the ringbuf array before loading
 	                                   phase. */
 	unsigned long buffer_bytes_dim; /* dimension of a single per-CPU ringbuffer in bytes. */
-	int last_ring_read; /* Last ring from which we have correctly read an event. Could be `-1` if
-	               there were no successful reads. */
-	unsigned long last_event_size; /* Last event correctly read. Could be `0` if there were no
-	                                  successful reads. */
+	struct ring_consumer consumer; /* consumes all the rings, used by `pman_consume_first_event`. */
+	uint32_t n_requested_shards;   /* number of shards requested through `pman_set_n_shards`. */
+	struct ring_consumer* shards;  /* every shard consumes a different range of rings. */
+	uint32_t n_shards;             /* number of entries in `shards`, `0` if we are not sharded. */
 
 	/* Stats v2 utilities */
 	int32_t attached_progs_fds[MODERN_BPF_PROG_ATTACHED_MAX]; /* file descriptors of attached
@@ -110,6 +131,8 @@ struct internal_state {
 
 extern struct internal_state g_state;
 
+extern void free_ring_consumers(void);
+
 extern void log_errorf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
 extern void log_msgf(enum falcosecurity_log_severity level, const char* fmt, ...)
         __attribute__((format(printf, 2, 3)));
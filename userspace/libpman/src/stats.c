@@ -204,8 +204,12 @@ static int init_metrics_v2(const uint32_t flags) {
 	}
 #endif /* BPF_ITERATOR_SUPPORT */
 
+	// In relaxed ordering mode we also report the max reordering we have observed.
+	uint32_t relaxed_order_stats = relaxed_order_enabled(&g_state.consumer.relaxed) ? 1 : 0;
+
 	const uint32_t n_stats = MODERN_BPF_MAX_KERNEL_COUNTERS_STATS + per_cpu_stats +
-	                         (nprogs_attached * MODERN_BPF_MAX_LIBBPF_STATS) + iter_stats;
+	                         (nprogs_attached * MODERN_BPF_MAX_LIBBPF_STATS) + iter_stats +
+	                         relaxed_order_stats;
 	struct metrics_v2 *stats = (metrics_v2 *)calloc(n_stats, sizeof(metrics_v2));
 	if(!stats) {
 		log_errorf("unable to allocate memory for 'metrics_v2' array");
@@ -474,6 +478,24 @@ struct metrics_v2 *pman_get_metrics_v2(uint32_t flags, uint32_t *nstats, int32_t
 			return NULL;
 		}
 		offset = collected_stats;
+
+		if(relaxed_order_enabled(&g_state.consumer.relaxed)) {
+			/* Every shard tracks its own reordering, we report the worst one. */
+			uint64_t max_reorder_ns = g_state.consumer.relaxed.m_max_reorder_ns;
+			for(uint32_t i = 0; i < g_state.n_shards; i++) {
+				if(g_state.shards[i].relaxed.m_max_reorder_ns > max_reorder_ns) {
+					max_reorder_ns = g_state.shards[i].relaxed.m_max_reorder_ns;
+				}
+			}
+
+			g_state.stats[offset].type = METRIC_VALUE_TYPE_U64;
+			g_state.stats[offset].flags = METRICS_V2_KERNEL_COUNTERS;
+			g_state.stats[offset].unit = METRIC_VALUE_UNIT_TIME_NS;
+			g_state.stats[offset].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+			g_state.stats[offset].value.u64 = max_reorder_ns;
+			strlcpy(g_state.stats[offset].name, RELAXED_ORDER_MAX_REORDER_NS_NAME, METRIC_NAME_MAX);
+			offset++;
+		}
 	}
 
 	/* LIBBPF STATS */
@@ -27,6 +27,17 @@ struct scap_kmod_engine_params {
 	unsigned long buffer_bytes_dim;  ///< Dimension of a single per-CPU buffer in bytes. Please
 	                                 ///< note: this buffer will be mapped twice in the process
 	                                 ///< virtual memory, so pay attention to its size.
+	uint32_t relaxed_ordering_batch;  ///< [EXPERIMENTAL] If not `0`, events are not sorted by
+	                                  ///< timestamp across CPUs: up to this number of events are
+	                                  ///< consumed from a per-CPU buffer before moving to the
+	                                  ///< next one.
+	uint64_t relaxed_ordering_window_ns;  ///< [EXPERIMENTAL] When `relaxed_ordering_batch` is
+	                                      ///< set, a batch also ends when the next event is more
+	                                      ///< than this number of ns newer than the first event
+	                                      ///< of the batch. `0` means no limit.
+	uint32_t n_shards;  ///< [EXPERIMENTAL] Split the per-CPU buffers into this number of groups
+	                    ///< that can be consumed by different threads with `scap_next_shard`.
+	                    ///< `0` and `1` mean a single group.
 };
 
 extern const struct scap_linux_vtable scap_kmod_linux_vtable;
@@ -334,6 +334,15 @@ int32_t scap_kmod_init(scap_t *handle, scap_open_args *oargs) {
 		return rc;
 	}
 
+	relaxed_order_init(&HANDLE(engine)->m_dev_set.m_relaxed,
+	                   params->relaxed_ordering_batch,
+	                   params->relaxed_ordering_window_ns);
+
+	rc = devset_init_shards(&HANDLE(engine)->m_dev_set, params->n_shards, handle->m_lasterr);
+	if(rc != SCAP_SUCCESS) {
+		return rc;
+	}
+
 	//
 	// Allocate the device descriptors.
 	//
@@ -545,6 +554,44 @@ int32_t scap_kmod_next(struct scap_engine_handle engine,
 	return ringbuffer_next(&HANDLE(engine)->m_dev_set, pevent, pdevid, pflags);
 }
 
+static int32_t scap_kmod_next_batch(struct scap_engine_handle engine,
+                                    scap_evt **pevents,
+                                    uint16_t *pdevids,
+                                    uint32_t *pflags,
+                                    uint32_t max_events,
+                                    uint32_t *pnevents) {
+	return ringbuffer_next_batch(&HANDLE(engine)->m_dev_set,
+	                             pevents,
+	                             pdevids,
+	                             pflags,
+	                             max_events,
+	                             pnevents);
+}
+
+static uint32_t scap_kmod_get_n_shards(struct scap_engine_handle engine) {
+	struct scap_device_set *devset = &HANDLE(engine)->m_dev_set;
+	return devset->m_nshards ? devset->m_nshards : 1;
+}
+
+static int32_t scap_kmod_next_shard(struct scap_engine_handle engine,
+                                    uint32_t shard_id,
+                                    scap_evt **pevent,
+                                    uint16_t *pdevid,
+                                    uint32_t *pflags) {
+	struct scap_device_set *devset = &HANDLE(engine)->m_dev_set;
+	if(devset->m_nshards == 0) {
+		return ringbuffer_next(devset, pevent, pdevid, pflags);
+	}
+
+	struct scap_device_set *shard = &devset->m_shards[shard_id];
+	int32_t res = ringbuffer_next(shard, pevent, pdevid, pflags);
+	if(res == SCAP_SUCCESS) {
+		// The shard returns the position of the device inside the shard.
+		*pdevid += (uint16_t)(shard->m_devs - devset->m_devs);
+	}
+	return res;
+}
+
 uint32_t scap_kmod_get_n_devs(struct scap_engine_handle engine) {
 	return HANDLE(engine)->m_dev_set.m_ndevs;
 }
@@ -616,7 +663,10 @@ const struct metrics_v2 *scap_kmod_get_stats_v2(struct scap_engine_handle engine
 			per_dev_stats = devset->m_ndevs * 2;
 		}
 
-		handle->m_nstats = KMOD_MAX_KERNEL_COUNTERS_STATS + per_dev_stats;
+		// In relaxed ordering mode we also report the max reordering we have observed.
+		uint32_t relaxed_order_stats = relaxed_order_enabled(&devset->m_relaxed) ? 1 : 0;
+
+		handle->m_nstats = KMOD_MAX_KERNEL_COUNTERS_STATS + per_dev_stats + relaxed_order_stats;
 		handle->m_stats = (metrics_v2 *)calloc(handle->m_nstats, sizeof(metrics_v2));
 		if(!handle->m_stats) {
 			handle->m_nstats = 0;
@@ -687,6 +737,23 @@ const struct metrics_v2 *scap_kmod_get_stats_v2(struct scap_engine_handle engine
 				pos++;
 			}
 		}
+
+		if(relaxed_order_enabled(&devset->m_relaxed)) {
+			stats[pos].type = METRIC_VALUE_TYPE_U64;
+			stats[pos].flags = METRICS_V2_KERNEL_COUNTERS;
+			stats[pos].unit = METRIC_VALUE_UNIT_TIME_NS;
+			stats[pos].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+			// Every shard tracks its own reordering, we report the worst one.
+			uint64_t max_reorder_ns = devset->m_relaxed.m_max_reorder_ns;
+			for(uint32_t j = 0; j < devset->m_nshards; j++) {
+				if(devset->m_shards[j].m_relaxed.m_max_reorder_ns > max_reorder_ns) {
+					max_reorder_ns = devset->m_shards[j].m_relaxed.m_max_reorder_ns;
+				}
+			}
+			stats[pos].value.u64 = max_reorder_ns;
+			strlcpy(stats[pos].name, RELAXED_ORDER_MAX_REORDER_NS_NAME, METRIC_NAME_MAX);
+			pos++;
+		}
 		offset = pos;
 	}
 
@@ -773,18 +840,10 @@ int32_t scap_kmod_set_snaplen(struct scap_engine_handle engine, uint32_t snaplen
 		return scap_errprintf(HANDLE(engine)->m_lasterr, errno, "scap_set_snaplen failed");
 	}
 
-	uint32_t j;
-
 	//
 	// Force a flush of the read buffers, so we don't capture events with the old snaplen
 	//
-	for(j = 0; j < devset->m_ndevs; j++) {
-		ringbuffer_readbuf(&devset->m_devs[j],
-		                   &devset->m_devs[j].m_sn_next_event,
-		                   &devset->m_devs[j].m_sn_len);
-
-		devset->m_devs[j].m_sn_len = 0;
-	}
+	ringbuffer_flush_read_buffers(devset);
 	return SCAP_SUCCESS;
 }
 
@@ -837,18 +896,10 @@ int32_t scap_kmod_set_fullcapture_port_range(struct scap_engine_handle engine,
 		                      "scap_set_fullcapture_port_range failed");
 	}
 
-	uint32_t j;
-
 	//
 	// Force a flush of the read buffers, so we don't capture events with the old snaplen
 	//
-	for(j = 0; j < devset->m_ndevs; j++) {
-		ringbuffer_readbuf(&devset->m_devs[j],
-		                   &devset->m_devs[j].m_sn_next_event,
-		                   &devset->m_devs[j].m_sn_len);
-
-		devset->m_devs[j].m_sn_len = 0;
-	}
+	ringbuffer_flush_read_buffers(devset);
 
 	return SCAP_SUCCESS;
 }
@@ -864,19 +915,11 @@ int32_t scap_kmod_set_statsd_port(struct scap_engine_handle engine, const uint16
 		                      "scap_set_statsd_port: ioctl failed");
 	}
 
-	uint32_t j;
-
 	//
 	// Force a flush of the read buffers, so we don't
 	// capture events with the old snaplen
 	//
-	for(j = 0; j < devset->m_ndevs; j++) {
-		ringbuffer_readbuf(&devset->m_devs[j],
-		                   &devset->m_devs[j].m_sn_next_event,
-		                   &devset->m_devs[j].m_sn_len);
-
-		devset->m_devs[j].m_sn_len = 0;
-	}
+	ringbuffer_flush_read_buffers(devset);
 
 	return SCAP_SUCCESS;
 }
@@ -998,6 +1041,9 @@ struct scap_vtable scap_kmod_engine = {
         .free_handle = free_handle,
         .close = scap_kmod_close,
         .next = scap_kmod_next,
+        .next_batch = scap_kmod_next_batch,
+        .get_n_shards = scap_kmod_get_n_shards,
+        .next_shard = scap_kmod_next_shard,
         .start_capture = scap_kmod_start_capture,
         .stop_capture = scap_kmod_stop_capture,
         .configure = configure,
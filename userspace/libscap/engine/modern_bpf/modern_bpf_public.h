@@ -40,6 +40,17 @@ struct scap_modern_bpf_engine_params {
 	bool disable_iterators;    ///< If true, disable the BPF iterator support for synchronous
 	                           ///< information fetching, letting scap falling back to the procfs
 	                           ///< lookups.
+	uint32_t relaxed_ordering_batch;  ///< [EXPERIMENTAL] If not `0`, events are not sorted by
+	                                  ///< timestamp across ring buffers: up to this number of
+	                                  ///< events are consumed from a ring buffer before moving to
+	                                  ///< the next one.
+	uint64_t relaxed_ordering_window_ns;  ///< [EXPERIMENTAL] When `relaxed_ordering_batch` is
+	                                      ///< set, a batch also ends when the next event is more
+	                                      ///< than this number of ns newer than the first event
+	                                      ///< of the batch. `0` means no limit.
+	uint32_t n_shards;  ///< [EXPERIMENTAL] Split the ring buffers into this number of groups
+	                    ///< that can be consumed by different threads with `scap_next_shard`.
+	                    ///< `0` and `1` mean a single group.
 };
 
 extern const struct scap_linux_vtable scap_modern_bpf_linux_vtable;
@@ -18,6 +18,7 @@ limitations under the License.
 #include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/socket.h>
 
 #define HANDLE(engine) ((struct modern_bpf_engine*)(engine.m_handle))
@@ -44,6 +45,7 @@ static void* scap_modern_bpf__alloc_engine(scap_t* main_handle, char* lasterr_pt
 }
 
 static void scap_modern_bpf__free_engine(struct scap_engine_handle engine) {
+	free(HANDLE(engine)->m_shard_retry_us);
 	free(engine.m_handle);
 }
 
@@ -71,6 +73,52 @@ static int32_t scap_modern_bpf__next(struct scap_engine_handle engine,
 	return SCAP_SUCCESS;
 }
 
+static int32_t scap_modern_bpf__next_batch(struct scap_engine_handle engine,
+                                           scap_evt** pevents,
+                                           uint16_t* buffer_ids,
+                                           uint32_t* pflags,
+                                           uint32_t max_events,
+                                           uint32_t* pnevents) {
+	pman_consume_batch((void**)pevents, (int16_t*)buffer_ids, max_events, pnevents);
+
+	if(*pnevents == 0) {
+		/* Same backoff as `scap_modern_bpf__next`. */
+		usleep(HANDLE(engine)->m_retry_us);
+		HANDLE(engine)->m_retry_us =
+		        MIN(HANDLE(engine)->m_retry_us * 2, BUFFER_EMPTY_WAIT_TIME_US_MAX);
+		return SCAP_TIMEOUT;
+	} else {
+		HANDLE(engine)->m_retry_us = BUFFER_EMPTY_WAIT_TIME_US_START;
+	}
+	memset(pflags, 0, *pnevents * sizeof(uint32_t));
+	return SCAP_SUCCESS;
+}
+
+static uint32_t scap_modern_bpf__get_n_shards(struct scap_engine_handle engine) {
+	return pman_get_n_shards();
+}
+
+static int32_t scap_modern_bpf__next_shard(struct scap_engine_handle engine,
+                                           uint32_t shard,
+                                           scap_evt** pevent,
+                                           uint16_t* buffer_id,
+                                           uint32_t* pflags) {
+	unsigned long* retry_us = &HANDLE(engine)->m_shard_retry_us[shard];
+
+	pman_consume_first_event_from_shard(shard, (void**)pevent, (int16_t*)buffer_id);
+
+	if((*pevent) == NULL) {
+		/* Same backoff as `scap_modern_bpf__next`, but every shard has its own. */
+		usleep(*retry_us);
+		*retry_us = MIN(*retry_us * 2, BUFFER_EMPTY_WAIT_TIME_US_MAX);
+		return SCAP_TIMEOUT;
+	} else {
+		*retry_us = BUFFER_EMPTY_WAIT_TIME_US_START;
+	}
+	*pflags = 0;
+	return SCAP_SUCCESS;
+}
+
 static int32_t scap_modern_bpf_start_dropping_mode(struct scap_engine_handle engine,
                                                    uint32_t sampling_ratio) {
 	pman_set_sampling_ratio(sampling_ratio);
@@ -250,6 +298,8 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 	                   params->disable_iterators)) {
 		return scap_errprintf(handle->m_lasterr, 0, "unable to configure the libpman state.");
 	}
+	pman_set_relaxed_ordering(params->relaxed_ordering_batch, params->relaxed_ordering_window_ns);
+	pman_set_n_shards(params->n_shards);
 
 	/* Set an initial sleep time in case of timeouts. */
 	HANDLE(engine)->m_retry_us = BUFFER_EMPTY_WAIT_TIME_US_START;
@@ -266,6 +316,16 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 		return ret;
 	}
 
+	/* The number of shards is known only after the ring buffers allocation. */
+	uint32_t n_shards = pman_get_n_shards();
+	HANDLE(engine)->m_shard_retry_us = calloc(n_shards, sizeof(unsigned long));
+	if(HANDLE(engine)->m_shard_retry_us == NULL) {
+		return scap_errprintf(handle->m_lasterr, 0, "unable to allocate the shards state.");
+	}
+	for(uint32_t i = 0; i < n_shards; i++) {
+		HANDLE(engine)->m_shard_retry_us[i] = BUFFER_EMPTY_WAIT_TIME_US_START;
+	}
+
 	/* Set the boot time */
 	uint64_t boot_time = 0;
 	if(scap_get_precise_boot_time(handle->m_lasterr, &boot_time) != SCAP_SUCCESS) {
@@ -396,6 +456,9 @@ struct scap_vtable scap_modern_bpf_engine = {
         .free_handle = scap_modern_bpf__free_engine,
         .close = scap_modern_bpf__close,
         .next = scap_modern_bpf__next,
+        .next_batch = scap_modern_bpf__next_batch,
+        .get_n_shards = scap_modern_bpf__get_n_shards,
+        .next_shard = scap_modern_bpf__next_shard,
         .start_capture = scap_modern_bpf__start_capture,
         .stop_capture = scap_modern_bpf__stop_capture,
         .configure = scap_modern_bpf__configure,
@@ -21,6 +21,7 @@ limitations under the License.
 #include <libscap/scap_limits.h>
 #include <libscap/engine/savefile/scap_reader.h>
 #include <libscap/scap_savefile.h>
+#include <libscap/scap_savefile_api.h>
 #include <libscap/strerror.h>
 
 #define READER_BUF_SIZE (1 << 16)  // UINT16_MAX + 1, ie: 65536
@@ -107,8 +108,23 @@ struct savefile_engine {
 	bool m_use_last_block_header;
 	char* m_reader_evt_buf;
 	size_t m_reader_evt_buf_size;
+	// Whether the last event read points into the data of the reader,
+	// and stays valid until the reader is closed
+	bool m_evt_in_place;
+	// Holds the events of a batch that are not read in place
+	char* m_batch_buf;
 	uint32_t m_last_evt_dump_flags;
 	struct scap_platform* m_platform;
+	// Used to seek by timestamp
+	char* m_fname;                         // The capture file, NULL if read from m_fd
+	int m_fd;                              // The fd read by the current reader
+	int64_t m_raw_start;                   // The offset in the file where the capture starts
+	uint64_t m_tell_base;                  // The offset where the current reader starts
+	uint32_t m_fbuffer_size;               // The buffer size of the readers
+	index_block_entry* m_index;            // The index of the capture, when loaded
+	uint32_t m_index_size;                 // The number of entries in m_index
+	compression_mode m_index_compression;  // The compression of the chunks of the index
+	uint64_t m_seek_ts;                    // Events before this timestamp are skipped
 	// Used by the scap-file converter
 	char* m_new_evt;
 	char* m_to_convert_evt;
@@ -14,6 +14,7 @@ limitations under the License.
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <libscap/scap_procs.h>
 
@@ -31,6 +32,9 @@ struct scap_savefile_engine_params {
 	                        ///< is leveraged when opening merged files.
 	uint32_t fbuffer_size;  ///< If non-zero, offline captures will read from file using a buffer of
 	                        ///< this size.
+	bool use_mmap;          ///< If true, uncompressed capture files are memory-mapped and their
+	                        ///< events are returned in place, without copies. Compressed captures
+	                        ///< and files that can't be mapped are read as usual.
 
 	struct scap_platform* platform;
 };
@@ -46,6 +46,15 @@ typedef struct scap_reader {
 	 */
 	int (*read)(struct scap_reader *r, void *buf, uint32_t len);
 
+	/**
+	 * @brief Returns a pointer to the next len bytes of the given reader,
+	 * and moves past them, without copying the data. The data stays valid
+	 * until the reader gets closed. Returns NULL, without moving, if less
+	 * than len bytes are available. Optional: NULL for the readers that
+	 * can't hand out their data in place, which must be read with read().
+	 */
+	void *(*read_ptr)(struct scap_reader *r, uint32_t len);
+
 	/**
 	 * @brief Returns the current offset in the data being read.
 	 * On error, returns a negative value and error() can be used to
@@ -97,6 +106,25 @@ scap_reader_t *scap_reader_open_gzfile(gzFile file);
  */
 scap_reader_t *scap_reader_open_buffered(scap_reader_t *reader, uint32_t bufsize, bool own_reader);
 
+#ifndef _WIN32
+/**
+ * @brief Opens a reader mapping a regular file in memory, starting at the
+ * current offset of fd. Its data is read in place with read_ptr().
+ * Returns NULL if the file can't be mapped, in which case fd is left open.
+ * @param own_fd if true, fd will be closed when the reader gets closed.
+ */
+scap_reader_t *scap_reader_open_mmap(int fd, bool own_fd);
+#endif
+
+#ifdef USE_ZSTD
+/**
+ * @brief Opens a reader decompressing the zstd frames read from fd, starting
+ * at its current offset. Seeking backward decompresses the data again from
+ * that offset. As with gzdopen(), fd is closed when the reader gets closed.
+ */
+scap_reader_t *scap_reader_open_zstd(int fd);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,7 @@ scap_reader_t *scap_reader_open_gzfile(gzFile file) {
 	scap_reader_t *r = (scap_reader_t *)malloc(sizeof(scap_reader_t));
 	r->handle = h;
 	r->read = &gzfile_read;
+	r->read_ptr = NULL;
 	r->offset = &gzfile_offset;
 	r->tell = &gzfile_tell;
 	r->seek = &gzfile_seek;
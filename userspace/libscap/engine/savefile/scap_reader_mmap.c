@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/engine/savefile/scap_reader.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+typedef struct reader_handle {
+	int m_fd;         ///< The mapped file
+	bool m_close_fd;  ///< Whether the file should be closed
+	uint8_t* m_data;  ///< The mapping of the whole file
+	uint64_t m_size;  ///< The size of the file
+	uint64_t m_pos;   ///< The cursor position in the file
+	int m_errnum;     ///< The errno of the last error, 0 if none
+} reader_handle_t;
+
+static int mmap_read(scap_reader_t* r, void* buf, uint32_t len) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	uint64_t avail = h->m_size - h->m_pos;
+	uint32_t size = len < avail ? len : (uint32_t)avail;
+	memcpy(buf, h->m_data + h->m_pos, size);
+	h->m_pos += size;
+	return (int)size;
+}
+
+static void* mmap_read_ptr(scap_reader_t* r, uint32_t len) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	if(h->m_size - h->m_pos < len) {
+		return NULL;
+	}
+	void* res = h->m_data + h->m_pos;
+	h->m_pos += len;
+	return res;
+}
+
+static int64_t mmap_offset(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	return (int64_t)((reader_handle_t*)r->handle)->m_pos;
+}
+
+static int64_t mmap_tell(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	return (int64_t)((reader_handle_t*)r->handle)->m_pos;
+}
+
+static int64_t mmap_seek(scap_reader_t* r, int64_t offset, int whence) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	int64_t pos;
+	switch(whence) {
+	case SEEK_SET:
+		pos = offset;
+		break;
+	case SEEK_CUR:
+		pos = (int64_t)h->m_pos + offset;
+		break;
+	case SEEK_END:
+		pos = (int64_t)h->m_size + offset;
+		break;
+	default:
+		h->m_errnum = EINVAL;
+		return -1;
+	}
+	if(pos < 0 || (uint64_t)pos > h->m_size) {
+		h->m_errnum = EINVAL;
+		return -1;
+	}
+	h->m_pos = (uint64_t)pos;
+	return pos;
+}
+
+static const char* mmap_error(scap_reader_t* r, int* errnum) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	*errnum = h->m_errnum;
+	return h->m_errnum != 0 ? strerror(h->m_errnum) : "";
+}
+
+static int mmap_close(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	int res = munmap(h->m_data, h->m_size);
+	if(h->m_close_fd && close(h->m_fd) != 0) {
+		res = -1;
+	}
+	free(h);
+	free(r);
+	return res;
+}
+
+scap_reader_t* scap_reader_open_mmap(int fd, bool own_fd) {
+	struct stat st;
+	if(fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+		return NULL;
+	}
+	off_t pos = lseek(fd, 0, SEEK_CUR);
+	if(pos < 0 || pos > st.st_size) {
+		return NULL;
+	}
+
+	// the mapping is private and writable: the events are handed out in place,
+	// and the few consumers patching them only get a copy of the pages they touch
+	void* data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if(data == MAP_FAILED) {
+		return NULL;
+	}
+	// the events are read in order, let the kernel read ahead aggressively
+	madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	reader_handle_t* h = (reader_handle_t*)calloc(1, sizeof(reader_handle_t));
+	scap_reader_t* r = (scap_reader_t*)malloc(sizeof(scap_reader_t));
+	if(h == NULL || r == NULL) {
+		free(h);
+		free(r);
+		munmap(data, (size_t)st.st_size);
+		return NULL;
+	}
+	h->m_fd = fd;
+	h->m_close_fd = own_fd;
+	h->m_data = (uint8_t*)data;
+	h->m_size = (uint64_t)st.st_size;
+	h->m_pos = (uint64_t)pos;
+
+	r->handle = h;
+	r->read = &mmap_read;
+	r->read_ptr = &mmap_read_ptr;
+	r->offset = &mmap_offset;
+	r->tell = &mmap_tell;
+	r->seek = &mmap_seek;
+	r->error = &mmap_error;
+	r->close = &mmap_close;
+	return r;
+}
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/engine/savefile/scap_reader.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <zstd.h>
+
+typedef struct reader_handle {
+	int m_fd;                  ///< The compressed file
+	ZSTD_DCtx* m_dctx;         ///< The decompression context
+	uint8_t* m_in;             ///< The compressed data read from the file
+	size_t m_in_size;          ///< The size of m_in
+	ZSTD_inBuffer m_input;     ///< The compressed data not decompressed yet
+	int64_t m_start;           ///< The offset of the compressed data in the file
+	int64_t m_raw_pos;         ///< The offset in the file of the next read from it
+	int64_t m_pos;             ///< The position in the decompressed data
+	int m_errnum;              ///< The errno of the last error, 0 if none
+	const char* m_zstd_error;  ///< The last decompression error, if any
+} reader_handle_t;
+
+static int zstd_fail(reader_handle_t* h, int errnum, const char* zstd_error) {
+	h->m_errnum = errnum;
+	h->m_zstd_error = zstd_error;
+	return -1;
+}
+
+static int zstd_read(scap_reader_t* r, void* buf, uint32_t len) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	ZSTD_outBuffer out = {buf, len, 0};
+
+	while(out.pos < out.size) {
+		// Data can be pending in the decoder even if all the input is consumed
+		size_t ret = ZSTD_decompressStream(h->m_dctx, &out, &h->m_input);
+		if(ZSTD_isError(ret)) {
+			return zstd_fail(h, EIO, ZSTD_getErrorName(ret));
+		}
+		if(out.pos == out.size || h->m_input.pos < h->m_input.size) {
+			continue;
+		}
+
+		ssize_t n = read(h->m_fd, h->m_in, h->m_in_size);
+		if(n < 0) {
+			return zstd_fail(h, errno, NULL);
+		}
+		if(n == 0) {
+			// End of input, the file might still be growing
+			break;
+		}
+		h->m_input.src = h->m_in;
+		h->m_input.size = (size_t)n;
+		h->m_input.pos = 0;
+		h->m_raw_pos += n;
+	}
+
+	h->m_pos += out.pos;
+	return (int)out.pos;
+}
+
+static int64_t zstd_offset(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	return ((reader_handle_t*)r->handle)->m_raw_pos;
+}
+
+static int64_t zstd_tell(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	return ((reader_handle_t*)r->handle)->m_pos;
+}
+
+// Frames can only be decompressed from their start, so seeking means decompressing
+// and discarding the data up to the target, from the start of the file if it's behind
+static int64_t zstd_seek(scap_reader_t* r, int64_t offset, int whence) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	int64_t pos;
+	switch(whence) {
+	case SEEK_SET:
+		pos = offset;
+		break;
+	case SEEK_CUR:
+		pos = h->m_pos + offset;
+		break;
+	default:
+		return zstd_fail(h, EINVAL, NULL);
+	}
+	if(pos < 0) {
+		return zstd_fail(h, EINVAL, NULL);
+	}
+
+	if(pos < h->m_pos) {
+		if(lseek(h->m_fd, h->m_start, SEEK_SET) < 0) {
+			return zstd_fail(h, errno, NULL);
+		}
+		ZSTD_DCtx_reset(h->m_dctx, ZSTD_reset_session_only);
+		h->m_input.size = 0;
+		h->m_input.pos = 0;
+		h->m_raw_pos = h->m_start;
+		h->m_pos = 0;
+	}
+
+	char buf[4096];
+	while(h->m_pos < pos) {
+		int64_t len = pos - h->m_pos;
+		int n = zstd_read(r, buf, len < (int64_t)sizeof(buf) ? (uint32_t)len : sizeof(buf));
+		if(n < 0) {
+			return -1;
+		}
+		if(n == 0) {
+			return zstd_fail(h, EINVAL, NULL);
+		}
+	}
+	return h->m_pos;
+}
+
+static const char* zstd_error(scap_reader_t* r, int* errnum) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	*errnum = h->m_errnum;
+	if(h->m_zstd_error != NULL) {
+		return h->m_zstd_error;
+	}
+	return h->m_errnum != 0 ? strerror(h->m_errnum) : "";
+}
+
+static int zstd_close(scap_reader_t* r) {
+	ASSERT(r != NULL);
+	reader_handle_t* h = (reader_handle_t*)r->handle;
+	int res = close(h->m_fd);
+	ZSTD_freeDCtx(h->m_dctx);
+	free(h->m_in);
+	free(h);
+	free(r);
+	return res;
+}
+
+scap_reader_t* scap_reader_open_zstd(int fd) {
+	if(fd < 0) {
+		return NULL;
+	}
+
+	reader_handle_t* h = (reader_handle_t*)calloc(1, sizeof(reader_handle_t));
+	scap_reader_t* r = (scap_reader_t*)malloc(sizeof(scap_reader_t));
+	if(h == NULL || r == NULL) {
+		free(h);
+		free(r);
+		return NULL;
+	}
+	h->m_in_size = ZSTD_DStreamInSize();
+	h->m_in = (uint8_t*)malloc(h->m_in_size);
+	h->m_dctx = ZSTD_createDCtx();
+	if(h->m_in == NULL || h->m_dctx == NULL) {
+		ZSTD_freeDCtx(h->m_dctx);
+		free(h->m_in);
+		free(h);
+		free(r);
+		return NULL;
+	}
+	h->m_fd = fd;
+	off_t start = lseek(fd, 0, SEEK_CUR);
+	h->m_start = start > 0 ? start : 0;
+	h->m_raw_pos = h->m_start;
+
+	r->handle = h;
+	r->read = &zstd_read;
+	r->read_ptr = NULL;
+	r->offset = &zstd_offset;
+	r->tell = &zstd_tell;
+	r->seek = &zstd_seek;
+	r->error = &zstd_error;
+	r->close = &zstd_close;
+	return r;
+}
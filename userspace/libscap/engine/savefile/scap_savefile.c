@@ -16,11 +16,14 @@ limitations under the License.
 
 */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <sys/uio.h>
 #else
 struct iovec {
@@ -1931,6 +1934,20 @@ static int32_t next_event_from_file(struct savefile_engine *handle,
 			}
 		}
 
+		if(bh.block_type == IDX_BLOCK_TYPE) {
+			//
+			// The index follows the events of the section, skip it
+			//
+			if(bh.block_total_length < sizeof(bh) ||
+			   r->seek(r, bh.block_total_length - sizeof(bh), SEEK_CUR) == -1) {
+				return scap_errprintf(handle->m_lasterr,
+				                      0,
+				                      "corrupted input file. Can't skip index block of size %u.",
+				                      (uint32_t)bh.block_total_length);
+			}
+			continue;
+		}
+
 		if(bh.block_type != EV_BLOCK_TYPE && bh.block_type != EV_BLOCK_TYPE_V2 &&
 		   bh.block_type != EV_BLOCK_TYPE_V2_LARGE && bh.block_type != EV_BLOCK_TYPE_INT &&
 		   bh.block_type != EVF_BLOCK_TYPE && bh.block_type != EVF_BLOCK_TYPE_V2 &&
@@ -1972,44 +1989,58 @@ static int32_t next_event_from_file(struct savefile_engine *handle,
 				        readlen,
 				        READER_BUF_SIZE);
 			}
-		} else if(readlen > handle->m_reader_evt_buf_size) {
-			// Try to allocate a buffer large enough
-			char *tmp = realloc(handle->m_reader_evt_buf, readlen);
-			if(!tmp) {
-				free(handle->m_reader_evt_buf);
-				handle->m_reader_evt_buf = NULL;
-				return scap_errprintf(handle->m_lasterr,
-				                      0,
-				                      "event block length %u greater than read buffer size %zu",
-				                      readlen,
-				                      handle->m_reader_evt_buf_size);
-			}
-			handle->m_reader_evt_buf = tmp;
-			handle->m_reader_evt_buf_size = readlen;
 		}
 
-		readsize = r->read(r, handle->m_reader_evt_buf, readlen);
-		CHECK_READ_SIZE(readsize, readlen);
+		//
+		// V2 blocks are not modified below, so when the reader can hand out its
+		// data in place (i.e. a memory-mapped file) they are used without copies
+		//
+		char *evt_buf = NULL;
+		if(r->read_ptr != NULL && hdr_len == sizeof(struct ppm_evt_hdr)) {
+			evt_buf = (char *)r->read_ptr(r, readlen);
+		}
+		handle->m_evt_in_place = evt_buf != NULL;
+
+		if(evt_buf == NULL) {
+			if(readlen > handle->m_reader_evt_buf_size) {
+				// Try to allocate a buffer large enough
+				char *tmp = realloc(handle->m_reader_evt_buf, readlen);
+				if(!tmp) {
+					free(handle->m_reader_evt_buf);
+					handle->m_reader_evt_buf = NULL;
+					return scap_errprintf(handle->m_lasterr,
+					                      0,
+					                      "event block length %u greater than read buffer size %zu",
+					                      readlen,
+					                      handle->m_reader_evt_buf_size);
+				}
+				handle->m_reader_evt_buf = tmp;
+				handle->m_reader_evt_buf_size = readlen;
+			}
+
+			readsize = r->read(r, handle->m_reader_evt_buf, readlen);
+			CHECK_READ_SIZE(readsize, readlen);
+			evt_buf = handle->m_reader_evt_buf;
+		}
 
 		//
 		// EVF_BLOCK_TYPE has 32 bits of flags
 		//
-		*pdevid = *(uint16_t *)handle->m_reader_evt_buf;
+		*pdevid = *(uint16_t *)evt_buf;
 
 		if(bh.block_type == EVF_BLOCK_TYPE || bh.block_type == EVF_BLOCK_TYPE_V2 ||
 		   bh.block_type == EVF_BLOCK_TYPE_V2_LARGE) {
-			memcpy(pflags, handle->m_reader_evt_buf + sizeof(uint16_t), sizeof(uint32_t));
-			*pevent = (struct ppm_evt_hdr *)(handle->m_reader_evt_buf + sizeof(uint16_t) +
-			                                 sizeof(uint32_t));
+			memcpy(pflags, evt_buf + sizeof(uint16_t), sizeof(uint32_t));
+			*pevent = (struct ppm_evt_hdr *)(evt_buf + sizeof(uint16_t) + sizeof(uint32_t));
 		} else {
 			*pflags = 0;
-			*pevent = (struct ppm_evt_hdr *)(handle->m_reader_evt_buf + sizeof(uint16_t));
+			*pevent = (struct ppm_evt_hdr *)(evt_buf + sizeof(uint16_t));
 		}
 
 		// Number of block-body bytes that follow *pevent in the reader buffer, excluding the
 		// trailing block_total_length. Compute it with a guarded subtraction: readlen and evt_off
 		// both derive from the attacker-controlled block length, so avoid unsigned underflow.
-		uint32_t evt_off = (uint32_t)((char *)*pevent - handle->m_reader_evt_buf);
+		uint32_t evt_off = (uint32_t)((char *)*pevent - evt_buf);
 		uint32_t avail = evt_off <= block_body_len ? block_body_len - evt_off : 0;
 		if(avail < hdr_len) {
 			return scap_errprintf(
@@ -2049,7 +2080,7 @@ static int32_t next_event_from_file(struct savefile_engine *handle,
 
 			memmove((char *)*pevent + sizeof(struct ppm_evt_hdr),
 			        (char *)*pevent + sizeof(struct ppm_evt_hdr) - sizeof(uint32_t),
-			        readlen - ((char *)*pevent - handle->m_reader_evt_buf) -
+			        readlen - ((char *)*pevent - evt_buf) -
 			                (sizeof(struct ppm_evt_hdr) - sizeof(uint32_t)));
 			(*pevent)->len += sizeof(uint32_t);
 
@@ -2132,11 +2163,16 @@ static int32_t next(struct scap_engine_handle engine,
                     uint16_t *pdevid,
                     uint32_t *pflags) {
 	struct savefile_engine *handle = engine.m_handle;
-	int32_t res = next_event_from_file(handle, pevent, pdevid, pflags);
+	int32_t res;
+	// After a seek by timestamp, the chunk may start with earlier events
+	do {
+		res = next_event_from_file(handle, pevent, pdevid, pflags);
+	} while(res == SCAP_SUCCESS && (*pevent)->ts < handle->m_seek_ts);
 	// If we fail we don't convert the event.
 	if(res != SCAP_SUCCESS) {
 		return res;
 	}
+	handle->m_seek_ts = 0;
 
 	conversion_result conv_res = test_event_convertibility(*pevent, handle->m_lasterr);
 	switch(conv_res) {
@@ -2264,14 +2300,243 @@ static int32_t next(struct scap_engine_handle engine,
 	}
 }
 
+#define BATCH_BUF_SIZE (1024 * 1024)
+
+//
+// Read a batch of events from disk. The events read in place stay valid until
+// the reader is closed, the others are overwritten by the following read, so
+// they are copied to the batch buffer, except the last one of the batch
+//
+static int32_t next_batch(struct scap_engine_handle engine,
+                          scap_evt **pevents,
+                          uint16_t *pdevids,
+                          uint32_t *pflags,
+                          uint32_t max_events,
+                          uint32_t *pnevents) {
+	struct savefile_engine *handle = engine.m_handle;
+	size_t used = 0;
+	uint32_t n = 0;
+	int32_t res = SCAP_SUCCESS;
+
+	while(n < max_events) {
+		scap_evt *evt;
+		res = next(engine, &evt, &pdevids[n], &pflags[n]);
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+
+		pevents[n++] = evt;
+		if(handle->m_evt_in_place && evt != (scap_evt *)handle->m_new_evt) {
+			continue;
+		}
+
+		if(handle->m_batch_buf == NULL) {
+			handle->m_batch_buf = malloc(BATCH_BUF_SIZE);
+		}
+		if(n == max_events || handle->m_batch_buf == NULL || used + evt->len > BATCH_BUF_SIZE) {
+			break;
+		}
+		memcpy(handle->m_batch_buf + used, evt, evt->len);
+		pevents[n - 1] = (scap_evt *)(handle->m_batch_buf + used);
+		used += evt->len;
+	}
+
+	*pnevents = n;
+	return res;
+}
+
+#ifndef _WIN32
+//
+// The compression of the data at the given offset of fd, from its magic number
+//
+static compression_mode read_compression(int fd, off_t offset) {
+	uint8_t magic[4];
+	ssize_t len = pread(fd, magic, sizeof(magic), offset);
+
+	// gzip streams start with 0x1f 0x8b, zstd frames with 0x28 0xb5 0x2f 0xfd
+	if(len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+		return SCAP_COMPRESSION_GZIP;
+	}
+	if(len == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+		return SCAP_COMPRESSION_ZSTD;
+	}
+	return SCAP_COMPRESSION_NONE;
+}
+
+//
+// Read the compressed capture from the gzip stream or zstd frame at raw_offset,
+// that holds the uncompressed data starting at offset
+//
+static int32_t reopen_compressed(struct savefile_engine *handle,
+                                 compression_mode compression,
+                                 int64_t raw_offset,
+                                 uint64_t offset) {
+	int fd = handle->m_fname != NULL ? open(handle->m_fname, O_RDONLY | O_CLOEXEC)
+	                                 : dup(handle->m_fd);
+	if(fd < 0) {
+		return scap_errprintf(handle->m_lasterr, errno, "can't reopen the capture");
+	}
+	if(lseek(fd, raw_offset, SEEK_SET) < 0) {
+		close(fd);
+		return scap_errprintf(handle->m_lasterr, errno, "can't reopen the capture");
+	}
+
+	scap_reader_t *reader = NULL;
+#ifdef USE_ZSTD
+	if(compression == SCAP_COMPRESSION_ZSTD) {
+		reader = scap_reader_open_zstd(fd);
+		if(reader == NULL) {
+			close(fd);
+			return scap_errprintf(handle->m_lasterr, 0, "can't reopen the capture");
+		}
+	}
+#endif
+	if(reader == NULL) {
+		gzFile gzfile = gzdopen(fd, "rb");
+		if(gzfile == NULL) {
+			close(fd);
+			return scap_errprintf(handle->m_lasterr, 0, "can't reopen the capture");
+		}
+		reader = scap_reader_open_gzfile(gzfile);
+		if(reader == NULL) {
+			gzclose(gzfile);
+			return scap_errprintf(handle->m_lasterr, 0, "can't reopen the capture");
+		}
+	}
+	if(handle->m_fbuffer_size > 0) {
+		scap_reader_t *buffered_reader =
+		        scap_reader_open_buffered(reader, handle->m_fbuffer_size, true);
+		if(buffered_reader == NULL) {
+			reader->close(reader);
+			return scap_errprintf(handle->m_lasterr, 0, "can't reopen the capture");
+		}
+		reader = buffered_reader;
+	}
+
+	handle->m_reader->close(handle->m_reader);
+	handle->m_reader = reader;
+	handle->m_fd = fd;
+	handle->m_tell_base = offset;
+	handle->m_use_last_block_header = false;
+	return SCAP_SUCCESS;
+}
+#endif
+
 uint64_t scap_savefile_ftell(struct scap_engine_handle engine) {
 	scap_reader_t *reader = HANDLE(engine)->m_reader;
-	return reader->tell(reader);
+	return HANDLE(engine)->m_tell_base + reader->tell(reader);
 }
 
 void scap_savefile_fseek(struct scap_engine_handle engine, uint64_t off) {
-	scap_reader_t *reader = HANDLE(engine)->m_reader;
-	reader->seek(reader, off, SEEK_SET);
+	struct savefile_engine *handle = HANDLE(engine);
+#ifndef _WIN32
+	// The reader starts after a seek by timestamp, go back to the first one
+	if(off < handle->m_tell_base &&
+	   reopen_compressed(handle, handle->m_index_compression, handle->m_raw_start, 0) !=
+	           SCAP_SUCCESS) {
+		return;
+	}
+#endif
+	scap_reader_t *reader = handle->m_reader;
+	reader->seek(reader, off - handle->m_tell_base, SEEK_SET);
+	handle->m_seek_ts = 0;
+}
+
+#ifndef _WIN32
+//
+// Load the index block at the end of the file, if any
+//
+static int32_t load_index(struct savefile_engine *handle) {
+	int fd = handle->m_fname != NULL ? open(handle->m_fname, O_RDONLY | O_CLOEXEC)
+	                                 : dup(handle->m_fd);
+	if(fd < 0) {
+		return scap_errprintf(handle->m_lasterr, errno, "can't read the index of the capture");
+	}
+
+	// The offset of the fd is shared with the reader, only use pread() from here
+	struct stat st;
+	block_header bh;
+	uint32_t bt = 0;
+	uint32_t entry_len = 0;
+	if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(bt) ||
+	   pread(fd, &bt, sizeof(bt), st.st_size - sizeof(bt)) != sizeof(bt) ||
+	   bt < sizeof(bh) + sizeof(entry_len) + sizeof(bt) || bt > st.st_size ||
+	   pread(fd, &bh, sizeof(bh), st.st_size - bt) != sizeof(bh) ||
+	   bh.block_type != IDX_BLOCK_TYPE || bh.block_total_length != bt ||
+	   pread(fd, &entry_len, sizeof(entry_len), st.st_size - bt + sizeof(bh)) !=
+	           sizeof(entry_len)) {
+		close(fd);
+		return scap_errprintf(handle->m_lasterr, 0, "the capture has no index");
+	}
+
+	// New fields are appended to the entries, only read the known ones
+	uint32_t body_len = bt - sizeof(bh) - sizeof(entry_len) - sizeof(bt);
+	if(entry_len < sizeof(index_block_entry) || body_len % entry_len != 0 || body_len == 0) {
+		close(fd);
+		return scap_errprintf(handle->m_lasterr, 0, "invalid index entry size %u", entry_len);
+	}
+
+	uint32_t nentries = body_len / entry_len;
+	char *body = malloc(body_len);
+	index_block_entry *entries = malloc(nentries * sizeof(index_block_entry));
+	if(body == NULL || entries == NULL ||
+	   pread(fd, body, body_len, st.st_size - bt + sizeof(bh) + sizeof(entry_len)) != body_len) {
+		free(body);
+		free(entries);
+		close(fd);
+		return scap_errprintf(handle->m_lasterr, 0, "can't read the index of the capture");
+	}
+	for(uint32_t j = 0; j < nentries; j++) {
+		memcpy(&entries[j], body + j * entry_len, sizeof(index_block_entry));
+	}
+	free(body);
+
+	compression_mode compression = read_compression(fd, entries[0].raw_offset);
+	close(fd);
+
+	handle->m_index = entries;
+	handle->m_index_size = nentries;
+	handle->m_index_compression = compression;
+	return SCAP_SUCCESS;
+}
+#endif
+
+static int32_t scap_savefile_seek_timestamp(struct scap_engine_handle engine, uint64_t ts) {
+	struct savefile_engine *handle = HANDLE(engine);
+#ifndef _WIN32
+	int32_t res;
+	if(handle->m_index == NULL && (res = load_index(handle)) != SCAP_SUCCESS) {
+		return res;
+	}
+
+	// The timestamps of consecutive chunks can overlap, since the events aren't
+	// strictly sorted: start from the first chunk that reaches ts
+	uint32_t j = 0;
+	while(j + 1 < handle->m_index_size && handle->m_index[j].max_ts < ts) {
+		j++;
+	}
+	const index_block_entry *chunk = &handle->m_index[j];
+
+	if(handle->m_index_compression != SCAP_COMPRESSION_NONE) {
+		res = reopen_compressed(handle,
+		                        handle->m_index_compression,
+		                        chunk->raw_offset,
+		                        chunk->offset);
+		if(res != SCAP_SUCCESS) {
+			return res;
+		}
+	} else if(handle->m_reader->seek(handle->m_reader,
+	                                 chunk->offset - handle->m_tell_base,
+	                                 SEEK_SET) == -1) {
+		return scap_errprintf(handle->m_lasterr, 0, "can't seek to the chunk of the index");
+	}
+
+	handle->m_use_last_block_header = false;
+	handle->m_seek_ts = ts;
+	return SCAP_SUCCESS;
+#else
+	return scap_errprintf(handle->m_lasterr, 0, "seeking by timestamp is not supported");
+#endif
 }
 
 static int32_t scap_savefile_init_platform(struct scap_platform *platform,
@@ -2326,6 +2591,72 @@ static void *alloc_handle(struct scap *main_handle, char *lasterr_ptr) {
 	return engine;
 }
 
+#ifndef _WIN32
+//
+// Map the capture file in memory if it's not compressed, otherwise return NULL
+// to read it with zlib. As with gzdopen(), a given fd is owned by the reader,
+// but only if the mapping succeeds.
+//
+static scap_reader_t *open_mmap_reader(int fd, const char *fname) {
+	bool own_fd = fd == 0;
+	if(own_fd) {
+		fd = open(fname, O_RDONLY | O_CLOEXEC);
+		if(fd < 0) {
+			return NULL;
+		}
+	}
+
+	scap_reader_t *r = NULL;
+	off_t pos = lseek(fd, 0, SEEK_CUR);
+	if(pos >= 0 && read_compression(fd, pos) == SCAP_COMPRESSION_NONE) {
+		r = scap_reader_open_mmap(fd, true);
+	}
+
+	if(r == NULL && own_fd) {
+		close(fd);
+	}
+	return r;
+}
+#endif
+
+#ifdef USE_ZSTD
+//
+// Open a zstd reader if the capture is zstd compressed, otherwise return NULL
+// to read it with zlib. The fd is owned as in open_mmap_reader().
+//
+static scap_reader_t *open_zstd_reader(int fd, const char *fname, uint32_t fbuffer_size) {
+	bool own_fd = fd == 0;
+	if(own_fd) {
+		fd = open(fname, O_RDONLY | O_CLOEXEC);
+		if(fd < 0) {
+			return NULL;
+		}
+	}
+
+	scap_reader_t *r = NULL;
+	off_t pos = lseek(fd, 0, SEEK_CUR);
+	if(pos >= 0 && read_compression(fd, pos) == SCAP_COMPRESSION_ZSTD) {
+		r = scap_reader_open_zstd(fd);
+	}
+	if(r == NULL) {
+		if(own_fd) {
+			close(fd);
+		}
+		return NULL;
+	}
+
+	if(fbuffer_size > 0) {
+		scap_reader_t *buffered_reader = scap_reader_open_buffered(r, fbuffer_size, true);
+		if(buffered_reader == NULL) {
+			r->close(r);
+			return NULL;
+		}
+		r = buffered_reader;
+	}
+	return r;
+}
+#endif
+
 static int32_t init(struct scap *main_handle, struct scap_open_args *oargs) {
 	gzFile gzfile;
 	int res;
@@ -2339,32 +2670,56 @@ static int32_t init(struct scap *main_handle, struct scap_open_args *oargs) {
 	struct scap_platform *platform = params->platform;
 	handle->m_platform = params->platform;
 
-	if(fd != 0) {
-		gzfile = gzdopen(fd, "rb");
-	} else {
-		gzfile = gzopen(fname, "rb");
+	handle->m_fd = fd;
+	handle->m_fbuffer_size = fbuffer_size;
+	if(fd == 0) {
+		handle->m_fname = strdup(fname);
+		if(handle->m_fname == NULL) {
+			return scap_errprintf(main_handle->m_lasterr, 0, "error allocating the file name");
+		}
+	}
+
+	scap_reader_t *reader = NULL;
+#ifndef _WIN32
+	handle->m_raw_start = fd != 0 ? lseek(fd, 0, SEEK_CUR) : 0;
+	if(params->use_mmap) {
+		reader = open_mmap_reader(fd, fname);
 	}
+#endif
+#ifdef USE_ZSTD
+	if(reader == NULL) {
+		reader = open_zstd_reader(fd, fname, fbuffer_size);
+	}
+#endif
 
-	if(gzfile == NULL) {
+	if(reader == NULL) {
 		if(fd != 0) {
-			return scap_errprintf(main_handle->m_lasterr, 0, "can't open fd %d", fd);
+			gzfile = gzdopen(fd, "rb");
+		} else {
+			gzfile = gzopen(fname, "rb");
 		}
-		return scap_errprintf(main_handle->m_lasterr, 0, "can't open file %s", fname);
-	}
 
-	scap_reader_t *reader = scap_reader_open_gzfile(gzfile);
-	if(!reader) {
-		gzclose(gzfile);
-		return SCAP_FAILURE;
-	}
+		if(gzfile == NULL) {
+			if(fd != 0) {
+				return scap_errprintf(main_handle->m_lasterr, 0, "can't open fd %d", fd);
+			}
+			return scap_errprintf(main_handle->m_lasterr, 0, "can't open file %s", fname);
+		}
 
-	if(fbuffer_size > 0) {
-		scap_reader_t *buffered_reader = scap_reader_open_buffered(reader, fbuffer_size, true);
-		if(!buffered_reader) {
-			reader->close(reader);
+		reader = scap_reader_open_gzfile(gzfile);
+		if(!reader) {
+			gzclose(gzfile);
 			return SCAP_FAILURE;
 		}
-		reader = buffered_reader;
+
+		if(fbuffer_size > 0) {
+			scap_reader_t *buffered_reader = scap_reader_open_buffered(reader, fbuffer_size, true);
+			if(!buffered_reader) {
+				reader->close(reader);
+				return SCAP_FAILURE;
+			}
+			reader = buffered_reader;
+		}
 	}
 
 	//
@@ -2427,6 +2782,21 @@ static int32_t scap_savefile_close(struct scap_engine_handle engine) {
 		handle->m_reader_evt_buf = NULL;
 	}
 
+	if(handle->m_batch_buf) {
+		free(handle->m_batch_buf);
+		handle->m_batch_buf = NULL;
+	}
+
+	if(handle->m_fname) {
+		free(handle->m_fname);
+		handle->m_fname = NULL;
+	}
+
+	if(handle->m_index) {
+		free(handle->m_index);
+		handle->m_index = NULL;
+	}
+
 	if(handle->m_new_evt) {
 		free(handle->m_new_evt);
 		handle->m_new_evt = NULL;
@@ -2473,6 +2843,7 @@ static int64_t get_readfile_offset(struct scap_engine_handle engine) {
 static struct scap_savefile_vtable savefile_ops = {
         .ftell_capture = scap_savefile_ftell,
         .fseek_capture = scap_savefile_fseek,
+        .seek_timestamp = scap_savefile_seek_timestamp,
 
         .restart_capture = scap_savefile_restart_capture,
         .get_readfile_offset = get_readfile_offset,
@@ -2487,6 +2858,7 @@ struct scap_vtable scap_savefile_engine = {
         .free_handle = free_handle,
         .close = scap_savefile_close,
         .next = next,
+        .next_batch = next_batch,
         .start_capture = noop_start_capture,
         .stop_capture = noop_stop_capture,
         .configure = noop_configure,
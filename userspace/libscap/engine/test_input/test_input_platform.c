@@ -82,8 +82,34 @@ static bool scap_test_input_is_thread_alive(struct scap_platform* platform,
 	return false;
 }
 
+// Serve the threads of the test input data as if they were read again from /proc.
+static int32_t scap_test_input_fetch_proc(struct scap_platform* platform,
+                                          struct scap_proclist* proclist,
+                                          int64_t tid,
+                                          bool scan_sockets,
+                                          char* error) {
+	struct scap_test_input_platform* test_input_platform =
+	        (struct scap_test_input_platform*)platform;
+	scap_test_input_data* data = test_input_platform->m_data;
+	size_t i;
+
+	for(i = 0; i < data->thread_count; i++) {
+		if(data->threads[i].tid == tid) {
+			return scap_proc_scan_vtable(error,
+			                             proclist,
+			                             1,
+			                             &data->threads[i],
+			                             test_input_platform,
+			                             get_fdinfos);
+		}
+	}
+
+	return scap_errprintf(error, 0, "Could not find thread info for tid %ld", tid);
+}
+
 static const struct scap_platform_vtable scap_test_input_platform = {
         .init_platform = scap_test_input_init_platform,
+        .fetch_proc = scap_test_input_fetch_proc,
         .free_platform = scap_test_input_free_platform,
         .is_thread_alive = scap_test_input_is_thread_alive,
 };
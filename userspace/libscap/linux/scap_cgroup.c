@@ -26,6 +26,7 @@ limitations under the License.
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <mntent.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -448,10 +449,14 @@ static int32_t get_cgroup_subsystems_v2(struct scap_cgroup_interface* cgi,
                                         const char* cgroup_mount) {
 	if(cgi->m_use_cache) {
 		struct scap_cgroup_cache* cached;
+		pthread_mutex_lock(&cgi->m_cache_mtx);
 		HASH_FIND_STR(cgi->m_cache, cgroup_mount, cached);
-
 		if(cached != NULL) {
 			*subsystems = cached->subsystems;
+		}
+		pthread_mutex_unlock(&cgi->m_cache_mtx);
+
+		if(cached != NULL) {
 			return SCAP_SUCCESS;
 		}
 	}
@@ -503,8 +508,15 @@ static int32_t get_cgroup_subsystems_v2(struct scap_cgroup_interface* cgi,
 			snprintf(cached->path, sizeof(cached->path), "%s", cgroup_mount);
 			memcpy(&cached->subsystems, subsystems, sizeof(cached->subsystems));
 
-			HASH_ADD_STR(cgi->m_cache, path, cached);
-			if(uth_status != SCAP_SUCCESS) {
+			// Threads of a parallel /proc scan may have added the same path meanwhile.
+			struct scap_cgroup_cache* existing;
+			pthread_mutex_lock(&cgi->m_cache_mtx);
+			HASH_FIND_STR(cgi->m_cache, cached->path, existing);
+			if(existing == NULL) {
+				HASH_ADD_STR(cgi->m_cache, path, cached);
+			}
+			pthread_mutex_unlock(&cgi->m_cache_mtx);
+			if(existing != NULL || uth_status != SCAP_SUCCESS) {
 				free(cached);
 			}
 		}
@@ -604,6 +616,7 @@ int32_t scap_cgroup_interface_init(struct scap_cgroup_interface* cgi,
 
 	cgi->m_use_cache = true;
 	cgi->m_cache = NULL;
+	pthread_mutex_init(&cgi->m_cache_mtx, NULL);
 	cgi->m_subsystems_v1.len = 0;
 	cgi->m_subsystems_v2.len = 0;
 	cgi->m_mounts_v1.len = 0;
@@ -837,28 +850,78 @@ static int32_t scap_cgroup_resolve_v2(struct scap_cgroup_interface* cgi,
 	return SCAP_SUCCESS;
 }
 
-// Get all cgroups (v1 and v2) for a thread whose /proc directory is `procdirname`
+// Buffered reader of a cgroup file, returning its lines as fgets() does without the allocations of
+// a FILE stream.
+struct cgroup_file_reader {
+	int fd;
+	size_t start;  // start of the data not returned yet in `buff`
+	size_t end;    // end of the data read in `buff`
+	char buff[4096];
+};
+
+// Copy the next line of the file, with its trailing '\n', into `line`. As fgets(), lines longer
+// than `line_len - 1` are returned in pieces. Return NULL at the end of the file.
+static char* cgroup_file_gets(struct cgroup_file_reader* f, char* line, size_t line_len) {
+	size_t len = 0;
+	while(len + 1 < line_len) {
+		if(f->start == f->end) {
+			const ssize_t read_bytes = read(f->fd, f->buff, sizeof(f->buff));
+			if(read_bytes < 0 && errno == EINTR) {
+				continue;
+			}
+			if(read_bytes <= 0) {
+				break;
+			}
+			f->start = 0;
+			f->end = read_bytes;
+		}
+
+		size_t avail = f->end - f->start;
+		if(avail > line_len - 1 - len) {
+			avail = line_len - 1 - len;
+		}
+		const char* newline = (const char*)memchr(f->buff + f->start, '\n', avail);
+		const size_t copy_len = newline ? (size_t)(newline - (f->buff + f->start)) + 1 : avail;
+		memcpy(line + len, f->buff + f->start, copy_len);
+		len += copy_len;
+		f->start += copy_len;
+		if(newline) {
+			break;
+		}
+	}
+
+	if(len == 0) {
+		return NULL;
+	}
+	line[len] = '\0';
+	return line;
+}
+
+// Get all cgroups (v1 and v2) for a thread whose /proc directory is `procdirname`, opened as
+// `procdirfd`
 int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
+                               const int procdirfd,
                                const char* procdirname,
                                struct scap_cgroup_set* cg,
                                char* error) {
-	char filename[SCAP_MAX_PATH_SIZE];
 	char line[SCAP_MAX_CGROUPS_SIZE];
 
 	cg->len = 0;
-	snprintf(filename, sizeof(filename), "%scgroup", procdirname);
 
-	FILE* f = fopen(filename, "r");
-	if(f == NULL) {
+	struct cgroup_file_reader f;
+	f.fd = openat(procdirfd, "cgroup", O_RDONLY, 0);
+	f.start = 0;
+	f.end = 0;
+	if(f.fd == -1) {
 		if(errno == ENOENT || errno == EACCES) {
 			return SCAP_SUCCESS;
 		}
 
 		ASSERT(false);
-		return scap_errprintf(error, errno, "open cgroup file %s failed", filename);
+		return scap_errprintf(error, errno, "open cgroup file %scgroup failed", procdirname);
 	}
 
-	while(fgets(line, sizeof(line), f) != NULL) {
+	while(cgroup_file_gets(&f, line, sizeof(line)) != NULL) {
 		char* token;
 		char* subsys_list;
 		char* cgroup;
@@ -868,16 +931,19 @@ int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
 		token = strtok_r(line, ":", &scratch);
 		if(token == NULL) {
 			ASSERT(false);
-			fclose(f);
-			return scap_errprintf(error, 0, "Did not find id in cgroup file %s", filename);
+			close(f.fd);
+			return scap_errprintf(error, 0, "Did not find id in cgroup file %scgroup", procdirname);
 		}
 
 		// subsys
 		subsys_list = strtok_r(NULL, ":", &scratch);
 		if(subsys_list == NULL) {
 			ASSERT(false);
-			fclose(f);
-			return scap_errprintf(error, 0, "Did not find subsys in cgroup file %s", filename);
+			close(f.fd);
+			return scap_errprintf(error,
+			                      0,
+			                      "Did not find subsys in cgroup file %scgroup",
+			                      procdirname);
 		}
 
 		// Hack to detect empty fields, because strtok does not support it
@@ -918,7 +984,7 @@ int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
 				}
 
 				if(scap_cgroup_resolve_v2(cgi, cgroup, cg) != SCAP_SUCCESS) {
-					fclose(f);
+					close(f.fd);
 					return scap_errprintf(error, 0, "Cannot resolve v2 cgroups");
 				}
 				continue;
@@ -932,8 +998,11 @@ int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
 			cgroup = strtok_r(NULL, "\n", &scratch);
 			if(cgroup == NULL) {
 				ASSERT(false);
-				fclose(f);
-				return scap_errprintf(error, 0, "Did not find cgroup in cgroup file %s", filename);
+				close(f.fd);
+				return scap_errprintf(error,
+				                      0,
+				                      "Did not find cgroup in cgroup file %scgroup",
+				                      procdirname);
 			}
 		}
 
@@ -955,7 +1024,7 @@ int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
 				if(scap_cgroup_prefix_path(self_path, cgroup, &prefix_len, &suffix_skip_len) !=
 				   SCAP_SUCCESS) {
 					ASSERT(false);
-					fclose(f);
+					close(f.fd);
 					return SCAP_SUCCESS;
 				}
 				ret = scap_cgroup_printf(cg,
@@ -970,13 +1039,13 @@ int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
 
 			if(ret == SCAP_FAILURE) {
 				ASSERT(false);
-				fclose(f);
+				close(f.fd);
 				return SCAP_SUCCESS;
 			}
 		}
 	}
 
-	fclose(f);
+	close(f.fd);
 	return SCAP_SUCCESS;
 }
 
@@ -1007,6 +1076,8 @@ const char* scap_cgroup_get_subsys_mount(const struct scap_cgroup_interface* cgi
 }
 
 void scap_cgroup_clear_cache(struct scap_cgroup_interface* cgi) {
+	// single threads can be fetched in the background while the capture refreshes the table
+	pthread_mutex_lock(&cgi->m_cache_mtx);
 	cgi->m_use_cache = false;
 
 	if(cgi->m_cache) {
@@ -1019,6 +1090,7 @@ void scap_cgroup_clear_cache(struct scap_cgroup_interface* cgi) {
 
 		cgi->m_cache = NULL;
 	}
+	pthread_mutex_unlock(&cgi->m_cache_mtx);
 }
 
 void scap_cgroup_enable_cache(struct scap_cgroup_interface* cgi) {
@@ -18,6 +18,7 @@ limitations under the License.
 
 #pragma once
 
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -45,6 +46,7 @@ struct scap_cgroup_interface {
 
 	bool m_use_cache;
 	struct scap_cgroup_cache* m_cache;
+	pthread_mutex_t m_cache_mtx;  // the cache is shared by the threads of a parallel /proc scan
 
 	// the cgroups of the current process, as seen from the host cgroupns
 	// empty if:
@@ -65,6 +67,7 @@ int32_t scap_cgroup_interface_init(struct scap_cgroup_interface* cgi,
                                    bool with_self_cg);
 
 int32_t scap_cgroup_get_thread(struct scap_cgroup_interface* cgi,
+                               const int procdirfd,
                                const char* procdirname,
                                struct scap_cgroup_set* cg,
                                char* error);
@@ -1288,14 +1288,16 @@ int32_t scap_fd_scan_fd_dir(struct scap_linux_platform *linux_platform,
 		net_ns = sb.st_ino;
 	}
 
+	// The fds are looked up relative to the directory, so that its path is only resolved once.
+	const int fd_dir_fd = dirfd(dir_p);
 	while((dir_entry_p = readdir(dir_p)) != NULL &&
 	      (linux_platform->m_fd_lookup_limit == 0 ||
 	       fd_added < linux_platform->m_fd_lookup_limit)) {
-		snprintf(f_name, sizeof(f_name), "%s/%s", fd_dir_name, dir_entry_p->d_name);
-
-		if(-1 == stat(f_name, &sb) || 1 != sscanf(dir_entry_p->d_name, "%" PRIu64, &fd)) {
+		if(-1 == fstatat(fd_dir_fd, dir_entry_p->d_name, &sb, 0) ||
+		   1 != sscanf(dir_entry_p->d_name, "%" PRIu64, &fd)) {
 			continue;
 		}
+		snprintf(f_name, sizeof(f_name), "%s/%s", fd_dir_name, dir_entry_p->d_name);
 		fdi.fd = fd;
 
 		// In no driver mode to limit cpu usage we just parse sockets
@@ -49,8 +49,18 @@ uint32_t scap_linux_get_device_by_mount_id(struct scap_platform* platform,
                                            int64_t tid,
                                            unsigned long requested_mount_id);
 int32_t scap_linux_proc_get(struct scap_platform* platform, int64_t tid, bool scan_sockets);
+int32_t scap_linux_proc_fetch(struct scap_platform* platform,
+                              struct scap_proclist* proclist,
+                              int64_t tid,
+                              bool scan_sockets,
+                              char* error);
 int32_t scap_linux_refresh_proc_table(struct scap_platform* platform,
                                       struct scap_proclist* proclist);
+// scan all the processes under `procdirname`, with the worker threads configured in the platform
+int32_t scap_linux_scan_proc_dir(struct scap_linux_platform* linux_platform,
+                                 struct scap_proclist* proclist,
+                                 char* procdirname,
+                                 char* error);
 bool scap_linux_is_thread_alive(struct scap_platform* platform,
                                 int64_t pid,
                                 int64_t tid,
@@ -61,6 +61,7 @@ int32_t scap_linux_init_platform(struct scap_platform* platform,
 	linux_platform->m_engine = engine;
 	linux_platform->m_proc_scan_timeout_ms = oargs->proc_scan_timeout_ms;
 	linux_platform->m_proc_scan_log_interval_ms = oargs->proc_scan_log_interval_ms;
+	linux_platform->m_proc_scan_threads = oargs->proc_scan_threads;
 	linux_platform->m_log_fn = oargs->log_fn;
 	linux_platform->m_cgroups.m_log_fn = oargs->log_fn;
 
@@ -111,6 +112,7 @@ static const struct scap_platform_vtable scap_linux_platform_vtable = {
         .refresh_addr_list = scap_linux_create_iflist,
         .get_device_by_mount_id = scap_linux_get_device_by_mount_id,
         .get_proc = scap_linux_proc_get,
+        .fetch_proc = scap_linux_proc_fetch,
         .refresh_proc_table = scap_linux_refresh_proc_table,
         .is_thread_alive = scap_linux_is_thread_alive,
         .get_global_pid = scap_linux_getpid_global,
@@ -34,6 +34,7 @@ limitations under the License.
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fcntl.h>
+#include <pthread.h>
 
 #include <libscap/linux/unixid.h>
 #include <libscap/scap.h>
@@ -289,7 +290,7 @@ static void parse_procfs_proc_pid_status_line(
 }
 
 static int32_t parse_procfs_proc_pid_status_impl(const int fd,
-                                                 const char* const filename,
+                                                 const char* const procfs_proc_dir,
                                                  struct scap_threadinfo* tinfo,
                                                  char* error) {
 	char buff[4096];
@@ -302,7 +303,7 @@ static int32_t parse_procfs_proc_pid_status_impl(const int fd,
 			if(errno == EINTR) {  // Re-attempt upon signal.
 				continue;
 			}
-			return scap_errprintf(error, errno, "can't read status file %s", filename);
+			return scap_errprintf(error, errno, "can't read status file %sstatus", procfs_proc_dir);
 		}
 		if(read_bytes == 0) {  // EOF
 			// We must fetch all pidinfo information.
@@ -335,11 +336,11 @@ static int32_t parse_procfs_proc_pid_status_impl(const int fd,
 				// bug: if we enter the loop, the range [line_start, buff_valid_end] contains '\n',
 				// so it's impossible to end up here.
 				ASSERT(false);
-				return scap_errprintf(
-				        error,
-				        0,
-				        "bug found while parsing status file %s: unexpected line with no newline",
-				        filename);
+				return scap_errprintf(error,
+				                      0,
+				                      "bug found while parsing status file %sstatus: unexpected "
+				                      "line with no newline",
+				                      procfs_proc_dir);
 			}
 
 			const size_t line_len = line_end - line_start;
@@ -386,35 +387,34 @@ static int32_t parse_procfs_proc_pid_status_impl(const int fd,
 	return scap_errprintf(
 	        error,
 	        0,
-	        "bug found while parsing status file %s: control should never reach any statement "
-	        "after the outer while loop in parse_procfs_proc_pid_status_impl()!",
-	        filename);
+	        "bug found while parsing status file %sstatus: control should never reach any "
+	        "statement after the outer while loop in parse_procfs_proc_pid_status_impl()!",
+	        procfs_proc_dir);
 }
 
-static int32_t parse_procfs_proc_pid_status(const char* const procfs_proc_dir,
+static int32_t parse_procfs_proc_pid_status(const int procfs_proc_dirfd,
+                                            const char* const procfs_proc_dir,
                                             struct scap_threadinfo* tinfo,
                                             char* error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%sstatus", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "status", O_RDONLY, 0);
 	if(fd == -1) {
-		return scap_errprintf(error, errno, "can't open status file %s", filename);
+		return scap_errprintf(error, errno, "can't open status file %sstatus", procfs_proc_dir);
 	}
 
-	const int32_t res = parse_procfs_proc_pid_status_impl(fd, filename, tinfo, error);
+	const int32_t res = parse_procfs_proc_pid_status_impl(fd, procfs_proc_dir, tinfo, error);
 	close(fd);
 	return res;
 }
 
 static int32_t parse_procfs_proc_pid_stat_impl(const int fd,
-                                               const char* const filename,
+                                               const char* const procfs_proc_dir,
                                                struct scap_threadinfo* tinfo,
                                                char* error) {
 	char buffer[4096];
 	const ssize_t read_bytes = read_exact(fd, buffer, sizeof(buffer) - 1);
 	if(read_bytes <= 0) {
 		ASSERT(false);
-		return scap_errprintf(error, errno, "can't read stat file %s", filename);
+		return scap_errprintf(error, errno, "can't read stat file %sstat", procfs_proc_dir);
 	}
 	buffer[read_bytes] = '\0';
 
@@ -423,7 +423,10 @@ static int32_t parse_procfs_proc_pid_stat_impl(const int fd,
 	const char* content_to_parse = strrchr(buffer, ')');
 	if(content_to_parse == NULL) {
 		ASSERT(false);
-		return scap_errprintf(error, 0, "can't find closing parenthesis in stat file %s", filename);
+		return scap_errprintf(error,
+		                      0,
+		                      "can't find closing parenthesis in stat file %sstat",
+		                      procfs_proc_dir);
 	}
 	content_to_parse += 2;
 
@@ -442,7 +445,10 @@ static int32_t parse_procfs_proc_pid_stat_impl(const int fd,
 	          &pfmajor   // 10. MajFlt
 	          ) != 5) {
 		ASSERT(false);
-		return scap_errprintf(error, 0, "can't read expected fields from stat file %s", filename);
+		return scap_errprintf(error,
+		                      0,
+		                      "can't read expected fields from stat file %sstat",
+		                      procfs_proc_dir);
 	}
 
 	// Set pgid only if it is not already set (this typically happens because we couldn't extract it
@@ -457,22 +463,22 @@ static int32_t parse_procfs_proc_pid_stat_impl(const int fd,
 	return SCAP_SUCCESS;
 }
 
-static int32_t parse_procfs_proc_pid_stat(const char* const procfs_proc_dir,
+static int32_t parse_procfs_proc_pid_stat(const int procfs_proc_dirfd,
+                                          const char* const procfs_proc_dir,
                                           struct scap_threadinfo* tinfo,
                                           char* error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%sstat", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "stat", O_RDONLY, 0);
 	if(fd == -1) {
-		return scap_errprintf(error, errno, "can't open stat file %s", filename);
+		return scap_errprintf(error, errno, "can't open stat file %sstat", procfs_proc_dir);
 	}
 
-	const int32_t res = parse_procfs_proc_pid_stat_impl(fd, filename, tinfo, error);
+	const int32_t res = parse_procfs_proc_pid_stat_impl(fd, procfs_proc_dir, tinfo, error);
 	close(fd);
 	return res;
 }
 
 int32_t scap_proc_fill_info_from_stats(char* error,
+                                       const int procdirfd,
                                        const char* procdirname,
                                        struct scap_threadinfo* tinfo) {
 	tinfo->uid = (uint32_t)-1;
@@ -488,12 +494,12 @@ int32_t scap_proc_fill_info_from_stats(char* error,
 	tinfo->filtered_out = 0;
 	tinfo->tty = 0;
 
-	const int32_t res = parse_procfs_proc_pid_status(procdirname, tinfo, error);
+	const int32_t res = parse_procfs_proc_pid_status(procdirfd, procdirname, tinfo, error);
 	if(res != SCAP_SUCCESS) {
 		return res;
 	}
 
-	return parse_procfs_proc_pid_stat(procdirname, tinfo, error);
+	return parse_procfs_proc_pid_stat(procdirfd, procdirname, tinfo, error);
 }
 
 //
@@ -524,15 +530,13 @@ static int32_t scap_proc_fill_flimit(uint64_t tid, struct scap_threadinfo* tinfo
 
 int32_t scap_proc_fill_pidns_start_ts(char* error,
                                       struct scap_threadinfo* tinfo,
-                                      const char* procdirname) {
-	char proc_cmdline_pidns[SCAP_MAX_PATH_SIZE];
+                                      const int procdirfd) {
 	struct stat targetstat = {0};
 
 	// Note: with this implementation, the "container start time" for host
 	// processes will not be equal to the boot time but to the time when the
 	// host init started.
-	snprintf(proc_cmdline_pidns, sizeof(proc_cmdline_pidns), "%sroot/proc/1/cmdline", procdirname);
-	if(stat(proc_cmdline_pidns, &targetstat) == 0) {
+	if(fstatat(procdirfd, "root/proc/1/cmdline", &targetstat, 0) == 0) {
 		tinfo->pidns_init_start_ts =
 		        targetstat.st_ctim.tv_sec * SECOND_TO_NS + targetstat.st_ctim.tv_nsec;
 		return SCAP_SUCCESS;
@@ -560,12 +564,11 @@ static int32_t scap_get_vpid(struct scap_linux_platform* platform, int64_t pid,
 	return SCAP_FAILURE;
 }
 
-int32_t parse_procfs_proc_pid_loginuid(const char* const procfs_proc_dir,
+int32_t parse_procfs_proc_pid_loginuid(const int procfs_proc_dirfd,
+                                       const char* const procfs_proc_dir,
                                        struct scap_threadinfo* tinfo,
                                        char* error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%sloginuid", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "loginuid", O_RDONLY, 0);
 	if(fd == -1) {
 		// If Linux kernel is built with CONFIG_AUDIT=n, loginuid management (and associated /proc
 		// file) is not implemented. Record default loginuid value of invalid uid in this case.
@@ -578,14 +581,17 @@ int32_t parse_procfs_proc_pid_loginuid(const char* const procfs_proc_dir,
 	const ssize_t read_bytes = read_exact(fd, buff, sizeof(buff) - 1);
 	close(fd);
 	if(read_bytes <= 0) {
-		return scap_errprintf(error, errno, "can't read loginuid file %s", filename);
+		return scap_errprintf(error, errno, "can't read loginuid file %sloginuid", procfs_proc_dir);
 	}
 	buff[read_bytes] = '\0';
 
 	uint64_t loginuid;
 	if(!str_parse_u64(buff, 0, 10, &loginuid)) {
 		ASSERT(false);
-		return scap_errprintf(error, 0, "can't parse loginuid in loginuid file %s", filename);
+		return scap_errprintf(error,
+		                      0,
+		                      "can't parse loginuid in loginuid file %sloginuid",
+		                      procfs_proc_dir);
 	}
 
 	// note: loginuid could be unset (-1), but this conversion still works in that case.
@@ -615,15 +621,16 @@ int32_t scap_proc_fill_exe_writable(char* error,
                                     struct scap_threadinfo* tinfo,
                                     uint32_t uid,
                                     uint32_t gid,
-                                    const char* procdirname,
+                                    const int procdirfd,
                                     const char* exetarget) {
 	char proc_exe_path[SCAP_MAX_PATH_SIZE];
 	struct stat targetstat;
 
-	snprintf(proc_exe_path, sizeof(proc_exe_path), "%sroot%s", procdirname, exetarget);
+	// The path of the executable as seen from the root of the process, relative to `procdirfd`.
+	snprintf(proc_exe_path, sizeof(proc_exe_path), "root%s", exetarget);
 
 	// if the file doesn't exist we can't determine if it was writable, assume false
-	if(stat(proc_exe_path, &targetstat) < 0) {
+	if(fstatat(procdirfd, proc_exe_path, &targetstat, 0) < 0) {
 		return SCAP_SUCCESS;
 	}
 
@@ -651,7 +658,7 @@ int32_t scap_proc_fill_exe_writable(char* error,
 	//
 
 	if(thread_seteuid(uid) >= 0 && thread_setegid(gid) >= 0) {
-		if(faccessat(0, proc_exe_path, W_OK, AT_EACCESS) == 0) {
+		if(faccessat(procdirfd, proc_exe_path, W_OK, AT_EACCESS) == 0) {
 			tinfo->exe_writable = true;
 		}
 	}
@@ -682,15 +689,14 @@ int32_t scap_proc_fill_exe_writable(char* error,
 
 // Read /proc/<pid>/comm into `buff`. `buff_len` must be greater than 0.
 // note: the comm file content can be up to `TASK_COMM_LEN` bytes long (15 valid characters + '\n').
-static int32_t read_procfs_proc_pid_comm(const char* const procfs_proc_dir,
+static int32_t read_procfs_proc_pid_comm(const int procfs_proc_dirfd,
+                                         const char* const procfs_proc_dir,
                                          char* const buff,
                                          const size_t buff_len,
                                          char* const error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%scomm", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "comm", O_RDONLY, 0);
 	if(fd == -1) {
-		return scap_errprintf(error, errno, "can't open comm file %s", filename);
+		return scap_errprintf(error, errno, "can't open comm file %scomm", procfs_proc_dir);
 	}
 
 	ASSERT(buff_len >= TASK_COMM_LEN);
@@ -706,16 +712,15 @@ static int32_t read_procfs_proc_pid_comm(const char* const procfs_proc_dir,
 
 // Read /proc/<pid>/environ into `buff`. `buff_len` must be greater than 0.
 // path. Return the amount of data read into `read_len`.
-static int32_t read_procfs_proc_pid_environ(const char* const procfs_proc_dir,
+static int32_t read_procfs_proc_pid_environ(const int procfs_proc_dirfd,
+                                            const char* const procfs_proc_dir,
                                             char* const buff,
                                             const size_t buff_len,
                                             uint16_t* read_len,
                                             char* const error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%senviron", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "environ", O_RDONLY, 0);
 	if(fd == -1) {
-		return scap_errprintf(error, errno, "can't open environ file %s", filename);
+		return scap_errprintf(error, errno, "can't open environ file %senviron", procfs_proc_dir);
 	}
 
 	ASSERT(buff_len >= SCAP_MAX_ENV_SIZE);
@@ -733,16 +738,15 @@ static int32_t read_procfs_proc_pid_environ(const char* const procfs_proc_dir,
 
 // Read /proc/<pid>/cmdline into `buff`. `buff_len` must be greater than 0.
 // path. Return the amount of data read into `read_len`.
-static int32_t read_procfs_proc_pid_cmdline(const char* const procfs_proc_dir,
+static int32_t read_procfs_proc_pid_cmdline(const int procfs_proc_dirfd,
+                                            const char* const procfs_proc_dir,
                                             char* const buff,
                                             const size_t buff_len,
                                             size_t* read_len,
                                             char* const error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%scmdline", procfs_proc_dir);
-	const int fd = open(filename, O_RDONLY, 0);
+	const int fd = openat(procfs_proc_dirfd, "cmdline", O_RDONLY, 0);
 	if(fd == -1) {
-		return scap_errprintf(error, errno, "can't open cmdline file %s", filename);
+		return scap_errprintf(error, errno, "can't open cmdline file %scmdline", procfs_proc_dir);
 	}
 
 	ASSERT(buff_len >= SCAP_MAX_ARGS_SIZE);
@@ -788,30 +792,28 @@ static void set_tinfo_exe_and_args_from_cmdline(struct scap_threadinfo* tinfo,
 }
 
 // Read /proc/<pid>/cwd into `buff`. `buff_len` must be greater than 1.
-static int32_t read_procfs_proc_pid_cwd(const char* const procfs_proc_dir,
+static int32_t read_procfs_proc_pid_cwd(const int procfs_proc_dirfd,
+                                        const char* const procfs_proc_dir,
                                         char* const buff,
                                         const size_t buff_len,
                                         char* const error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%scwd", procfs_proc_dir);
-	const ssize_t read_bytes = readlink(filename, buff, buff_len - 1);
+	const ssize_t read_bytes = readlinkat(procfs_proc_dirfd, "cwd", buff, buff_len - 1);
 	if(read_bytes <= 0) {
-		return scap_errprintf(error, errno, "readlink failed on %s", filename);
+		return scap_errprintf(error, errno, "readlink failed on %scwd", procfs_proc_dir);
 	}
 	buff[read_bytes] = '\0';
 	return SCAP_SUCCESS;
 }
 
 // Read /proc/<pid>/root into `buff`. `buff_len` must be greater than 1.
-static int32_t read_procfs_proc_pid_root(const char* const procfs_proc_dir,
+static int32_t read_procfs_proc_pid_root(const int procfs_proc_dirfd,
+                                         const char* const procfs_proc_dir,
                                          char* const buff,
                                          const size_t buff_len,
                                          char* const error) {
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%sroot", procfs_proc_dir);
-	const ssize_t read_bytes = readlink(filename, buff, buff_len - 1);
+	const ssize_t read_bytes = readlinkat(procfs_proc_dirfd, "root", buff, buff_len - 1);
 	if(read_bytes <= 0) {
-		return scap_errprintf(error, errno, "readlink failed on %s", filename);
+		return scap_errprintf(error, errno, "readlink failed on %sroot", procfs_proc_dir);
 	}
 	buff[read_bytes] = '\0';
 	return SCAP_SUCCESS;
@@ -826,6 +828,76 @@ static struct scap_fetch_callbacks linux_vtable_fetch_callbacks(
 	return callbacks;
 }
 
+// Context of the callback completing the threads fetched through the linux vtable.
+struct linux_vtable_threads_ctx {
+	const struct scap_proclist* proclist;
+	uint64_t num_threads;
+	// The threads of a process usually come one after the other, and share the same executable:
+	// the fields read from procfs for the last thread are reused for the next ones.
+	uint64_t last_pid;
+	uint32_t last_uid;
+	uint32_t last_gid;
+	bool last_exe_writable;
+};
+
+// Fill the fields the engines can't provide from procfs: the BPF iterators don't report if the
+// executable is writable by the user of the thread.
+static void linux_vtable_fill_from_procfs(struct linux_vtable_threads_ctx* ctx,
+                                          scap_threadinfo* tinfo) {
+	if(ctx->num_threads != 0 && tinfo->pid == ctx->last_pid && tinfo->uid == ctx->last_uid &&
+	   tinfo->gid == ctx->last_gid) {
+		tinfo->exe_writable = ctx->last_exe_writable;
+		return;
+	}
+
+	char dir_name[SCAP_MAX_PATH_SIZE];
+	char lasterr[SCAP_LASTERR_SIZE];
+	snprintf(dir_name, sizeof(dir_name), "%s/proc/%" PRIu64 "/", scap_get_host_root(), tinfo->tid);
+	// Best effort: on failure the field is just left unset.
+	const int dirfd = open(dir_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if(dirfd != -1) {
+		scap_proc_fill_exe_writable(lasterr, tinfo, tinfo->uid, tinfo->gid, dirfd, tinfo->exepath);
+		close(dirfd);
+	}
+
+	ctx->last_pid = tinfo->pid;
+	ctx->last_uid = tinfo->uid;
+	ctx->last_gid = tinfo->gid;
+	ctx->last_exe_writable = tinfo->exe_writable;
+}
+
+static int32_t linux_vtable_thread_entry_cb(void* context,
+                                            char* error,
+                                            int64_t tid,
+                                            scap_threadinfo* tinfo,
+                                            scap_fdinfo* fdinfo,
+                                            scap_threadinfo** new_tinfo) {
+	struct linux_vtable_threads_ctx* ctx = (struct linux_vtable_threads_ctx*)context;
+	if(tinfo != NULL && fdinfo == NULL) {
+		linux_vtable_fill_from_procfs(ctx, tinfo);
+		ctx->num_threads++;
+	}
+
+	const struct scap_proclist* proclist = ctx->proclist;
+	return proclist->m_callbacks.m_proc_entry_cb(proclist->m_callbacks.m_callback_context,
+	                                             error,
+	                                             tid,
+	                                             tinfo,
+	                                             fdinfo,
+	                                             new_tinfo);
+}
+
+// Creates callbacks for linux vtable's `fetch_thread*` APIs, completing the threads from procfs.
+static struct scap_fetch_callbacks linux_vtable_threads_callbacks(
+        struct linux_vtable_threads_ctx* ctx,
+        const struct scap_proclist* proclist) {
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->proclist = proclist;
+	const struct scap_fetch_callbacks callbacks = {.proc_entry_cb = linux_vtable_thread_entry_cb,
+	                                               .ctx = ctx};
+	return callbacks;
+}
+
 // Wrapper making calls to linux vtable's `.fetch_thread()` API ergonomic.
 static int32_t linux_vtable_fetch_thread(const struct scap_linux_platform* linux_platform,
                                          const struct scap_proclist* proclist,
@@ -836,7 +908,8 @@ static int32_t linux_vtable_fetch_thread(const struct scap_linux_platform* linux
 		return SCAP_NOT_SUPPORTED;
 	}
 
-	const struct scap_fetch_callbacks callbacks = linux_vtable_fetch_callbacks(proclist);
+	struct linux_vtable_threads_ctx ctx;
+	const struct scap_fetch_callbacks callbacks = linux_vtable_threads_callbacks(&ctx, proclist);
 	return linux_platform->m_linux_vtable->fetch_thread(linux_platform->m_engine,
 	                                                    &callbacks,
 	                                                    tid,
@@ -847,15 +920,19 @@ static int32_t linux_vtable_fetch_thread(const struct scap_linux_platform* linux
 // Wrapper making calls to linux vtable's `.fetch_threads()` API ergonomic.
 static int32_t linux_vtable_fetch_threads(const struct scap_linux_platform* linux_platform,
                                           const struct scap_proclist* proclist,
+                                          uint64_t* num_threads_fetched,
                                           char* error) {
 	if(!linux_platform->m_linux_vtable || !linux_platform->m_linux_vtable->fetch_threads) {
 		return SCAP_NOT_SUPPORTED;
 	}
 
-	const struct scap_fetch_callbacks callbacks = linux_vtable_fetch_callbacks(proclist);
-	return linux_platform->m_linux_vtable->fetch_threads(linux_platform->m_engine,
-	                                                     &callbacks,
-	                                                     error);
+	struct linux_vtable_threads_ctx ctx;
+	const struct scap_fetch_callbacks callbacks = linux_vtable_threads_callbacks(&ctx, proclist);
+	const int32_t res = linux_platform->m_linux_vtable->fetch_threads(linux_platform->m_engine,
+	                                                                  &callbacks,
+	                                                                  error);
+	*num_threads_fetched = ctx.num_threads;
+	return res;
 }
 
 // Wrapper making calls to linux vtable's `.fetch_proc_file()` API ergonomic.
@@ -911,22 +988,27 @@ static int32_t linux_vtable_fetch_procs_files(const struct scap_linux_platform*
 }
 
 //
-// Add a process to the list by parsing its entry under /proc
+// Add a process to the list by parsing its /proc/<tid> directory, opened as `dirfd`. `dir_name`
+// is its path, with a trailing slash.
 //
-static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platform,
-                                       struct scap_proclist* proclist,
-                                       uint32_t tid,
-                                       char* procdirname,
-                                       struct scap_ns_socket_list** sockets_by_ns,
-                                       uint64_t* num_fds_ret,
-                                       char* error) {
-	char dir_name[SCAP_MAX_PATH_SIZE];
-	snprintf(dir_name, sizeof(dir_name), "%s/%u/", procdirname, tid);
+static int32_t scap_proc_add_from_proc_dir(struct scap_linux_platform* linux_platform,
+                                           struct scap_proclist* proclist,
+                                           uint32_t tid,
+                                           const int dirfd,
+                                           char* dir_name,
+                                           struct scap_ns_socket_list** sockets_by_ns,
+                                           uint64_t* num_fds_ret,
+                                           char* error) {
+	// Scratch buffer for the errors of the helpers: this can run on the workers of a parallel scan,
+	// so the one of the platform can't be used.
+	char lasterr[SCAP_LASTERR_SIZE];
+	lasterr[0] = '\0';
 
 	// Gather the command line.
 	char cmdline_buff[SCAP_MAX_ARGS_SIZE];
 	size_t cmdline_len = 0;
-	int32_t res = read_procfs_proc_pid_cmdline(dir_name,
+	int32_t res = read_procfs_proc_pid_cmdline(dirfd,
+	                                           dir_name,
 	                                           cmdline_buff,
 	                                           SCAP_MAX_ARGS_SIZE,
 	                                           &cmdline_len,
@@ -937,10 +1019,8 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	ASSERT(cmdline_len <= SCAP_MAX_ARGS_SIZE);
 
 	// Gather the executable full path.
-	char filename[SCAP_MAX_PATH_SIZE];
-	snprintf(filename, sizeof(filename), "%sexe", dir_name);
 	char target_name[SCAP_MAX_PATH_SIZE];
-	const ssize_t target_res = readlink(filename, target_name, sizeof(target_name) - 1);
+	const ssize_t target_res = readlinkat(dirfd, "exe", target_name, sizeof(target_name) - 1);
 
 	// Here we have a logic determining if we accept the current process. It leverages information
 	// gathered while reading the command line and the executable full path.
@@ -972,7 +1052,7 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	snprintf(tinfo.exepath, sizeof(tinfo.exepath), "%s", target_name);
 
 	// Gather and set the command name.
-	res = read_procfs_proc_pid_comm(dir_name, tinfo.comm, sizeof(tinfo.comm), error);
+	res = read_procfs_proc_pid_comm(dirfd, dir_name, tinfo.comm, sizeof(tinfo.comm), error);
 	if(res == SCAP_FAILURE) {
 		return res;
 	}
@@ -981,7 +1061,8 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	set_tinfo_exe_and_args_from_cmdline(&tinfo, cmdline_buff, (uint16_t)cmdline_len);
 
 	// Gather and set the environment.
-	res = read_procfs_proc_pid_environ(dir_name,
+	res = read_procfs_proc_pid_environ(dirfd,
+	                                   dir_name,
 	                                   tinfo.env,
 	                                   sizeof(tinfo.env),
 	                                   &tinfo.env_len,
@@ -993,7 +1074,7 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	//
 	// set the current working directory of the process
 	//
-	res = read_procfs_proc_pid_cwd(dir_name, tinfo.cwd, sizeof(tinfo.cwd), error);
+	res = read_procfs_proc_pid_cwd(dirfd, dir_name, tinfo.cwd, sizeof(tinfo.cwd), error);
 	if(res == SCAP_FAILURE) {
 		return res;
 	}
@@ -1001,38 +1082,26 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	//
 	// extract the user id and ppid from /proc/pid/status
 	//
-	if(SCAP_FAILURE ==
-	   scap_proc_fill_info_from_stats(linux_platform->m_lasterr, dir_name, &tinfo)) {
-		return scap_errprintf(error,
-		                      0,
-		                      "can't fill uid and pid for %s (%s)",
-		                      dir_name,
-		                      linux_platform->m_lasterr);
+	if(SCAP_FAILURE == scap_proc_fill_info_from_stats(lasterr, dirfd, dir_name, &tinfo)) {
+		return scap_errprintf(error, 0, "can't fill uid and pid for %s (%s)", dir_name, lasterr);
 	}
 
 	//
 	// Set the file limit
 	//
 	if(SCAP_FAILURE == scap_proc_fill_flimit(tinfo.tid, &tinfo)) {
-		return scap_errprintf(error,
-		                      0,
-		                      "can't fill flimit for %s (%s)",
-		                      dir_name,
-		                      linux_platform->m_lasterr);
+		return scap_errprintf(error, 0, "can't fill flimit for %s (%s)", dir_name, lasterr);
 	}
 
 	if(scap_cgroup_get_thread(&linux_platform->m_cgroups,
+	                          dirfd,
 	                          dir_name,
 	                          &tinfo.cgroups,
-	                          linux_platform->m_lasterr) == SCAP_FAILURE) {
-		return scap_errprintf(error,
-		                      0,
-		                      "can't fill cgroups for %s (%s)",
-		                      dir_name,
-		                      linux_platform->m_lasterr);
+	                          lasterr) == SCAP_FAILURE) {
+		return scap_errprintf(error, 0, "can't fill cgroups for %s (%s)", dir_name, lasterr);
 	}
 
-	if(scap_proc_fill_pidns_start_ts(linux_platform->m_lasterr, &tinfo, dir_name) == SCAP_FAILURE) {
+	if(scap_proc_fill_pidns_start_ts(lasterr, &tinfo, dirfd) == SCAP_FAILURE) {
 		// ignore errors
 		// the thread may not have /proc visible so we shouldn't kill the scan if this fails
 	}
@@ -1050,7 +1119,7 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	//
 	// set the current root of the process
 	//
-	res = read_procfs_proc_pid_root(dir_name, tinfo.root, sizeof(tinfo.root), error);
+	res = read_procfs_proc_pid_root(dirfd, dir_name, tinfo.root, sizeof(tinfo.root), error);
 	if(res == SCAP_FAILURE) {
 		return res;
 	}
@@ -1058,7 +1127,7 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	//
 	// set the loginuid
 	//
-	res = parse_procfs_proc_pid_loginuid(dir_name, &tinfo, error);
+	res = parse_procfs_proc_pid_loginuid(dirfd, dir_name, &tinfo, error);
 	if(res == SCAP_FAILURE) {
 		return res;
 	}
@@ -1066,9 +1135,7 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	// Container start time for host processes will be equal to when the
 	// host init started
 	struct stat dirstat;
-	char proc_cmdline[SCAP_MAX_PATH_SIZE];
-	snprintf(proc_cmdline, sizeof(proc_cmdline), "%scmdline", dir_name);
-	if(stat(proc_cmdline, &dirstat) == 0) {
+	if(fstatat(dirfd, "cmdline", &dirstat, 0) == 0) {
 		tinfo.clone_ts = dirstat.st_ctim.tv_sec * SECOND_TO_NS + dirstat.st_ctim.tv_nsec;
 	}
 
@@ -1087,28 +1154,26 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 		tinfo.flags = PPM_CL_CLONE_THREAD | PPM_CL_CLONE_FILES;
 	}
 
-	if(SCAP_FAILURE == scap_proc_fill_exe_ino_ctime_mtime(linux_platform->m_lasterr,
-	                                                      &tinfo,
-	                                                      dir_name,
-	                                                      target_name)) {
+	if(SCAP_FAILURE ==
+	   scap_proc_fill_exe_ino_ctime_mtime(lasterr, &tinfo, dir_name, target_name)) {
 		return scap_errprintf(error,
 		                      0,
 		                      "can't fill exe writable access for %s (%s)",
 		                      dir_name,
-		                      linux_platform->m_lasterr);
+		                      lasterr);
 	}
 
-	if(SCAP_FAILURE == scap_proc_fill_exe_writable(linux_platform->m_lasterr,
+	if(SCAP_FAILURE == scap_proc_fill_exe_writable(lasterr,
 	                                               &tinfo,
 	                                               tinfo.uid,
 	                                               tinfo.gid,
-	                                               dir_name,
+	                                               dirfd,
 	                                               target_name)) {
 		return scap_errprintf(error,
 		                      0,
 		                      "can't fill exe writable access for %s (%s)",
 		                      dir_name,
-		                      linux_platform->m_lasterr);
+		                      lasterr);
 	}
 
 	scap_threadinfo* new_tinfo = &tinfo;
@@ -1148,6 +1213,38 @@ static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platfor
 	                           error);
 }
 
+//
+// Add a process to the list by parsing its entry under /proc
+//
+static int32_t scap_proc_add_from_proc(struct scap_linux_platform* linux_platform,
+                                       struct scap_proclist* proclist,
+                                       uint32_t tid,
+                                       char* procdirname,
+                                       struct scap_ns_socket_list** sockets_by_ns,
+                                       uint64_t* num_fds_ret,
+                                       char* error) {
+	char dir_name[SCAP_MAX_PATH_SIZE];
+	snprintf(dir_name, sizeof(dir_name), "%s/%u/", procdirname, tid);
+
+	// The files of the process are opened relative to its directory, so that its path is only
+	// resolved once.
+	const int dirfd = open(dir_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if(dirfd == -1) {
+		return scap_errprintf(error, errno, "can't open %s", dir_name);
+	}
+
+	const int32_t res = scap_proc_add_from_proc_dir(linux_platform,
+	                                                proclist,
+	                                                tid,
+	                                                dirfd,
+	                                                dir_name,
+	                                                sockets_by_ns,
+	                                                num_fds_ret,
+	                                                error);
+	close(dirfd);
+	return res;
+}
+
 // Read a single thread from the provided proc dir.
 int32_t scap_proc_read_thread(struct scap_linux_platform* linux_platform,
                               struct scap_proclist* proclist,
@@ -1566,6 +1663,410 @@ static int32_t _scap_proc_scan_proc_dir_impl(struct scap_linux_platform* linux_p
 	return res;
 }
 
+//
+// Parallel scan of /proc: the pids are split among worker threads, every
+// worker scans a pid and its tasks into a private proc table (a batch), and
+// the calling thread merges the batches in the order of the pids, so the
+// callbacks are always invoked from the calling thread, in the same order as
+// the serial scan. Workers can only scan a bounded number of pids ahead of
+// the merge, to bound the memory held by the batches.
+//
+
+// Number of batches a worker can fill ahead of the merge.
+#define PROC_SCAN_BATCHES_PER_WORKER 16
+
+struct proc_scan_batch {
+	struct scap_proclist proclist;
+	uint64_t num_fds;
+	int32_t add_res;    // result of reading the process
+	int32_t tasks_res;  // result of reading its tasks
+	char error[SCAP_LASTERR_SIZE];
+	bool done;
+};
+
+struct proc_scan_ctx {
+	struct scap_linux_platform* linux_platform;
+	char* procdirname;
+	const uint32_t* pids;
+	uint32_t num_pids;
+
+	// Ring of batches, the batch of the n-th pid is `batches[n % num_batches]`.
+	struct proc_scan_batch* batches;
+	uint32_t num_batches;
+
+	pthread_mutex_t mtx;
+	pthread_cond_t batch_done;  // signaled by the workers when a batch is done
+	pthread_cond_t batch_free;  // signaled by the merge when a batch is free again
+	uint32_t next_scan;         // index of the next pid to scan
+	uint32_t next_merge;        // index of the next pid to merge
+	bool stop;
+};
+
+static void proc_scan_free_batch(struct proc_scan_batch* batch) {
+	scap_proc_free_table(&batch->proclist);
+	batch->proclist.m_proclist = NULL;
+	batch->done = false;
+}
+
+static void proc_scan_pid(struct proc_scan_ctx* ctx,
+                          uint32_t pid,
+                          struct proc_scan_batch* batch,
+                          struct scap_ns_socket_list** sockets_by_ns) {
+	struct scap_linux_platform* linux_platform = ctx->linux_platform;
+	char add_error[SCAP_LASTERR_SIZE];
+
+	scap_proc_callbacks callbacks = {default_refresh_start_end_callback,
+	                                 default_refresh_start_end_callback,
+	                                 NULL,
+	                                 NULL};
+	init_proclist(&batch->proclist, callbacks);
+	batch->num_fds = 0;
+	batch->tasks_res = SCAP_SUCCESS;
+	batch->add_res = scap_proc_add_from_proc(linux_platform,
+	                                         &batch->proclist,
+	                                         pid,
+	                                         ctx->procdirname,
+	                                         sockets_by_ns,
+	                                         &batch->num_fds,
+	                                         add_error);
+	if(batch->add_res != SCAP_SUCCESS || linux_platform->m_minimal_scan) {
+		return;
+	}
+
+	char childdir[SCAP_MAX_PATH_SIZE];
+	snprintf(childdir, sizeof(childdir), "%s/%u/task", ctx->procdirname, pid);
+	if(_scap_proc_scan_proc_dir_impl(linux_platform,
+	                                 &batch->proclist,
+	                                 childdir,
+	                                 pid,
+	                                 batch->error) == SCAP_FAILURE) {
+		batch->tasks_res = SCAP_FAILURE;
+	}
+}
+
+static void* proc_scan_worker(void* arg) {
+	struct proc_scan_ctx* ctx = (struct proc_scan_ctx*)arg;
+	struct scap_ns_socket_list* sockets_by_ns = NULL;
+
+	pthread_mutex_lock(&ctx->mtx);
+	while(true) {
+		while(!ctx->stop && ctx->next_scan < ctx->num_pids &&
+		      ctx->next_scan - ctx->next_merge >= ctx->num_batches) {
+			pthread_cond_wait(&ctx->batch_free, &ctx->mtx);
+		}
+		if(ctx->stop || ctx->next_scan >= ctx->num_pids) {
+			break;
+		}
+
+		const uint32_t idx = ctx->next_scan++;
+		struct proc_scan_batch* batch = &ctx->batches[idx % ctx->num_batches];
+		pthread_mutex_unlock(&ctx->mtx);
+
+		proc_scan_pid(ctx, ctx->pids[idx], batch, &sockets_by_ns);
+
+		pthread_mutex_lock(&ctx->mtx);
+		batch->done = true;
+		pthread_cond_signal(&ctx->batch_done);
+	}
+	pthread_mutex_unlock(&ctx->mtx);
+
+	if(sockets_by_ns != NULL) {
+		scap_fd_free_ns_sockets_list(&sockets_by_ns);
+	}
+	return NULL;
+}
+
+// Pass the threads and the fds of a batch to the callbacks of `proclist`.
+static int32_t proc_scan_merge_batch(struct scap_proclist* proclist,
+                                     struct proc_scan_batch* batch,
+                                     char* error) {
+	scap_threadinfo* tinfo;
+	scap_threadinfo* ttinfo;
+	HASH_ITER(hh, batch->proclist.m_proclist, tinfo, ttinfo) {
+		scap_threadinfo* dup;
+		HASH_FIND_INT64(proclist->m_proclist, &tinfo->tid, dup);
+		if(dup != NULL) {
+			ASSERT(false);
+			return scap_errprintf(error, 0, "duplicate process %" PRIu64, tinfo->tid);
+		}
+
+		// The fds are passed one by one, as the serial scan does.
+		scap_fdinfo* fdlist = tinfo->fdlist;
+		tinfo->fdlist = NULL;
+
+		scap_threadinfo* new_tinfo = tinfo;
+		proclist->m_callbacks.m_proc_entry_cb(proclist->m_callbacks.m_callback_context,
+		                                      error,
+		                                      tinfo->tid,
+		                                      tinfo,
+		                                      NULL,
+		                                      &new_tinfo);
+
+		scap_fdinfo* fdi;
+		scap_fdinfo* tfdi;
+		HASH_ITER(hh, fdlist, fdi, tfdi) {
+			proclist->m_callbacks.m_proc_entry_cb(proclist->m_callbacks.m_callback_context,
+			                                      error,
+			                                      tinfo->tid,
+			                                      new_tinfo,
+			                                      fdi,
+			                                      NULL);
+			HASH_DEL(fdlist, fdi);
+			free(fdi);
+		}
+	}
+	return SCAP_SUCCESS;
+}
+
+static int32_t _scap_proc_scan_proc_dir_parallel(struct scap_linux_platform* linux_platform,
+                                                 struct scap_proclist* proclist,
+                                                 char* procdirname,
+                                                 char* error) {
+	DIR* dir_p = opendir(procdirname);
+	if(dir_p == NULL) {
+		scap_errprintf(error, errno, "error opening the %s directory", procdirname);
+		return SCAP_NOTFOUND;
+	}
+
+	// Gather the pids first, so that the workers can pick them by index.
+	uint32_t* pids = NULL;
+	uint32_t num_pids = 0;
+	uint32_t pids_size = 0;
+	const struct dirent* dir_entry_p;
+	while((dir_entry_p = readdir(dir_p)) != NULL) {
+		if(!is_xid_filename(dir_entry_p->d_name)) {
+			continue;
+		}
+		if(num_pids == pids_size) {
+			pids_size = pids_size == 0 ? 1024 : pids_size * 2;
+			uint32_t* new_pids = (uint32_t*)realloc(pids, pids_size * sizeof(*pids));
+			if(new_pids == NULL) {
+				free(pids);
+				closedir(dir_p);
+				return scap_errprintf(error, 0, "can't allocate the /proc scan pid list");
+			}
+			pids = new_pids;
+		}
+		pids[num_pids++] = (uint32_t)atoi(dir_entry_p->d_name);
+	}
+	closedir(dir_p);
+
+	uint32_t num_workers = linux_platform->m_proc_scan_threads;
+	if(num_workers > num_pids) {
+		num_workers = num_pids;
+	}
+
+	struct proc_scan_ctx ctx = {
+	        .linux_platform = linux_platform,
+	        .procdirname = procdirname,
+	        .pids = pids,
+	        .num_pids = num_pids,
+	        .num_batches = num_workers * PROC_SCAN_BATCHES_PER_WORKER,
+	};
+	pthread_t* workers = (pthread_t*)calloc(num_workers, sizeof(pthread_t));
+	ctx.batches = (struct proc_scan_batch*)calloc(ctx.num_batches, sizeof(*ctx.batches));
+	if(num_workers == 0 || workers == NULL || ctx.batches == NULL) {
+		free(workers);
+		free(ctx.batches);
+		free(pids);
+		if(num_workers == 0) {
+			return SCAP_SUCCESS;
+		}
+		return scap_errprintf(error, 0, "can't allocate the /proc scan workers");
+	}
+	pthread_mutex_init(&ctx.mtx, NULL);
+	pthread_cond_init(&ctx.batch_done, NULL);
+	pthread_cond_init(&ctx.batch_free, NULL);
+
+	uint32_t num_started = 0;
+	for(; num_started < num_workers; num_started++) {
+		if(pthread_create(&workers[num_started], NULL, proc_scan_worker, &ctx) != 0) {
+			break;
+		}
+	}
+	if(num_started == 0) {
+		// No worker could be started, fall back to the serial scan.
+		pthread_cond_destroy(&ctx.batch_free);
+		pthread_cond_destroy(&ctx.batch_done);
+		pthread_mutex_destroy(&ctx.mtx);
+		free(ctx.batches);
+		free(workers);
+		free(pids);
+		return _scap_proc_scan_proc_dir_impl(linux_platform, proclist, procdirname, -1, error);
+	}
+
+	// Do timing tracking only if one or both of the timing parameters is configured to non-zero.
+	const bool do_timing = linux_platform->m_proc_scan_timeout_ms != SCAP_PROC_SCAN_TIMEOUT_NONE ||
+	                       linux_platform->m_proc_scan_log_interval_ms != SCAP_PROC_SCAN_LOG_NONE;
+	uint64_t monotonic_ts_context = SCAP_GET_CUR_TS_MS_CONTEXT_INIT;
+	uint64_t start_ts_ms = 0;
+	uint64_t last_log_ts_ms = 0;
+	uint64_t last_proc_ts_ms = 0;
+	uint64_t cur_ts_ms = 0;
+	uint64_t min_proc_time_ms = UINT64_MAX;
+	uint64_t max_proc_time_ms = 0;
+	if(do_timing) {
+		start_ts_ms = scap_get_monotonic_ts_ms(&monotonic_ts_context);
+		last_log_ts_ms = start_ts_ms;
+		last_proc_ts_ms = start_ts_ms;
+	}
+
+	uint64_t num_procs_processed = 0;
+	uint64_t total_num_fds = 0;
+	uint64_t last_tid_processed = 0;
+	int32_t res = SCAP_SUCCESS;
+	bool timeout_expired = false;
+
+	for(uint32_t idx = 0; idx < num_pids && !timeout_expired; idx++) {
+		struct proc_scan_batch* batch = &ctx.batches[idx % ctx.num_batches];
+		pthread_mutex_lock(&ctx.mtx);
+		while(!batch->done) {
+			pthread_cond_wait(&ctx.batch_done, &ctx.mtx);
+		}
+		pthread_mutex_unlock(&ctx.mtx);
+
+		// Whatever was read is merged, even if reading the process failed midway, since the
+		// serial scan would have already passed it to the callbacks. As in the serial scan,
+		// failing to read a process only skips it, while failing to read its tasks fails the
+		// whole scan.
+		res = proc_scan_merge_batch(proclist, batch, error);
+		const int32_t add_res = batch->add_res;
+		if(res == SCAP_SUCCESS && add_res == SCAP_SUCCESS && batch->tasks_res != SCAP_SUCCESS) {
+			res = scap_errprintf(error, 0, "%s", batch->error);
+		}
+		const uint64_t num_fds_this_proc = batch->num_fds;
+		proc_scan_free_batch(batch);
+
+		pthread_mutex_lock(&ctx.mtx);
+		ctx.next_merge++;
+		pthread_cond_broadcast(&ctx.batch_free);
+		pthread_mutex_unlock(&ctx.mtx);
+
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+		if(add_res != SCAP_SUCCESS) {
+			continue;
+		}
+
+		// PID successfully processed.
+		last_tid_processed = pids[idx];
+		num_procs_processed++;
+		total_num_fds += num_fds_this_proc;
+
+		if(!do_timing) {
+			continue;
+		}
+
+		cur_ts_ms = scap_get_monotonic_ts_ms(&monotonic_ts_context);
+		const uint64_t total_elapsed_time_ms = cur_ts_ms - start_ts_ms;
+
+		const uint64_t this_proc_elapsed_time_ms = cur_ts_ms - last_proc_ts_ms;
+		last_proc_ts_ms = cur_ts_ms;
+
+		if(this_proc_elapsed_time_ms < min_proc_time_ms) {
+			min_proc_time_ms = this_proc_elapsed_time_ms;
+		}
+		if(this_proc_elapsed_time_ms > max_proc_time_ms) {
+			max_proc_time_ms = this_proc_elapsed_time_ms;
+		}
+
+		if(linux_platform->m_proc_scan_log_interval_ms != SCAP_PROC_SCAN_LOG_NONE) {
+			const uint64_t log_elapsed_time_ms = cur_ts_ms - last_log_ts_ms;
+			if(log_elapsed_time_ms >= linux_platform->m_proc_scan_log_interval_ms) {
+				scap_debug_log(linux_platform,
+				               "scap_proc_scan: %ld proc in %ld ms, avg=%ld/min=%ld/max=%ld, "
+				               "last pid %ld, num_fds %ld",
+				               num_procs_processed,
+				               total_elapsed_time_ms,
+				               total_elapsed_time_ms / num_procs_processed,
+				               min_proc_time_ms,
+				               max_proc_time_ms,
+				               last_tid_processed,
+				               total_num_fds);
+				last_log_ts_ms = cur_ts_ms;
+			}
+		}
+
+		if(linux_platform->m_proc_scan_timeout_ms != SCAP_PROC_SCAN_TIMEOUT_NONE) {
+			if(total_elapsed_time_ms >= linux_platform->m_proc_scan_timeout_ms) {
+				timeout_expired = true;
+			}
+		}
+	}
+
+	// Stop the workers, and drop what they scanned and was not merged.
+	pthread_mutex_lock(&ctx.mtx);
+	ctx.stop = true;
+	pthread_cond_broadcast(&ctx.batch_free);
+	pthread_mutex_unlock(&ctx.mtx);
+	for(uint32_t j = 0; j < num_started; j++) {
+		pthread_join(workers[j], NULL);
+	}
+	for(uint32_t j = 0; j < ctx.num_batches; j++) {
+		proc_scan_free_batch(&ctx.batches[j]);
+	}
+
+	pthread_cond_destroy(&ctx.batch_free);
+	pthread_cond_destroy(&ctx.batch_done);
+	pthread_mutex_destroy(&ctx.mtx);
+	free(ctx.batches);
+	free(workers);
+	free(pids);
+
+	if(!do_timing) {
+		return res;
+	}
+
+	cur_ts_ms = scap_get_monotonic_ts_ms(&monotonic_ts_context);
+	const uint64_t total_elapsed_time_ms = cur_ts_ms - start_ts_ms;
+	const uint64_t avg_proc_time_ms =
+	        num_procs_processed != 0 ? total_elapsed_time_ms / num_procs_processed : 0;
+
+	if(timeout_expired) {
+		scap_debug_log(linux_platform,
+		               "scap_proc_scan TIMEOUT (%ld ms): %ld proc in %ld ms, "
+		               "avg=%ld/min=%ld/max=%ld, last pid %ld, num_fds %ld, %u threads",
+		               linux_platform->m_proc_scan_timeout_ms,
+		               num_procs_processed,
+		               total_elapsed_time_ms,
+		               avg_proc_time_ms,
+		               min_proc_time_ms,
+		               max_proc_time_ms,
+		               last_tid_processed,
+		               total_num_fds,
+		               num_started);
+	} else if(linux_platform->m_proc_scan_log_interval_ms != SCAP_PROC_SCAN_LOG_NONE &&
+	          num_procs_processed != 0) {
+		scap_debug_log(linux_platform,
+		               "scap_proc_scan DONE: %ld proc in %ld ms, avg=%ld/min=%ld/max=%ld, last "
+		               "pid %ld, num_fds %ld, %u threads",
+		               num_procs_processed,
+		               total_elapsed_time_ms,
+		               avg_proc_time_ms,
+		               min_proc_time_ms,
+		               max_proc_time_ms,
+		               last_tid_processed,
+		               total_num_fds,
+		               num_started);
+	}
+
+	return res;
+}
+
+int32_t scap_linux_scan_proc_dir(struct scap_linux_platform* linux_platform,
+                                 struct scap_proclist* proclist,
+                                 char* procdirname,
+                                 char* error) {
+	// Engines fetching the files of the processes are not meant to be used by several threads.
+	const bool engine_fetches_files =
+	        linux_platform->m_linux_vtable && linux_platform->m_linux_vtable->fetch_proc_files;
+	if(linux_platform->m_proc_scan_threads > 1 && !engine_fetches_files) {
+		return _scap_proc_scan_proc_dir_parallel(linux_platform, proclist, procdirname, error);
+	}
+	return _scap_proc_scan_proc_dir_impl(linux_platform, proclist, procdirname, -1, error);
+}
+
 int32_t scap_linux_getpid_global(struct scap_platform* platform, int64_t* pid, char* error) {
 	const struct scap_linux_platform* linux_platform = (struct scap_linux_platform*)platform;
 
@@ -1670,6 +2171,24 @@ int32_t scap_linux_proc_get(struct scap_platform* platform, int64_t tid, bool sc
 	return res;
 }
 
+int32_t scap_linux_proc_fetch(struct scap_platform* platform,
+                              struct scap_proclist* proclist,
+                              int64_t tid,
+                              bool scan_sockets,
+                              char* error) {
+	struct scap_linux_platform* linux_platform = (struct scap_linux_platform*)platform;
+
+	if(tid <= 0) {
+		return scap_errprintf(error, 0, "expected positive thread id, got: %ld", tid);
+	}
+
+	// Only procfs is read here: the engine's fetch APIs are meant to be called from the
+	// capture thread.
+	char proc_dir[SCAP_MAX_PATH_SIZE];
+	snprintf(proc_dir, sizeof(proc_dir), "%s/proc", scap_get_host_root());
+	return scap_proc_read_thread(linux_platform, proclist, proc_dir, tid, error, scan_sockets);
+}
+
 bool scap_linux_is_thread_alive(struct scap_platform* platform,
                                 int64_t pid,
                                 int64_t tid,
@@ -1718,13 +2237,17 @@ int32_t scap_linux_refresh_proc_table(struct scap_platform* platform,
 	scap_cgroup_enable_cache(&linux_platform->m_cgroups);
 	proclist->m_callbacks.m_refresh_start_cb(proclist->m_callbacks.m_callback_context);
 
+	uint64_t monotonic_ts_context = SCAP_GET_CUR_TS_MS_CONTEXT_INIT;
+	const uint64_t start_ts_ms = scap_get_monotonic_ts_ms(&monotonic_ts_context);
+
 	// Try to fetch all threads leveraging linux vtable's API.
-	int32_t res = linux_vtable_fetch_threads(linux_platform, proclist, error);
+	uint64_t num_threads = 0;
+	int32_t res = linux_vtable_fetch_threads(linux_platform, proclist, &num_threads, error);
 	if(res == SCAP_NOT_SUPPORTED) {
 		// Fall back to procfs processes lookup.
 		char procfs_dir_path[SCAP_MAX_PATH_SIZE];
 		snprintf(procfs_dir_path, sizeof(procfs_dir_path), "%s/proc", scap_get_host_root());
-		res = _scap_proc_scan_proc_dir_impl(linux_platform, proclist, procfs_dir_path, -1, error);
+		res = scap_linux_scan_proc_dir(linux_platform, proclist, procfs_dir_path, error);
 		goto cleanup;
 	}
 
@@ -1742,6 +2265,14 @@ int32_t scap_linux_refresh_proc_table(struct scap_platform* platform,
 		res = fetch_procfs_procs_files(linux_platform, proclist, procfs_dir_path, error);
 	}
 
+	// The procfs scan logs its own timings, these allow comparing both.
+	if(linux_platform->m_proc_scan_log_interval_ms != SCAP_PROC_SCAN_LOG_NONE) {
+		scap_debug_log(linux_platform,
+		               "scap_proc_scan DONE (engine): %ld threads in %ld ms",
+		               num_threads,
+		               scap_get_monotonic_ts_ms(&monotonic_ts_context) - start_ts_ms);
+	}
+
 cleanup:
 	proclist->m_callbacks.m_refresh_end_cb(proclist->m_callbacks.m_callback_context);
 	scap_cgroup_clear_cache(&linux_platform->m_cgroups);
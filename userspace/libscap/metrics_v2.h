@@ -45,6 +45,10 @@ extern "C" {
 //
 #define N_EVENTS_PER_DEVICE_PREFIX "n_evts_dev_"
 #define N_DROPS_PER_DEVICE_PREFIX "n_drops_dev_"
+#define N_FILTER_EVALS_PREFIX "n_filter_evals_"
+#define FILTER_COST_NS_PREFIX "filter_cost_ns_"
+#define FILTER_PASS_RATIO_PREFIX "filter_pass_ratio_"
+#define N_FILTER_REORDERS_PREFIX "n_filter_reorders_"
 
 //
 // metrics_v2 flags
@@ -59,6 +63,7 @@ extern "C" {
 #define METRICS_V2_KERNEL_COUNTERS_PER_CPU \
 	(1 << 7)  // Requesting this does also silently enable METRICS_V2_KERNEL_COUNTERS
 #define METRICS_V2_KERNEL_ITER_COUNTERS (1 << 8)
+#define METRICS_V2_FILTER_PROFILE (1 << 9)
 
 typedef union metrics_v2_value {
 	uint32_t u32;
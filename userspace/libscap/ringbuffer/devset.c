@@ -45,6 +45,16 @@ int32_t devset_init(struct scap_device_set *devset, size_t num_devs, char *laste
 	}
 	devset->m_buffer_empty_wait_time_us = BUFFER_EMPTY_WAIT_TIME_US_START;
 	devset->m_lasterr = lasterr;
+	devset->m_last_devid = DEVSET_NO_DEVICE;
+	relaxed_order_init(&devset->m_relaxed, 0, 0);
+	devset->m_shards = NULL;
+	devset->m_nshards = 0;
+
+	if(!ts_heap_init(&devset->m_heap, devset->m_ndevs)) {
+		free(devset->m_devs);
+		devset->m_devs = NULL;
+		return scap_errprintf(lasterr, 0, "error allocating the device heap");
+	}
 
 	return SCAP_SUCCESS;
 }
@@ -67,4 +77,47 @@ void devset_free(struct scap_device_set *devset) {
 		devset_close_device(dev);
 	}
 	free(devset->m_devs);
+	ts_heap_free(&devset->m_heap);
+
+	for(j = 0; j < devset->m_nshards; j++) {
+		ts_heap_free(&devset->m_shards[j].m_heap);
+	}
+	free(devset->m_shards);
+	devset->m_shards = NULL;
+	devset->m_nshards = 0;
+}
+
+int32_t devset_init_shards(struct scap_device_set *devset, uint32_t num_shards, char *lasterr) {
+	if(num_shards > devset->m_ndevs) {
+		num_shards = devset->m_ndevs;
+	}
+	if(num_shards <= 1) {
+		return SCAP_SUCCESS;
+	}
+
+	devset->m_shards =
+	        (struct scap_device_set *)calloc(num_shards, sizeof(struct scap_device_set));
+	if(!devset->m_shards) {
+		return scap_errprintf(lasterr, 0, "error allocating the device shards");
+	}
+	devset->m_nshards = num_shards;
+
+	uint32_t first_dev = 0;
+	for(uint32_t j = 0; j < num_shards; j++) {
+		struct scap_device_set *shard = &devset->m_shards[j];
+		shard->m_devs = &devset->m_devs[first_dev];
+		shard->m_ndevs = devset->m_ndevs / num_shards + (j < devset->m_ndevs % num_shards ? 1 : 0);
+		shard->m_buffer_empty_wait_time_us = BUFFER_EMPTY_WAIT_TIME_US_START;
+		shard->m_lasterr = lasterr;
+		shard->m_last_devid = DEVSET_NO_DEVICE;
+		relaxed_order_init(&shard->m_relaxed,
+		                   devset->m_relaxed.m_max_batch,
+		                   devset->m_relaxed.m_window_ns);
+		if(!ts_heap_init(&shard->m_heap, shard->m_ndevs)) {
+			return scap_errprintf(lasterr, 0, "error allocating the device heap");
+		}
+		first_dev += shard->m_ndevs;
+	}
+
+	return SCAP_SUCCESS;
 }
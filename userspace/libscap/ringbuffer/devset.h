@@ -27,6 +27,8 @@ limitations under the License.
 #define INVALID_MAPPING MAP_FAILED
 
 #include <libscap/scap_assert.h>
+#include <libscap/ringbuffer/ts_heap.h>
+#include <libscap/ringbuffer/relaxed_order.h>
 
 //
 // Read buffer timeout constants
@@ -65,12 +67,31 @@ struct scap_device_set {
 	uint32_t m_ndevs;
 	uint64_t m_buffer_empty_wait_time_us;
 	char* m_lasterr;
+	struct ts_heap m_heap;  // devices with a non-empty block, ordered by the ts of their next event
+	uint32_t m_last_devid;  // device of the last event we served, `DEVSET_NO_DEVICE` if none
+	struct relaxed_order m_relaxed;  // used instead of `m_heap` if relaxed ordering is enabled
+	struct scap_device_set* m_shards;  // sub-sets of contiguous devices, see `devset_init_shards`
+	uint32_t m_nshards;                // `0` if the devices are not sharded
 };
 
+#define DEVSET_NO_DEVICE UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 int32_t devset_init(struct scap_device_set* devset, size_t num_devs, char* lasterr);
 void devset_close_device(struct scap_device* dev);
 void devset_free(struct scap_device_set* devset);
 
+// Split the devices into `num_shards` sets of contiguous devices that can be consumed by different
+// threads. The shards don't own their devices: they point into `devset->m_devs`.
+int32_t devset_init_shards(struct scap_device_set* devset, uint32_t num_shards, char* lasterr);
+
+#ifdef __cplusplus
+};
+#endif
+
 static inline void devset_munmap(void* addr, size_t size) {
 	if(addr != INVALID_MAPPING) {
 		int ret = munmap(addr, size);
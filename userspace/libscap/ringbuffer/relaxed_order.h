@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Relaxed ordering consumption of per-CPU ring buffers.
+ *
+ * When enabled, the engines don't look for the event with the lowest timestamp across all the
+ * buffers: they drain a batch of events from one buffer and then move to the next one in a
+ * round-robin fashion. A batch ends when:
+ * - `m_max_batch` events have been consumed from the buffer.
+ * - the buffer has no more events ready.
+ * - the next event is more than `m_window_ns` nanoseconds newer than the first event of the batch
+ *   (if `m_window_ns` is not `0`).
+ *
+ * Events are still ordered inside a single buffer but not across buffers. The highest distance
+ * between an event and a newer event served before it is tracked in `m_max_reorder_ns` and exposed
+ * as a metric (`RELAXED_ORDER_MAX_REORDER_NS_NAME`) so that users can judge the trade-off.
+ *
+ * This header is shared between libscap (kmod engine) and libpman (modern ebpf engine), so it must
+ * stay self-contained.
+ */
+
+#define RELAXED_ORDER_MAX_REORDER_NS_NAME "max_reorder_ns"
+
+struct relaxed_order {
+	uint32_t m_max_batch;       // max events consumed from a buffer in a row, `0` means disabled
+	uint64_t m_window_ns;       // max time span of a batch, `0` means no limit
+	uint32_t m_cur;             // buffer we are draining
+	uint32_t m_batch_left;      // events we can still consume from `m_cur` in this batch
+	uint64_t m_batch_start_ts;  // timestamp of the first event of this batch
+	uint64_t m_max_ts;          // highest timestamp served so far
+	uint64_t m_max_reorder_ns;  // highest observed distance between `m_max_ts` and an older event
+};
+
+static inline void relaxed_order_init(struct relaxed_order* ro,
+                                      uint32_t max_batch,
+                                      uint64_t window_ns) {
+	ro->m_max_batch = max_batch;
+	ro->m_window_ns = window_ns;
+	ro->m_cur = 0;
+	ro->m_batch_left = max_batch;
+	ro->m_batch_start_ts = 0;
+	ro->m_max_ts = 0;
+	ro->m_max_reorder_ns = 0;
+}
+
+static inline bool relaxed_order_enabled(const struct relaxed_order* ro) {
+	return ro->m_max_batch != 0;
+}
+
+/* Called with the timestamp of the next event of the buffer we are draining. Returns `true` if
+ * the event belongs to the current batch and must be served, `false` if the batch is over.
+ */
+static inline bool relaxed_order_accept(struct relaxed_order* ro, uint64_t ts) {
+	if(ro->m_batch_left == 0) {
+		return false;
+	}
+
+	if(ro->m_batch_left == ro->m_max_batch) {
+		ro->m_batch_start_ts = ts;
+	} else if(ro->m_window_ns != 0 && ts > ro->m_batch_start_ts &&
+	          ts - ro->m_batch_start_ts > ro->m_window_ns) {
+		return false;
+	}
+
+	ro->m_batch_left--;
+	if(ts < ro->m_max_ts) {
+		if(ro->m_max_ts - ts > ro->m_max_reorder_ns) {
+			ro->m_max_reorder_ns = ro->m_max_ts - ts;
+		}
+	} else {
+		ro->m_max_ts = ts;
+	}
+	return true;
+}
+
+/* Move to the next buffer and start a new batch. */
+static inline void relaxed_order_next_buffer(struct relaxed_order* ro, uint32_t nbufs) {
+	ro->m_cur = (ro->m_cur + 1) % nbufs;
+	ro->m_batch_left = ro->m_max_batch;
+}
@@ -136,9 +136,61 @@ static inline bool are_buffers_empty(struct scap_device_set* devset) {
 	return true;
 }
 
+#ifndef NEXT_EVENT
+#define NEXT_EVENT ringbuffer_next_event
+static inline scap_evt* ringbuffer_next_event(scap_device* dev) {
+	return (scap_evt*)dev->m_sn_next_event;
+}
+#endif
+
+#ifndef ADVANCE_TO_EVT
+#define ADVANCE_TO_EVT ringbuffer_advance_to_evt
+static inline void ringbuffer_advance_to_evt(scap_device* dev, scap_evt* event) {
+	ASSERT(dev->m_sn_len >= event->len);
+	dev->m_sn_len -= event->len;
+	dev->m_sn_next_event += event->len;
+}
+#endif
+
+/* Return the timestamp of the next event in the block of `dev` or `SCAP_FAILURE` if the event
+ * doesn't fit in the block. The caller must check that the block is not empty.
+ */
+static inline int32_t ringbuffer_get_next_ts(struct scap_device_set* devset,
+                                             scap_device* dev,
+                                             uint64_t* ts) {
+	scap_evt* pe = NEXT_EVENT(dev);
+
+	/* if the event length is greater than the remaining size in our block there is
+	 * something wrong! */
+	if(pe->len > dev->m_sn_len) {
+		scap_errprintf(devset->m_lasterr, 0, "scap_next buffer corruption");
+		dump_ringbuffer(dev);
+
+		/* if you get the following assertion, first recompile the driver and `libscap` */
+		ASSERT(false);
+		return SCAP_FAILURE;
+	}
+
+	*ts = pe->ts;
+	return SCAP_SUCCESS;
+}
+
 static inline int32_t refill_read_buffers(struct scap_device_set* devset) {
 	uint32_t j;
 	uint32_t ndevs = devset->m_ndevs;
+	uint64_t ts;
+
+	/* Release the blocks we have entirely consumed but we are still occupying, so that the
+	 * producer can use that space again. Blocks are usually released as soon as we consume them
+	 * in `ringbuffer_next`, this is a catch-all for blocks discarded by
+	 * `ringbuffer_flush_read_buffers`.
+	 */
+	for(j = 0; j < ndevs; j++) {
+		struct scap_device* dev = &(devset->m_devs[j]);
+		if(dev->m_sn_len == 0 && dev->m_lastreadsize > 0) {
+			ADVANCE_TAIL(dev);
+		}
+	}
 
 	if(are_buffers_empty(devset)) {
 		sleep_ms(devset->m_buffer_empty_wait_time_us / 1000);
@@ -149,6 +201,7 @@ static inline int32_t refill_read_buffers(struct scap_device_set* devset) {
 	}
 
 	/* In any case (potentially also after a `sleep`) we refill our buffers */
+	ts_heap_clear(&devset->m_heap);
 	for(j = 0; j < ndevs; j++) {
 		struct scap_device* dev = &(devset->m_devs[j]);
 
@@ -157,27 +210,94 @@ static inline int32_t refill_read_buffers(struct scap_device_set* devset) {
 		if(res != SCAP_SUCCESS) {
 			return res;
 		}
+
+		/* Only devices with something to serve enter the merge. In relaxed ordering mode we
+		 * don't merge the devices at all.
+		 */
+		if(dev->m_sn_len == 0 || relaxed_order_enabled(&devset->m_relaxed)) {
+			continue;
+		}
+
+		if(ringbuffer_get_next_ts(devset, dev, &ts) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+		ts_heap_push(&devset->m_heap, ts, j);
 	}
 
 	/* Return `SCAP_TIMEOUT` after a refill so we can start consuming the new events. */
 	return SCAP_TIMEOUT;
 }
 
-#ifndef NEXT_EVENT
-#define NEXT_EVENT ringbuffer_next_event
-static inline scap_evt* ringbuffer_next_event(scap_device* dev) {
-	return (scap_evt*)dev->m_sn_next_event;
+/* Drop the blocks we have read but not served yet, their consumer positions will be moved at the
+ * next refill. Used when a configuration change makes already collected events stale.
+ */
+static inline void ringbuffer_flush_read_buffers(struct scap_device_set* devset) {
+	uint32_t j;
+
+	for(j = 0; j < devset->m_ndevs; j++) {
+		struct scap_device* dev = &devset->m_devs[j];
+		READBUF(dev, &dev->m_sn_next_event, &dev->m_sn_len);
+		dev->m_sn_len = 0;
+	}
+
+	ts_heap_clear(&devset->m_heap);
+	devset->m_last_devid = DEVSET_NO_DEVICE;
+
+	for(j = 0; j < devset->m_nshards; j++) {
+		ts_heap_clear(&devset->m_shards[j].m_heap);
+		devset->m_shards[j].m_last_devid = DEVSET_NO_DEVICE;
+	}
 }
-#endif
 
-#ifndef ADVANCE_TO_EVT
-#define ADVANCE_TO_EVT ringbuffer_advance_to_evt
-static inline void ringbuffer_advance_to_evt(scap_device* dev, scap_evt* event) {
-	ASSERT(dev->m_sn_len >= event->len);
-	dev->m_sn_len -= event->len;
-	dev->m_sn_next_event += event->len;
+/* Relaxed ordering variant of `ringbuffer_next` (see `relaxed_order.h`): drain a batch of events
+ * from a device block before moving to the next device, without looking at the timestamps of the
+ * other devices.
+ */
+static inline int32_t ringbuffer_next_relaxed(struct scap_device_set* devset,
+                                              scap_evt** pevent,
+                                              uint16_t* pdevid,
+                                              uint32_t* pflags) {
+	struct relaxed_order* ro = &devset->m_relaxed;
+	struct scap_device* dev;
+	uint32_t j;
+	uint64_t ts;
+
+	*pdevid = 65535;
+
+	/* Release the block of the device we served in the previous call if we have consumed it. */
+	if(devset->m_last_devid != DEVSET_NO_DEVICE) {
+		dev = &devset->m_devs[devset->m_last_devid];
+		devset->m_last_devid = DEVSET_NO_DEVICE;
+		if(dev->m_sn_len == 0 && dev->m_lastreadsize > 0) {
+			ADVANCE_TAIL(dev);
+		}
+	}
+
+	/* We visit the device we are draining twice: if its batch is over but all the other blocks
+	 * are empty, it can start a new batch before we refill.
+	 */
+	for(j = 0; j <= devset->m_ndevs; j++) {
+		if(j > 0) {
+			relaxed_order_next_buffer(ro, devset->m_ndevs);
+		}
+		dev = &devset->m_devs[ro->m_cur];
+		if(dev->m_sn_len > 0) {
+			if(ringbuffer_get_next_ts(devset, dev, &ts) != SCAP_SUCCESS) {
+				return SCAP_FAILURE;
+			}
+			if(relaxed_order_accept(ro, ts)) {
+				*pevent = NEXT_EVENT(dev);
+				*pdevid = (uint16_t)ro->m_cur;
+				ADVANCE_TO_EVT(dev, (*pevent));
+				devset->m_last_devid = ro->m_cur;
+				*pflags = 0;
+				return SCAP_SUCCESS;
+			}
+		}
+	}
+
+	return refill_read_buffers(devset);
 }
-#endif
 
 /**
  * \brief Get next event in the ringbuffer
@@ -190,12 +310,16 @@ static inline void ringbuffer_advance_to_evt(scap_device* dev, scap_evt* event)
  * that buffer, and wait for all the other buffer blocks to be read.
  * - When we have consumed all the blocks we are ready to read again a new block for every buffer
  *
+ * The blocks with some data left are kept in a min-heap (`devset->m_heap`) keyed on the timestamp
+ * of their next event. Inside a block the events are already ordered, so after serving an event we
+ * only need to update the key of the block we have just read from: the cost per event is
+ * O(log(ndevs)) instead of a scan over all the devices.
+ *
  * Possible pain points:
  * - if the buffers are not full enough we sleep and this could be dangerous in this situation!
  * - we increase the consumer position only when we have consumed the entire block, but if the block
  *   is huge we could cause several drops.
  * - before refilling a buffer we have to consume all the others!
- * - we perform a lot of cycles but we have to be super fast here!
  *
  * \param pevent [out] where the pointer to the next event gets stored
  * \param pdevid [out] where the device on which the event was received
@@ -206,87 +330,98 @@ static inline int32_t ringbuffer_next(struct scap_device_set* devset,
                                       scap_evt** pevent,
                                       uint16_t* pdevid,
                                       uint32_t* pflags) {
-	uint32_t j;
-	uint64_t min_ts = 0xffffffffffffffffLL;
-	scap_evt* pe = NULL;
-	uint32_t ndevs = devset->m_ndevs;
+	struct ts_heap* heap = &devset->m_heap;
+	struct scap_device* dev;
+	uint32_t devid;
+	uint64_t ts;
+
+	if(relaxed_order_enabled(&devset->m_relaxed)) {
+		return ringbuffer_next_relaxed(devset, pevent, pdevid, pflags);
+	}
 
 	*pdevid = 65535;
 
-	for(j = 0; j < ndevs; j++) {
-		scap_device* dev = &(devset->m_devs[j]);
-
-		/* `dev->m_sn_len` and `dev->m_lastreadsize` initially contain the dimension
-		 * of the full buffer block we have read in `refill_read_buffers`.
-		 * The difference is that `dev->m_sn_len` is decreased at every new event
-		 * that we read while `dev->m_lastreadsize` preserve the block dimension since
-		 * it will be used to move the consumer position in `ADVANCE_TAIL`.
-		 *
-		 * Note that even if we have consumed the entire block for this buffer we don't refill
-		 * it immediately but we wait for all other buffers!
-		 */
+	/* The device we served in the previous call is still on top of the heap: we update it only
+	 * now since the caller could be still using the previous event until this call.
+	 */
+	if(devset->m_last_devid != DEVSET_NO_DEVICE) {
+		dev = &devset->m_devs[devset->m_last_devid];
+		devset->m_last_devid = DEVSET_NO_DEVICE;
+
 		if(dev->m_sn_len == 0) {
-			/* If we don't have data from this ring, but we are
-			 * still occupying, free the resources for the
-			 * producer rather than sitting on them.
+			ts_heap_pop(heap);
+
+			/* We have consumed the entire block read in `refill_read_buffers`, so we free the
+			 * resources for the producer rather than sitting on them.
 			 *
-			 * Please note: this is the unique point in which
-			 * we move the consumer position. We move the consumer
-			 * position only when we have consumed all the block
-			 * previously read in `refill_read_buffers`.
+			 * Please note: this is the unique point in which we move the consumer position
+			 * during the consumption. This could be quite dangerous if we read huge blocks
+			 * because we have to read the entire block before increasing the consumer!
 			 *
-			 * This could be quite dangerous if we read huge blocks
-			 * because we have to read the entire block before increasing
-			 * the consumer!
+			 * `dev->m_lastreadsize` contains the full length of the entire block we have just
+			 * consumed.
 			 *
-			 * `dev->m_lastreadsize` this contains the full length of the entire
-			 * block we have just consumed.
+			 * Note that even if we have consumed the entire block for this buffer we don't refill
+			 * it immediately but we wait for all other buffers!
 			 */
 			if(dev->m_lastreadsize > 0) {
 				ADVANCE_TAIL(dev);
 			}
-
-			continue;
-		}
-
-		/* Get the next event from the block */
-		pe = NEXT_EVENT(dev);
-
-		/* Search the event with the lower timestamp */
-		if(pe->ts < min_ts) {
-			/* if the event length is greater than the remaining size in our block there is
-			 * something wrong! */
-			if(pe->len > dev->m_sn_len) {
-				scap_errprintf(devset->m_lasterr, 0, "scap_next buffer corruption");
-				dump_ringbuffer(dev);
-
-				/* if you get the following assertion, first recompile the driver and `libscap` */
-				ASSERT(false);
+		} else {
+			if(ringbuffer_get_next_ts(devset, dev, &ts) != SCAP_SUCCESS) {
 				return SCAP_FAILURE;
 			}
-
-			*pevent = pe;
-			*pdevid = j;
-			min_ts = pe->ts;
+			ts_heap_replace_top(heap, ts);
 		}
 	}
 
-	if(*pdevid != 65535) {
-		/* Check from which buffer we have read and move the position inside
-		 * the block with `ADVANCE_TO_EVT`
-		 */
-		struct scap_device* dev = &devset->m_devs[*pdevid];
-		ADVANCE_TO_EVT(dev, (*pevent));
-
-		// we don't really store the flags in the ringbuffer anywhere
-		*pflags = 0;
-		return SCAP_SUCCESS;
-	} else {
+	if(ts_heap_empty(heap)) {
 		/* If there are enough new data read again one block for every buffer
 		 * otherwise sleep!
 		 */
 		return refill_read_buffers(devset);
 	}
+
+	/* The top of the heap is the block holding the event with the lowest timestamp, move the
+	 * position inside the block with `ADVANCE_TO_EVT`
+	 */
+	devid = ts_heap_top(heap)->id;
+	dev = &devset->m_devs[devid];
+	*pevent = NEXT_EVENT(dev);
+	*pdevid = (uint16_t)devid;
+	ADVANCE_TO_EVT(dev, (*pevent));
+	devset->m_last_devid = devid;
+
+	// we don't really store the flags in the ringbuffer anywhere
+	*pflags = 0;
+	return SCAP_SUCCESS;
+}
+
+/* Batch variant of `ringbuffer_next`. A block is released to the producer in the call following
+ * the one that served its last event, so the batch stops as soon as it takes the last event of a
+ * block: this way all the events returned stay valid until the next call.
+ */
+static inline int32_t ringbuffer_next_batch(struct scap_device_set* devset,
+                                            scap_evt** pevents,
+                                            uint16_t* pdevids,
+                                            uint32_t* pflags,
+                                            uint32_t max_events,
+                                            uint32_t* pnevents) {
+	int32_t res = SCAP_SUCCESS;
+	uint32_t n = 0;
+
+	while(n < max_events) {
+		res = ringbuffer_next(devset, &pevents[n], &pdevids[n], &pflags[n]);
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+		if(devset->m_devs[pdevids[n++]].m_sn_len == 0) {
+			break;
+		}
+	}
+
+	*pnevents = n;
+	return res;
 }
 
 static inline uint64_t ringbuffer_get_max_buf_used(struct scap_device_set* devset) {
@@ -1,4 +1,12 @@
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct scap_device;
 __attribute__((cold)) void dump_ringbuffer(struct scap_device* dev);
+
+#ifdef __cplusplus
+};
+#endif
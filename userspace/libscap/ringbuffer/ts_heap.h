@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Binary min-heap used to perform the k-way merge of per-CPU ring buffers.
+ *
+ * Every node holds the timestamp of the first event available in a ring buffer (its "head") and
+ * the id of that buffer. The engines keep a node in the heap only for buffers that currently have
+ * an event to serve, so picking the next event in timestamp order is O(1) and updating the buffer
+ * we have just read from is O(log(n_buffers)), instead of scanning all the buffers for every
+ * event.
+ *
+ * Nodes are ordered by `(ts, id)`, so that among events with the same timestamp the buffer with
+ * the lowest id wins: this is the same order the previous linear scan produced.
+ *
+ * This header is shared between libscap (kmod engine) and libpman (modern ebpf engine), so it must
+ * stay self-contained.
+ */
+
+struct ts_heap_node {
+	uint64_t ts;
+	uint32_t id;
+};
+
+struct ts_heap {
+	struct ts_heap_node* m_nodes;
+	uint32_t m_size;
+	uint32_t m_capacity;
+};
+
+static inline bool ts_heap_node_less(const struct ts_heap_node* a, const struct ts_heap_node* b) {
+	return a->ts < b->ts || (a->ts == b->ts && a->id < b->id);
+}
+
+/* Returns `false` if the allocation fails. */
+static inline bool ts_heap_init(struct ts_heap* heap, uint32_t capacity) {
+	heap->m_size = 0;
+	heap->m_capacity = 0;
+	heap->m_nodes = (struct ts_heap_node*)calloc(capacity ? capacity : 1,
+	                                              sizeof(struct ts_heap_node));
+	if(heap->m_nodes == NULL) {
+		return false;
+	}
+	heap->m_capacity = capacity;
+	return true;
+}
+
+static inline void ts_heap_free(struct ts_heap* heap) {
+	free(heap->m_nodes);
+	heap->m_nodes = NULL;
+	heap->m_size = 0;
+	heap->m_capacity = 0;
+}
+
+static inline void ts_heap_clear(struct ts_heap* heap) {
+	heap->m_size = 0;
+}
+
+static inline bool ts_heap_empty(const struct ts_heap* heap) {
+	return heap->m_size == 0;
+}
+
+/* The caller must check that the heap is not empty. */
+static inline const struct ts_heap_node* ts_heap_top(const struct ts_heap* heap) {
+	return &heap->m_nodes[0];
+}
+
+static inline void ts_heap_sift_down(struct ts_heap* heap, uint32_t pos) {
+	struct ts_heap_node* nodes = heap->m_nodes;
+	struct ts_heap_node node = nodes[pos];
+	uint32_t size = heap->m_size;
+
+	for(;;) {
+		uint32_t child = 2 * pos + 1;
+		if(child >= size) {
+			break;
+		}
+		if(child + 1 < size && ts_heap_node_less(&nodes[child + 1], &nodes[child])) {
+			child++;
+		}
+		if(!ts_heap_node_less(&nodes[child], &node)) {
+			break;
+		}
+		nodes[pos] = nodes[child];
+		pos = child;
+	}
+	nodes[pos] = node;
+}
+
+/* Every id must be pushed at most once and the heap never grows beyond its capacity. */
+static inline void ts_heap_push(struct ts_heap* heap, uint64_t ts, uint32_t id) {
+	struct ts_heap_node* nodes = heap->m_nodes;
+	struct ts_heap_node node;
+	uint32_t pos = heap->m_size++;
+
+	node.ts = ts;
+	node.id = id;
+
+	while(pos > 0) {
+		uint32_t parent = (pos - 1) / 2;
+		if(!ts_heap_node_less(&node, &nodes[parent])) {
+			break;
+		}
+		nodes[pos] = nodes[parent];
+		pos = parent;
+	}
+	nodes[pos] = node;
+}
+
+/* Update the timestamp of the top node, this is what we do after consuming an event from the
+ * buffer on top when it still has other events.
+ */
+static inline void ts_heap_replace_top(struct ts_heap* heap, uint64_t ts) {
+	heap->m_nodes[0].ts = ts;
+	ts_heap_sift_down(heap, 0);
+}
+
+/* Remove the top node, this is what we do when the buffer on top has no more events to serve. */
+static inline void ts_heap_pop(struct ts_heap* heap) {
+	if(--heap->m_size > 0) {
+		heap->m_nodes[0] = heap->m_nodes[heap->m_size];
+		ts_heap_sift_down(heap, 0);
+	}
+}
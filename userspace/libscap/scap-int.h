@@ -48,6 +48,13 @@ struct scap {
 
 	uint64_t m_evtcnt;
 
+	// Used by `scap_next_batch` with engines that don't implement `next_batch`: copies of the
+	// events of the last batch and the result to return at the next call, if the last batch was
+	// interrupted by something different from an event.
+	char* m_batch_buf;
+	size_t m_batch_buf_size;
+	int32_t m_batch_res;
+
 	// Function which may be called to log an event
 	falcosecurity_log_fn m_log_fn;
 };
@@ -70,7 +77,7 @@ void scap_free_userlist(scap_userlist* uhandle);
 
 int32_t scap_proc_fill_pidns_start_ts(char* error,
                                       struct scap_threadinfo* tinfo,
-                                      const char* procdirname);
+                                      const int procdirfd);
 
 bool scap_alloc_proclist_info(struct ppm_proclist_info** proclist_p,
                               uint32_t n_entries,
@@ -17,6 +17,8 @@ limitations under the License.
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <libscap/compat/misc.h>
 #include <libscap/scap.h>
@@ -149,6 +151,11 @@ void scap_deinit(scap_t* handle) {
 		handle->m_vtable->close(handle->m_engine);
 		handle->m_vtable->free_handle(handle->m_engine);
 	}
+
+	free(handle->m_batch_buf);
+	handle->m_batch_buf = NULL;
+	handle->m_batch_buf_size = 0;
+	handle->m_batch_res = SCAP_SUCCESS;
 }
 
 void scap_free(scap_t* handle) {
@@ -201,6 +208,12 @@ int32_t scap_next(scap_t* handle, scap_evt** pevent, uint16_t* pdevid, uint32_t*
 	// DEV0 XXXX DEV1 DEV2 <- CPU1 offline
 	int32_t res = SCAP_FAILURE;
 	if(handle && handle->m_vtable) {
+		if(handle->m_batch_res != SCAP_SUCCESS) {
+			// Interruption of the last batch, not returned yet.
+			res = handle->m_batch_res;
+			handle->m_batch_res = SCAP_SUCCESS;
+			return res;
+		}
 		res = handle->m_vtable->next(handle->m_engine, pevent, pdevid, pflags);
 	} else {
 		res = SCAP_FAILURE;
@@ -213,6 +226,119 @@ int32_t scap_next(scap_t* handle, scap_evt** pevent, uint16_t* pdevid, uint32_t*
 	return res;
 }
 
+// Build a batch by calling `next()`: the engine only guarantees that an event is valid until the
+// following call, so we copy the events into `m_batch_buf`.
+static int32_t next_batch_copy(scap_t* handle,
+                               scap_evt** pevents,
+                               uint16_t* pdevids,
+                               uint32_t* pflags,
+                               uint32_t max_events,
+                               uint32_t* pnevents) {
+	size_t used = 0;
+	uint32_t n = 0;
+	int32_t res = SCAP_SUCCESS;
+
+	while(n < max_events) {
+		scap_evt* evt;
+		res = handle->m_vtable->next(handle->m_engine, &evt, &pdevids[n], &pflags[n]);
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+
+		if(used + evt->len > handle->m_batch_buf_size) {
+			size_t new_size = handle->m_batch_buf_size ? handle->m_batch_buf_size * 2 : 64 * 1024;
+			while(used + evt->len > new_size) {
+				new_size *= 2;
+			}
+			char* tmp = realloc(handle->m_batch_buf, new_size);
+			if(tmp == NULL) {
+				res = scap_errprintf(handle->m_lasterr, 0, "error allocating the batch buffer");
+				break;
+			}
+			handle->m_batch_buf = tmp;
+			handle->m_batch_buf_size = new_size;
+		}
+
+		memcpy(handle->m_batch_buf + used, evt, evt->len);
+		// The buffer can move while the batch grows: store offsets, they become pointers below.
+		pevents[n] = (scap_evt*)(uintptr_t)used;
+		used += evt->len;
+		n++;
+	}
+
+	for(uint32_t j = 0; j < n; j++) {
+		pevents[j] = (scap_evt*)(handle->m_batch_buf + (uintptr_t)pevents[j]);
+	}
+
+	*pnevents = n;
+	return res;
+}
+
+int32_t scap_next_batch(scap_t* handle,
+                        scap_evt** pevents,
+                        uint16_t* pdevids,
+                        uint32_t* pflags,
+                        uint32_t max_events,
+                        uint32_t* pnevents) {
+	*pnevents = 0;
+	if(!handle || !handle->m_vtable || max_events == 0) {
+		return SCAP_FAILURE;
+	}
+
+	int32_t res = handle->m_batch_res;
+	if(res != SCAP_SUCCESS) {
+		handle->m_batch_res = SCAP_SUCCESS;
+		return res;
+	}
+
+	if(handle->m_vtable->next_batch) {
+		res = handle->m_vtable->next_batch(handle->m_engine,
+		                                   pevents,
+		                                   pdevids,
+		                                   pflags,
+		                                   max_events,
+		                                   pnevents);
+	} else {
+		res = next_batch_copy(handle, pevents, pdevids, pflags, max_events, pnevents);
+	}
+
+	if(*pnevents == 0) {
+		return res;
+	}
+
+	// The batch was interrupted: return the events we have, the interruption comes next.
+	handle->m_batch_res = res;
+	handle->m_evtcnt += *pnevents;
+	return SCAP_SUCCESS;
+}
+
+uint32_t scap_get_n_shards(scap_t* handle) {
+	if(handle && handle->m_vtable && handle->m_vtable->get_n_shards) {
+		return handle->m_vtable->get_n_shards(handle->m_engine);
+	}
+	return 1;
+}
+
+int32_t scap_next_shard(scap_t* handle,
+                        uint32_t shard,
+                        scap_evt** pevent,
+                        uint16_t* pdevid,
+                        uint32_t* pflags) {
+	if(!handle || !handle->m_vtable) {
+		return SCAP_FAILURE;
+	}
+
+	if(shard >= scap_get_n_shards(handle)) {
+		return scap_errprintf(handle->m_lasterr, 0, "invalid shard %u", shard);
+	}
+
+	// Engines without sharding support have a single shard.
+	if(!handle->m_vtable->next_shard) {
+		return handle->m_vtable->next(handle->m_engine, pevent, pdevid, pflags);
+	}
+	return handle->m_vtable->next_shard(handle->m_engine, shard, pevent, pdevid, pflags);
+}
+
 //
 // Return the number of dropped events for the given handle.
 //
@@ -453,6 +579,23 @@ void scap_fseek(scap_t* handle, uint64_t off) {
 	}
 }
 
+int32_t scap_seek_to_timestamp(scap_t* handle, uint64_t ts) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(!handle->m_vtable->savefile_ops) {
+		return scap_errprintf(handle->m_lasterr, 0, "seeking is supported only in capture mode");
+	}
+
+	int32_t res = handle->m_vtable->savefile_ops->seek_timestamp(handle->m_engine, ts);
+	if(res == SCAP_SUCCESS) {
+		// The interruption of the last batch is not relevant anymore
+		handle->m_batch_res = SCAP_SUCCESS;
+	}
+	return res;
+}
+
 int32_t scap_get_n_tracepoint_hit(scap_t* handle, long* ret) {
 	if(!handle) {
 		return SCAP_FAILURE;
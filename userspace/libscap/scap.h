@@ -559,6 +559,72 @@ uint64_t scap_max_buf_used(scap_t* handle);
 */
 int32_t scap_next(scap_t* handle, scap_evt** pevent, uint16_t* pcpuid, uint32_t* pflags);
 
+/*!
+  \brief Get up to `max_events` events from the given capture instance
+
+  Same as calling \ref scap_next `max_events` times, but the per-call overhead is paid once per
+  batch. The events returned stay valid until the next call to \ref scap_next_batch or
+  \ref scap_next.
+
+  A batch ends early when the capture returns something different from an event (e.g. a
+  timeout): if the batch already has some events they are returned, and the interruption is
+  reported by the next call.
+
+  \param handle Handle to the capture instance.
+  \param pevents [out] Array of `max_events` event pointers, filled with the events.
+  \param pdevids [out] Array of `max_events` elements, filled with the IDs of the devices where
+  the events were captured.
+  \param pflags [out] Array of `max_events` elements, filled with the flags of the events.
+  \param max_events Size of the arrays, must not be 0.
+  \param pnevents [out] Number of events returned.
+
+  \return SCAP_SUCCESS if at least one event is returned, otherwise the same codes as
+  \ref scap_next.
+*/
+int32_t scap_next_batch(scap_t* handle,
+                        scap_evt** pevents,
+                        uint16_t* pdevids,
+                        uint32_t* pflags,
+                        uint32_t max_events,
+                        uint32_t* pnevents);
+
+/*!
+  \brief Return the number of shards the event stream of the given capture is split into.
+
+  Every shard is an independent stream of events, ordered by timestamp, that can be consumed by
+  its own thread through \ref scap_next_shard. Engines without sharding support, or opened
+  without requesting it, have a single shard.
+
+  \param handle Handle to the capture instance.
+*/
+uint32_t scap_get_n_shards(scap_t* handle);
+
+/*!
+  \brief Get the next event of a shard of the given capture instance
+
+  Works like \ref scap_next but only returns the events of the given shard. Different shards can
+  be consumed at the same time from different threads, but a single shard must be consumed by one
+  thread at a time and \ref scap_next must not be used on a sharded capture. Events consumed
+  through this function are not counted by \ref scap_event_get_num. See scap_shard_merge.h to
+  consume the shards in timestamp order from a single thread.
+
+  \param handle Handle to the capture instance.
+  \param shard The shard to consume, lower than \ref scap_get_n_shards.
+  \param pevent [out] User-provided event pointer that will be initialized with address of the
+  event. It stays valid until the next call for the same shard.
+  \param pdevid [out] User-provided event pointer that will be initialized with the ID of the
+  device where the event was captured.
+  \param pflags [out] User-provided event pointer that will be initialized with the flags of the
+  event.
+
+  \return Same as \ref scap_next.
+*/
+int32_t scap_next_shard(scap_t* handle,
+                        uint32_t shard,
+                        scap_evt** pevent,
+                        uint16_t* pdevid,
+                        uint32_t* pflags);
+
 /*!
   \brief Get the length of an event
 
@@ -976,6 +1042,19 @@ int32_t scap_enable_dynamic_snaplen(scap_t* handle);
 int32_t scap_disable_dynamic_snaplen(scap_t* handle);
 uint64_t scap_ftell(scap_t* handle);
 void scap_fseek(scap_t* handle, uint64_t off);
+
+/*!
+  \brief Move the reading of a capture to the events with a timestamp greater
+         or equal to ts, using the index of the capture (see
+         \ref scap_dump_enable_index). The events that are skipped aren't
+         parsed, so the tables of the platform don't reflect them.
+
+  \param handle Handle to the capture instance.
+  \param ts The timestamp of the first event to read.
+  \return SCAP_SUCCESS if the call is successful, SCAP_FAILURE with the
+   error in scap_getlasterr() otherwise (e.g. if the capture has no index).
+*/
+int32_t scap_seek_to_timestamp(scap_t* handle, uint64_t ts);
 int32_t scap_fd_add(scap_threadinfo* tinfo, scap_fdinfo* fdinfo);
 
 int32_t scap_get_n_tracepoint_hit(scap_t* handle, long* ret);
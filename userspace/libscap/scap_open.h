@@ -46,6 +46,7 @@ typedef struct scap_open_args {
 	uint64_t proc_scan_timeout_ms;  //< Timeout in msec, after which so-far-successful scan of /proc
 	                                // should be cut short with success return
 	uint64_t proc_scan_log_interval_ms;  //< Interval for logging progress messages from /proc scan
+	uint32_t proc_scan_threads;          //< Threads scanning /proc, 0 or 1 for a serial scan
 	void* engine_params;                 ///< engine-specific params.
 } scap_open_args;
 
@@ -64,6 +64,18 @@ int32_t scap_proc_get(struct scap_platform* platform, int64_t tid, bool scan_soc
 	return SCAP_FAILURE;
 }
 
+int32_t scap_proc_fetch(struct scap_platform* platform,
+                        struct scap_proclist* proclist,
+                        int64_t tid,
+                        bool scan_sockets,
+                        char* error) {
+	if(platform && platform->m_vtable->fetch_proc) {
+		return platform->m_vtable->fetch_proc(platform, proclist, tid, scan_sockets, error);
+	}
+
+	return scap_errprintf(error, 0, "fetching threads is not supported by this platform");
+}
+
 int32_t scap_refresh_proc_table(struct scap_platform* platform) {
 	if(platform && platform->m_vtable->refresh_proc_table) {
 		return platform->m_vtable->refresh_proc_table(platform, &platform->m_proclist);
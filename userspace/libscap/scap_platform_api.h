@@ -34,6 +34,7 @@ struct scap;
 struct scap_addrlist;
 struct _scap_machine_info;
 struct scap_platform;
+struct scap_proclist;
 struct scap_threadinfo;
 typedef struct _scap_agent_info scap_agent_info;
 
@@ -70,6 +71,15 @@ uint32_t scap_get_device_by_mount_id(struct scap_platform* platform,
 // Get the information about a thread.
 int32_t scap_proc_get(struct scap_platform* platform, int64_t tid, bool scan_sockets);
 
+// Read the information about a thread in `proclist` instead of the platform's own list.
+// It doesn't touch the platform's state, so it can be called from another thread while
+// the capture is running.
+int32_t scap_proc_fetch(struct scap_platform* platform,
+                        struct scap_proclist* proclist,
+                        int64_t tid,
+                        bool scan_sockets,
+                        char* error);
+
 int32_t scap_refresh_proc_table(struct scap_platform* platform);
 
 // Check if the given thread exists in /proc
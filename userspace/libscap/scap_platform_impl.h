@@ -61,6 +61,14 @@ struct scap_platform_vtable {
 
 	int32_t (*get_proc)(struct scap_platform*, int64_t tid, bool scan_sockets);
 
+	// read a thread (and its fds) in `proclist`, using its callbacks: unlike get_proc,
+	// it can run on another thread, concurrently with the capture
+	int32_t (*fetch_proc)(struct scap_platform*,
+	                      struct scap_proclist* proclist,
+	                      int64_t tid,
+	                      bool scan_sockets,
+	                      char* error);
+
 	int32_t (*refresh_proc_table)(struct scap_platform*, struct scap_proclist* proclist);
 	bool (*is_thread_alive)(struct scap_platform*, int64_t pid, int64_t tid, const char* comm);
 	int32_t (*get_global_pid)(struct scap_platform*, int64_t* pid, char* error);
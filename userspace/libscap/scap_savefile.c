@@ -16,10 +16,12 @@ limitations under the License.
 
 */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/uio.h>
 #else
@@ -37,6 +39,10 @@ struct iovec {
 #include <libscap/strl.h>
 #include <libscap/strerror.h>
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 const char *scap_dump_getlasterr(scap_dumper_t *d) {
 	return d ? d->m_lasterr : "null dumper";
 }
@@ -47,11 +53,166 @@ const char *scap_dump_getlasterr(scap_dumper_t *d) {
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifndef _WIN32
+//
+// Write data straight to the file descriptor of a dump file
+//
+static int32_t scap_dump_write_fd(scap_dumper_t *d, const void *buf, size_t len) {
+	const char *pos = buf;
+	while(len > 0) {
+		ssize_t written = write(d->m_fd, pos, len);
+		if(written < 0) {
+			return scap_errprintf(d->m_lasterr, errno, "error writing to file");
+		}
+		pos += written;
+		len -= written;
+	}
+	return SCAP_SUCCESS;
+}
+#endif
+
+#ifdef USE_ZSTD
+//
+// Compresses the data of a dump file with zstd, see scap_dump_open_compressed()
+//
+struct scap_zstd_writer {
+	ZSTD_CCtx *m_cctx;
+	uint8_t *m_in;  // Coalesces the small writes of the blocks
+	size_t m_in_len;
+	size_t m_in_size;
+	uint8_t *m_out;
+	size_t m_out_size;
+	bool m_in_frame;    // Whether data was written since the end of the last frame
+	int64_t m_pos;      // The uncompressed bytes written
+	int64_t m_raw_pos;  // The offset in the file after the compressed bytes written
+};
+
+static void scap_zstd_writer_free(struct scap_zstd_writer *z) {
+	ZSTD_freeCCtx(z->m_cctx);
+	free(z->m_in);
+	free(z->m_out);
+	free(z);
+}
+
+static struct scap_zstd_writer *scap_zstd_writer_open(int fd,
+                                                      const scap_compression_params *params,
+                                                      char *lasterr) {
+	struct scap_zstd_writer *z =
+	        (struct scap_zstd_writer *)calloc(1, sizeof(struct scap_zstd_writer));
+	if(z == NULL) {
+		scap_errprintf(lasterr, 0, "zstd writer allocation failure");
+		return NULL;
+	}
+
+	z->m_cctx = ZSTD_createCCtx();
+	z->m_in_size = ZSTD_CStreamInSize();
+	z->m_in = (uint8_t *)malloc(z->m_in_size);
+	z->m_out_size = ZSTD_CStreamOutSize();
+	z->m_out = (uint8_t *)malloc(z->m_out_size);
+	if(z->m_cctx == NULL || z->m_in == NULL || z->m_out == NULL) {
+		scap_zstd_writer_free(z);
+		scap_errprintf(lasterr, 0, "zstd writer allocation failure");
+		return NULL;
+	}
+
+	// Worker threads compress the data in the background, with the same output
+	size_t res = ZSTD_CCtx_setParameter(z->m_cctx, ZSTD_c_compressionLevel, params->level);
+	if(!ZSTD_isError(res)) {
+		res = ZSTD_CCtx_setParameter(z->m_cctx, ZSTD_c_checksumFlag, 1);
+	}
+	if(!ZSTD_isError(res) && params->workers > 0) {
+		res = ZSTD_CCtx_setParameter(z->m_cctx, ZSTD_c_nbWorkers, (int)params->workers);
+	}
+	if(ZSTD_isError(res)) {
+		scap_errprintf(lasterr, 0, "can't set up zstd: %s", ZSTD_getErrorName(res));
+		scap_zstd_writer_free(z);
+		return NULL;
+	}
+
+	// Like gzoffset(), the offsets include the data already in the file
+	off_t pos = lseek(fd, 0, SEEK_CUR);
+	z->m_raw_pos = pos > 0 ? pos : 0;
+	return z;
+}
+
+//
+// Compress the data of buf, ZSTD_e_continue returns once all of it is consumed,
+// the other modes once the frame is flushed or ended
+//
+static int32_t scap_zstd_compress(scap_dumper_t *d,
+                                  const void *buf,
+                                  size_t len,
+                                  ZSTD_EndDirective mode) {
+	struct scap_zstd_writer *z = d->m_zstd;
+	ZSTD_inBuffer in = {buf, len, 0};
+	size_t remaining;
+	do {
+		ZSTD_outBuffer out = {z->m_out, z->m_out_size, 0};
+		remaining = ZSTD_compressStream2(z->m_cctx, &out, &in, mode);
+		if(ZSTD_isError(remaining)) {
+			return scap_errprintf(d->m_lasterr,
+			                      0,
+			                      "zstd compression error: %s",
+			                      ZSTD_getErrorName(remaining));
+		}
+		if(scap_dump_write_fd(d, z->m_out, out.pos) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+		z->m_raw_pos += out.pos;
+	} while(mode == ZSTD_e_continue ? in.pos < in.size : remaining != 0);
+	return SCAP_SUCCESS;
+}
+
+static int32_t scap_zstd_flush(scap_dumper_t *d, ZSTD_EndDirective mode) {
+	struct scap_zstd_writer *z = d->m_zstd;
+	// Ending a frame without data would start an empty one
+	if(!z->m_in_frame) {
+		return SCAP_SUCCESS;
+	}
+	int32_t res = scap_zstd_compress(d, z->m_in, z->m_in_len, mode);
+	z->m_in_len = 0;
+	if(mode == ZSTD_e_end) {
+		z->m_in_frame = false;
+	}
+	return res;
+}
+
+static int scap_zstd_write(scap_dumper_t *d, const void *buf, unsigned len) {
+	struct scap_zstd_writer *z = d->m_zstd;
+	if(z->m_in_len + len > z->m_in_size && scap_zstd_flush(d, ZSTD_e_continue) != SCAP_SUCCESS) {
+		return -1;
+	}
+	if(len >= z->m_in_size) {
+		if(scap_zstd_compress(d, buf, len, ZSTD_e_continue) != SCAP_SUCCESS) {
+			return -1;
+		}
+	} else {
+		memcpy(z->m_in + z->m_in_len, buf, len);
+		z->m_in_len += len;
+	}
+	z->m_in_frame = true;
+	z->m_pos += len;
+	return len;
+}
+#else
+static struct scap_zstd_writer *scap_zstd_writer_open(int fd,
+                                                      const scap_compression_params *params,
+                                                      char *lasterr) {
+	scap_errprintf(lasterr, 0, "zstd compression is not supported by this build");
+	return NULL;
+}
+#endif
+
 //
 // Write data into a dump file
 //
 static int scap_dump_write(scap_dumper_t *d, void *buf, unsigned len) {
 	if(d->m_type == DT_FILE) {
+#ifdef USE_ZSTD
+		if(d->m_zstd != NULL) {
+			return scap_zstd_write(d, buf, len);
+		}
+#endif
 		return gzwrite(d->m_f, buf, len);
 	} else {
 		if(d->m_targetbufcurpos + len >= d->m_targetbufend) {
@@ -97,6 +258,17 @@ static int scap_dump_writev(scap_dumper_t *d, const struct iovec *iov, int iovcn
 	return totlen;
 }
 
+//
+// The chunks of events of a dump file, see scap_dump_enable_index()
+//
+struct scap_dump_index {
+	uint32_t m_chunk_events;
+	uint64_t m_chunk_bytes;
+	index_block_entry *m_entries;
+	uint32_t m_nentries;
+	uint32_t m_size;
+};
+
 uint8_t *scap_get_memorydumper_curpos(scap_dumper_t *d) {
 	return d->m_targetbufcurpos;
 }
@@ -1012,19 +1184,29 @@ static int32_t scap_setup_dump(scap_dumper_t *d,
 }
 
 // fname is only used for log messages in scap_setup_dump
-static scap_dumper_t *scap_dump_open_gzfile(struct scap_platform *platform,
-                                            gzFile gzfile,
-                                            const char *fname,
-                                            char *lasterr) {
+static scap_dumper_t *scap_dump_open_file(struct scap_platform *platform,
+                                          gzFile gzfile,
+                                          struct scap_zstd_writer *zstd,
+                                          int fd,
+                                          const char *fname,
+                                          char *lasterr) {
 	scap_dumper_t *res = (scap_dumper_t *)malloc(sizeof(scap_dumper_t));
 	res->m_f = gzfile;
+	res->m_fd = fd;
+	res->m_zstd = zstd;
 	res->m_type = DT_FILE;
 	res->m_targetbuf = NULL;
 	res->m_targetbufcurpos = NULL;
 	res->m_targetbufend = NULL;
+	res->m_index = NULL;
 
 	if(scap_setup_dump(res, platform, fname) != SCAP_SUCCESS) {
 		scap_errprintf(lasterr, 0, "%s", res->m_lasterr);
+#ifdef USE_ZSTD
+		if(zstd != NULL) {
+			scap_zstd_writer_free(zstd);
+		}
+#endif
 		free(res);
 		res = NULL;
 	}
@@ -1032,6 +1214,37 @@ static scap_dumper_t *scap_dump_open_gzfile(struct scap_platform *platform,
 	return res;
 }
 
+//
+// Check the compression settings, and get the gzdopen() mode for zlib
+//
+static int32_t scap_dump_gzmode(const scap_compression_params *params,
+                                char *mode,
+                                size_t mode_size,
+                                char *lasterr) {
+	switch(params->mode) {
+	case SCAP_COMPRESSION_GZIP:
+		if(params->level < 0 || params->level > 9) {
+			return scap_errprintf(lasterr, 0, "invalid gzip level %d", params->level);
+		}
+		if(params->level > 0) {
+			snprintf(mode, mode_size, "wb%d", params->level);
+		} else {
+			strlcpy(mode, "wb", mode_size);
+		}
+		return SCAP_SUCCESS;
+	case SCAP_COMPRESSION_NONE:
+		strlcpy(mode, "wbT", mode_size);
+		return SCAP_SUCCESS;
+	case SCAP_COMPRESSION_ZSTD:
+		// Not written with zlib
+		mode[0] = '\0';
+		return SCAP_SUCCESS;
+	default:
+		ASSERT(false);
+		return scap_errprintf(lasterr, 0, "invalid compression mode");
+	}
+}
+
 //
 // Open a "savefile" for writing.
 //
@@ -1039,20 +1252,20 @@ scap_dumper_t *scap_dump_open(struct scap_platform *platform,
                               const char *fname,
                               compression_mode compress,
                               char *lasterr) {
+	scap_compression_params params = {compress, 0, 0};
+	return scap_dump_open_compressed(platform, fname, &params, lasterr);
+}
+
+scap_dumper_t *scap_dump_open_compressed(struct scap_platform *platform,
+                                         const char *fname,
+                                         const scap_compression_params *params,
+                                         char *lasterr) {
 	gzFile f = NULL;
+	struct scap_zstd_writer *zstd = NULL;
 	int fd = -1;
-	const char *mode;
+	char mode[8];
 
-	switch(compress) {
-	case SCAP_COMPRESSION_GZIP:
-		mode = "wb";
-		break;
-	case SCAP_COMPRESSION_NONE:
-		mode = "wbT";
-		break;
-	default:
-		ASSERT(false);
-		scap_errprintf(lasterr, 0, "invalid compression mode");
+	if(scap_dump_gzmode(params, mode, sizeof(mode), lasterr) != SCAP_SUCCESS) {
 		return NULL;
 	}
 
@@ -1062,26 +1275,40 @@ scap_dumper_t *scap_dump_open(struct scap_platform *platform,
 #else
 		fd = 1;
 #endif
-		if(fd != -1) {
+		fname = "standard output";
+	} else {
+#ifndef _WIN32
+		// keep the fd, to write the index of compressed files
+		fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+#else
+		if(params->mode != SCAP_COMPRESSION_ZSTD) {
+			f = gzopen(fname, mode);
+		}
+#endif
+	}
+
+	if(fd != -1) {
+		if(params->mode == SCAP_COMPRESSION_ZSTD) {
+			zstd = scap_zstd_writer_open(fd, params, lasterr);
+		} else {
 			f = gzdopen(fd, mode);
-			fname = "standard output";
 		}
-	} else {
-		f = gzopen(fname, mode);
 	}
 
-	if(f == NULL) {
+	if(f == NULL && zstd == NULL) {
 #ifndef _WIN32
 		if(fd != -1) {
 			close(fd);
 		}
 #endif
 
-		scap_errprintf(lasterr, 0, "can't open %s", fname);
+		if(params->mode != SCAP_COMPRESSION_ZSTD || fd == -1) {
+			scap_errprintf(lasterr, 0, "can't open %s", fname);
+		}
 		return NULL;
 	}
 
-	return scap_dump_open_gzfile(platform, f, fname, lasterr);
+	return scap_dump_open_file(platform, f, zstd, fd, fname, lasterr);
 }
 
 //
@@ -1091,27 +1318,37 @@ scap_dumper_t *scap_dump_open_fd(struct scap_platform *platform,
                                  compression_mode compress,
                                  bool skip_proc_scan,
                                  char *lasterr) {
+	scap_compression_params params = {compress, 0, 0};
+	return scap_dump_open_fd_compressed(platform, fd, &params, skip_proc_scan, lasterr);
+}
+
+scap_dumper_t *scap_dump_open_fd_compressed(struct scap_platform *platform,
+                                            int fd,
+                                            const scap_compression_params *params,
+                                            bool skip_proc_scan,
+                                            char *lasterr) {
 	gzFile f = NULL;
+	struct scap_zstd_writer *zstd = NULL;
+	char mode[8];
 
-	switch(compress) {
-	case SCAP_COMPRESSION_GZIP:
-		f = gzdopen(fd, "wb");
-		break;
-	case SCAP_COMPRESSION_NONE:
-		f = gzdopen(fd, "wbT");
-		break;
-	default:
-		ASSERT(false);
-		scap_errprintf(lasterr, 0, "invalid compression mode");
+	if(scap_dump_gzmode(params, mode, sizeof(mode), lasterr) != SCAP_SUCCESS) {
 		return NULL;
 	}
 
-	if(f == NULL) {
-		scap_errprintf(lasterr, 0, "can't open fd %d", fd);
-		return NULL;
+	if(params->mode == SCAP_COMPRESSION_ZSTD) {
+		zstd = scap_zstd_writer_open(fd, params, lasterr);
+		if(zstd == NULL) {
+			return NULL;
+		}
+	} else {
+		f = gzdopen(fd, mode);
+		if(f == NULL) {
+			scap_errprintf(lasterr, 0, "can't open fd %d", fd);
+			return NULL;
+		}
 	}
 
-	return scap_dump_open_gzfile(platform, f, "", lasterr);
+	return scap_dump_open_file(platform, f, zstd, fd, "", lasterr);
 }
 
 //
@@ -1128,10 +1365,13 @@ scap_dumper_t *scap_memory_dump_open(struct scap_platform *platform,
 	}
 
 	res->m_f = NULL;
+	res->m_fd = -1;
+	res->m_zstd = NULL;
 	res->m_type = DT_MEM;
 	res->m_targetbuf = targetbuf;
 	res->m_targetbufcurpos = targetbuf;
 	res->m_targetbufend = targetbuf + targetbufsize;
+	res->m_index = NULL;
 
 	if(scap_setup_dump(res, platform, "") != SCAP_SUCCESS) {
 		scap_errprintf(lasterr, 0, "%s", res->m_lasterr);
@@ -1152,20 +1392,126 @@ scap_dumper_t *scap_managedbuf_dump_create() {
 	}
 
 	res->m_f = NULL;
+	res->m_fd = -1;
+	res->m_zstd = NULL;
 	res->m_type = DT_MANAGED_BUF;
 	res->m_targetbuf = (uint8_t *)malloc(PPM_DUMPER_MANAGED_BUF_SIZE);
 	res->m_targetbufcurpos = res->m_targetbuf;
 	res->m_targetbufend = res->m_targetbuf + PPM_DUMPER_MANAGED_BUF_SIZE;
+	res->m_index = NULL;
 
 	return res;
 }
 
+//
+// Whether the data of a dump file is compressed
+//
+static bool scap_dump_compressed(scap_dumper_t *d) {
+	return d->m_zstd != NULL || !gzdirect(d->m_f);
+}
+
+//
+// Terminate the current gzip stream or zstd frame, the next data starts a new one
+//
+static int32_t scap_dump_end_stream(scap_dumper_t *d) {
+#ifdef USE_ZSTD
+	if(d->m_zstd != NULL) {
+		return scap_zstd_flush(d, ZSTD_e_end);
+	}
+#endif
+	if(gzflush(d->m_f, Z_FINISH) != Z_OK) {
+		return scap_errprintf(d->m_lasterr, 0, "error writing to file (8)");
+	}
+	return SCAP_SUCCESS;
+}
+
+//
+// Return the offset in the file of the (compressed) data written so far
+//
+static int64_t scap_dump_raw_offset(scap_dumper_t *d) {
+#ifdef USE_ZSTD
+	if(d->m_zstd != NULL) {
+		return d->m_zstd->m_raw_pos;
+	}
+#endif
+	return gzoffset(d->m_f);
+}
+
+//
+// Write the index block at the end of the file
+//
+static int32_t scap_dump_write_index(scap_dumper_t *d) {
+	struct scap_dump_index *idx = d->m_index;
+	uint32_t entry_len = sizeof(index_block_entry);
+	block_header bh;
+	uint32_t bt;
+
+	bh.block_type = IDX_BLOCK_TYPE;
+	bh.block_total_length =
+	        sizeof(block_header) + sizeof(entry_len) + idx->m_nentries * entry_len + 4;
+	bt = bh.block_total_length;
+
+	struct iovec iov[] = {
+	        {&bh, sizeof(bh)},
+	        {&entry_len, sizeof(entry_len)},
+	        {idx->m_entries, idx->m_nentries * entry_len},
+	        {&bt, sizeof(bt)},
+	};
+	int iovcnt = sizeof(iov) / sizeof(iov[0]);
+
+	if(!scap_dump_compressed(d)) {
+		if(scap_dump_writev(d, iov, iovcnt) != (int)bt) {
+			return scap_errprintf(d->m_lasterr, 0, "error writing the index");
+		}
+		return SCAP_SUCCESS;
+	}
+
+#ifndef _WIN32
+	// Terminate the compressed stream, the block is appended uncompressed
+	if(scap_dump_end_stream(d) != SCAP_SUCCESS) {
+		return SCAP_FAILURE;
+	}
+
+	// zstd decoders only skip the data of skippable frames, the capture still
+	// ends with the trailer of the block
+	if(d->m_zstd != NULL) {
+		uint32_t frame_header[2] = {ZSTD_MAGIC_SKIPPABLE_START, bt};
+		if(scap_dump_write_fd(d, frame_header, sizeof(frame_header)) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+	}
+
+	for(int i = 0; i < iovcnt; i++) {
+		if(scap_dump_write_fd(d, iov[i].iov_base, iov[i].iov_len) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+	}
+	return SCAP_SUCCESS;
+#else
+	return scap_errprintf(d->m_lasterr, 0, "can't index compressed files");
+#endif
+}
+
 //
 // Close a "savefile" opened with scap_dump_open
 //
 void scap_dump_close(scap_dumper_t *d) {
 	if(d->m_type == DT_FILE) {
-		gzclose(d->m_f);
+		if(d->m_index != NULL) {
+			scap_dump_write_index(d);
+			free(d->m_index->m_entries);
+			free(d->m_index);
+		}
+#ifdef USE_ZSTD
+		if(d->m_zstd != NULL) {
+			scap_dump_end_stream(d);
+			scap_zstd_writer_free(d->m_zstd);
+			close(d->m_fd);
+		}
+#endif
+		if(d->m_f != NULL) {
+			gzclose(d->m_f);
+		}
 	} else if(d->m_type == DT_MANAGED_BUF) {
 		free(d->m_targetbuf);
 	}
@@ -1178,7 +1524,7 @@ void scap_dump_close(scap_dumper_t *d) {
 //
 int64_t scap_dump_get_offset(scap_dumper_t *d) {
 	if(d->m_type == DT_FILE) {
-		return gzoffset(d->m_f);
+		return scap_dump_raw_offset(d);
 	} else {
 		return (int64_t)d->m_targetbufcurpos - (int64_t)d->m_targetbuf;
 	}
@@ -1186,6 +1532,11 @@ int64_t scap_dump_get_offset(scap_dumper_t *d) {
 
 int64_t scap_dump_ftell(scap_dumper_t *d) {
 	if(d->m_type == DT_FILE) {
+#ifdef USE_ZSTD
+		if(d->m_zstd != NULL) {
+			return d->m_zstd->m_pos;
+		}
+#endif
 		return gztell(d->m_f);
 	} else {
 		return (int64_t)d->m_targetbufcurpos - (int64_t)d->m_targetbuf;
@@ -1194,10 +1545,96 @@ int64_t scap_dump_ftell(scap_dumper_t *d) {
 
 void scap_dump_flush(scap_dumper_t *d) {
 	if(d->m_type == DT_FILE) {
+#ifdef USE_ZSTD
+		if(d->m_zstd != NULL) {
+			scap_zstd_flush(d, ZSTD_e_flush);
+			return;
+		}
+#endif
 		gzflush(d->m_f, Z_FULL_FLUSH);
 	}
 }
 
+int32_t scap_dump_enable_index(scap_dumper_t *d, uint32_t chunk_events, uint64_t chunk_bytes) {
+	if(d->m_type != DT_FILE) {
+		return scap_errprintf(d->m_lasterr, 0, "only files can be indexed");
+	}
+
+	if(chunk_events == 0 && chunk_bytes == 0) {
+		return scap_errprintf(d->m_lasterr, 0, "the chunks of the index need a size limit");
+	}
+
+	if(scap_dump_compressed(d)) {
+#ifndef _WIN32
+		// The offsets of the compressed streams in the file are needed
+		if(d->m_fd < 0 || lseek(d->m_fd, 0, SEEK_CUR) < 0) {
+			return scap_errprintf(d->m_lasterr,
+			                      0,
+			                      "compressed captures can only be indexed in seekable files");
+		}
+#else
+		return scap_errprintf(d->m_lasterr, 0, "can't index compressed files");
+#endif
+	}
+
+	if(d->m_index == NULL) {
+		d->m_index = (struct scap_dump_index *)calloc(1, sizeof(struct scap_dump_index));
+		if(d->m_index == NULL) {
+			return scap_errprintf(d->m_lasterr, 0, "index allocation failure");
+		}
+	}
+
+	d->m_index->m_chunk_events = chunk_events;
+	d->m_index->m_chunk_bytes = chunk_bytes;
+	return SCAP_SUCCESS;
+}
+
+//
+// Account an event in the index, starting a new chunk when the current one is full
+//
+static int32_t scap_dump_index_event(scap_dumper_t *d, uint64_t ts) {
+	struct scap_dump_index *idx = d->m_index;
+	index_block_entry *chunk = idx->m_nentries > 0 ? &idx->m_entries[idx->m_nentries - 1] : NULL;
+
+	if(chunk == NULL || (idx->m_chunk_events != 0 && chunk->nevents >= idx->m_chunk_events) ||
+	   (idx->m_chunk_bytes != 0 &&
+	    (uint64_t)scap_dump_ftell(d) - chunk->offset >= idx->m_chunk_bytes)) {
+		if(idx->m_nentries == idx->m_size) {
+			uint32_t size = idx->m_size > 0 ? idx->m_size * 2 : 64;
+			index_block_entry *entries =
+			        (index_block_entry *)realloc(idx->m_entries, size * sizeof(index_block_entry));
+			if(entries == NULL) {
+				return scap_errprintf(d->m_lasterr, 0, "index allocation failure");
+			}
+			idx->m_entries = entries;
+			idx->m_size = size;
+		}
+
+		// In compressed files each chunk is a gzip stream or zstd frame, so that
+		// it can be decompressed without the previous ones
+		bool compressed = scap_dump_compressed(d);
+		if(compressed && scap_dump_end_stream(d) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+
+		chunk = &idx->m_entries[idx->m_nentries++];
+		chunk->offset = scap_dump_ftell(d);
+		chunk->raw_offset = compressed ? scap_dump_raw_offset(d) : chunk->offset;
+		chunk->min_ts = ts;
+		chunk->max_ts = ts;
+		chunk->nevents = 0;
+	}
+
+	if(ts < chunk->min_ts) {
+		chunk->min_ts = ts;
+	}
+	if(ts > chunk->max_ts) {
+		chunk->max_ts = ts;
+	}
+	chunk->nevents++;
+	return SCAP_SUCCESS;
+}
+
 //
 // Write an event to a dump file
 //
@@ -1206,6 +1643,10 @@ int32_t scap_dump(scap_dumper_t *d, scap_evt *e, uint16_t cpuid, uint32_t flags)
 	uint32_t bt;
 	bool large_payload = flags & SCAP_DF_LARGE;
 
+	if(d->m_index != NULL && scap_dump_index_event(d, e->ts) != SCAP_SUCCESS) {
+		return SCAP_FAILURE;
+	}
+
 	flags &= ~SCAP_DF_LARGE;
 	if(flags == 0) {
 		//
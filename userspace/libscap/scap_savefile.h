@@ -160,4 +160,22 @@ typedef struct _section_header_block {
 
 #define EVF_BLOCK_TYPE_V2_LARGE 0x222
 
+///////////////////////////////////////////////////////////////////////////////
+// INDEX BLOCK
+///////////////////////////////////////////////////////////////////////////////
+// Optional, follows all the event blocks and splits them in chunks that can be
+// read on their own. Readers find it through the block length at the end of
+// the file. In gzip captures each chunk is a separate gzip member, and the
+// block is not compressed: it comes after the gzip data, which zlib ignores.
+// The body holds the size of the entries (uint32_t) and the entries, in order.
+#define IDX_BLOCK_TYPE 0x223
+
+typedef struct _index_block_entry {
+	uint64_t offset;      // Uncompressed offset of the first event block of the chunk
+	uint64_t raw_offset;  // Offset of the gzip member of the chunk, `offset` if not compressed
+	uint64_t min_ts;      // Lowest timestamp of the events in the chunk
+	uint64_t max_ts;      // Highest timestamp of the events in the chunk
+	uint32_t nevents;     // Number of events in the chunk
+} index_block_entry;
+
 #pragma pack(pop)
@@ -39,12 +39,18 @@ typedef enum ppm_dumper_type {
 #define PPM_DUMPER_MANAGED_BUF_SIZE (3 * 1024 * 1024)
 #define PPM_DUMPER_MANAGED_BUF_RESIZE_FACTOR (1.25)
 
+struct scap_dump_index;
+struct scap_zstd_writer;
+
 typedef struct scap_dumper {
 	gzFile m_f;
+	int m_fd;                         // The file descriptor of m_f, when known
+	struct scap_zstd_writer *m_zstd;  // Compresses the data to m_fd instead of m_f, if set
 	ppm_dumper_type m_type;
 	uint8_t *m_targetbuf;
 	uint8_t *m_targetbufcurpos;
 	uint8_t *m_targetbufend;
+	struct scap_dump_index *m_index;  // The chunks written so far, if indexing
 	char m_lasterr[SCAP_LASTERR_SIZE];
 } scap_dumper_t;
 
@@ -57,9 +63,19 @@ struct iovec;
 */
 typedef enum compression_mode {
 	SCAP_COMPRESSION_NONE = 0,
-	SCAP_COMPRESSION_GZIP = 1
+	SCAP_COMPRESSION_GZIP = 1,
+	SCAP_COMPRESSION_ZSTD = 2
 } compression_mode;
 
+/*!
+  \brief The compression settings used when writing a tracefile
+*/
+typedef struct scap_compression_params {
+	compression_mode mode;
+	int level;         // The compression level, 0 for the default of the algorithm
+	uint32_t workers;  // The number of compression threads (zstd only), 0 for none
+} scap_compression_params;
+
 uint8_t *scap_get_memorydumper_curpos(scap_dumper_t *d);
 int32_t scap_write_proc_fds(scap_dumper_t *d, struct scap_threadinfo *tinfo);
 scap_dumper_t *scap_write_proclist_begin();
@@ -115,6 +131,35 @@ scap_dumper_t *scap_dump_open_fd(struct scap_platform *platform,
                                  bool skip_proc_scan,
                                  char *lasterr);
 
+/*!
+  \brief Open a trace file for writing, with the given compression settings.
+
+  \param handle Handle to the capture instance.
+  \param fname The name of the trace file.
+  \param params The compression settings.
+
+  \return Dump handle that can be used to identify this specific dump instance.
+*/
+scap_dumper_t *scap_dump_open_compressed(struct scap_platform *platform,
+                                         const char *fname,
+                                         const scap_compression_params *params,
+                                         char *lasterr);
+
+/*!
+  \brief Open a trace file for writing, using the provided fd and compression settings.
+
+  \param handle Handle to the capture instance.
+  \param fd A file descriptor to which the dumper will write
+  \param params The compression settings.
+
+  \return Dump handle that can be used to identify this specific dump instance.
+*/
+scap_dumper_t *scap_dump_open_fd_compressed(struct scap_platform *platform,
+                                            int fd,
+                                            const scap_compression_params *params,
+                                            bool skip_proc_scan,
+                                            char *lasterr);
+
 /*!
   \brief Close a trace file.
 
@@ -146,6 +191,23 @@ int64_t scap_dump_ftell(scap_dumper_t *d);
 */
 void scap_dump_flush(scap_dumper_t *d);
 
+/*!
+  \brief Add an index to a trace file, to seek through it by timestamp (see
+         \ref scap_seek_to_timestamp). The events are split in chunks, each
+         one starting a new gzip stream in compressed files, and the index of
+         the chunks is written when closing the file.
+
+  \param d The dump handle, returned by \ref scap_dump_open
+  \param chunk_events The max number of events in a chunk, 0 for no limit.
+  \param chunk_bytes The max (uncompressed) size of a chunk, 0 for no limit.
+  \return SCAP_SUCCESS if the call is successful.
+   On Failure, SCAP_FAILURE is returned and scap_dump_getlasterr() can be used to obtain
+   the cause of the error.
+  \note Must be called before writing the events. Compressed trace files must
+   be written to a seekable file.
+*/
+int32_t scap_dump_enable_index(scap_dumper_t *d, uint32_t chunk_events, uint64_t chunk_bytes);
+
 /*!
   \brief Write an event to a trace file
 
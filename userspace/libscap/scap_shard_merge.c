@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <stdlib.h>
+
+#include <libscap/scap.h>
+#include <libscap/scap_shard_merge.h>
+
+#define SHARD_MERGE_NO_STREAM UINT32_MAX
+
+static int32_t next_from_handle(void* ctx,
+                                uint32_t stream,
+                                scap_evt** pevent,
+                                uint16_t* pdevid,
+                                uint32_t* pflags) {
+	return scap_next_shard((scap_t*)ctx, stream, pevent, pdevid, pflags);
+}
+
+int32_t scap_shard_merge_init(scap_shard_merge* merge,
+                              uint32_t nstreams,
+                              scap_shard_merge_next_fn next,
+                              void* ctx) {
+	merge->m_next = next;
+	merge->m_ctx = ctx;
+	merge->m_nstreams = nstreams;
+	merge->m_neof = 0;
+	merge->m_last = SHARD_MERGE_NO_STREAM;
+
+	merge->m_streams = (struct scap_shard_merge_stream*)calloc(
+	        nstreams ? nstreams : 1,
+	        sizeof(struct scap_shard_merge_stream));
+	if(merge->m_streams == NULL) {
+		return SCAP_FAILURE;
+	}
+
+	if(!ts_heap_init(&merge->m_heap, nstreams)) {
+		free(merge->m_streams);
+		merge->m_streams = NULL;
+		return SCAP_FAILURE;
+	}
+	return SCAP_SUCCESS;
+}
+
+int32_t scap_shard_merge_init_handle(scap_shard_merge* merge, struct scap* handle) {
+	return scap_shard_merge_init(merge, scap_get_n_shards(handle), next_from_handle, handle);
+}
+
+void scap_shard_merge_free(scap_shard_merge* merge) {
+	free(merge->m_streams);
+	merge->m_streams = NULL;
+	ts_heap_free(&merge->m_heap);
+}
+
+// Ask a stream for its next event and, if there is one, add the stream to the heap.
+static int32_t poll_stream(scap_shard_merge* merge, uint32_t id) {
+	struct scap_shard_merge_stream* stream = &merge->m_streams[id];
+	int32_t res =
+	        merge->m_next(merge->m_ctx, id, &stream->m_evt, &stream->m_devid, &stream->m_flags);
+	switch(res) {
+	case SCAP_SUCCESS:
+		ts_heap_push(&merge->m_heap, stream->m_evt->ts, id);
+		return SCAP_SUCCESS;
+	case SCAP_EOF:
+		stream->m_eof = true;
+		merge->m_neof++;
+		return SCAP_SUCCESS;
+	case SCAP_TIMEOUT:
+		return SCAP_SUCCESS;
+	default:
+		return res;
+	}
+}
+
+int32_t scap_shard_merge_next(scap_shard_merge* merge,
+                              scap_evt** pevent,
+                              uint16_t* pdevid,
+                              uint32_t* pflags) {
+	int32_t res;
+
+	// The event we served in the previous call has been consumed, we can move its stream forward.
+	if(merge->m_last != SHARD_MERGE_NO_STREAM) {
+		uint32_t last = merge->m_last;
+		merge->m_last = SHARD_MERGE_NO_STREAM;
+		res = poll_stream(merge, last);
+		if(res != SCAP_SUCCESS) {
+			return res;
+		}
+	}
+
+	// All the streams are drained: poll every one of them before giving up.
+	if(ts_heap_empty(&merge->m_heap)) {
+		for(uint32_t j = 0; j < merge->m_nstreams; j++) {
+			if(merge->m_streams[j].m_eof) {
+				continue;
+			}
+			res = poll_stream(merge, j);
+			if(res != SCAP_SUCCESS) {
+				return res;
+			}
+		}
+
+		if(ts_heap_empty(&merge->m_heap)) {
+			return merge->m_neof == merge->m_nstreams ? SCAP_EOF : SCAP_TIMEOUT;
+		}
+	}
+
+	uint32_t id = ts_heap_top(&merge->m_heap)->id;
+	struct scap_shard_merge_stream* stream = &merge->m_streams[id];
+	ts_heap_pop(&merge->m_heap);
+	merge->m_last = id;
+
+	*pevent = stream->m_evt;
+	*pdevid = stream->m_devid;
+	*pflags = stream->m_flags;
+	return SCAP_SUCCESS;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <libscap/ringbuffer/ts_heap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct scap;
+typedef struct ppm_evt_hdr scap_evt;
+
+/*!
+  \brief Merge of independent event streams (e.g. the shards of a capture, see
+  \ref scap_next_shard) into a single stream ordered by timestamp.
+
+  The merge keeps at most one event per stream: an event returned by a stream stays valid until
+  the merge asks the same stream for the next one, which only happens after the event has been
+  returned to the caller.
+
+  The streams that have no event ready are polled again only when all the other streams have
+  been drained, as the ring buffer engines do with their per-CPU buffers: the order is the same
+  one \ref scap_next provides on a non-sharded capture.
+*/
+
+/*!
+  \brief Pull the next event of a stream, same return values as \ref scap_next.
+*/
+typedef int32_t (*scap_shard_merge_next_fn)(void* ctx,
+                                            uint32_t stream,
+                                            scap_evt** pevent,
+                                            uint16_t* pdevid,
+                                            uint32_t* pflags);
+
+struct scap_shard_merge_stream {
+	scap_evt* m_evt;  // last event returned by the stream
+	uint16_t m_devid;
+	uint32_t m_flags;
+	bool m_eof;
+};
+
+typedef struct scap_shard_merge {
+	scap_shard_merge_next_fn m_next;
+	void* m_ctx;
+	struct scap_shard_merge_stream* m_streams;
+	uint32_t m_nstreams;
+	uint32_t m_neof;        // number of streams that returned `SCAP_EOF`
+	uint32_t m_last;        // stream of the last event we served, `UINT32_MAX` if none
+	struct ts_heap m_heap;  // streams with an event ready, ordered by its timestamp
+} scap_shard_merge;
+
+/*!
+  \brief Initialize a merge of `nstreams` streams, read through `next`.
+
+  \return SCAP_SUCCESS, or SCAP_FAILURE if the allocation fails.
+*/
+int32_t scap_shard_merge_init(scap_shard_merge* merge,
+                              uint32_t nstreams,
+                              scap_shard_merge_next_fn next,
+                              void* ctx);
+
+/*!
+  \brief Initialize a merge of all the shards of a capture.
+*/
+int32_t scap_shard_merge_init_handle(scap_shard_merge* merge, struct scap* handle);
+
+/*!
+  \brief Get the next event in timestamp order.
+
+  \return SCAP_SUCCESS if an event is returned, SCAP_TIMEOUT if no stream has an event ready,
+  SCAP_EOF when all the streams returned SCAP_EOF and the failure code of a stream if it fails.
+*/
+int32_t scap_shard_merge_next(scap_shard_merge* merge,
+                              scap_evt** pevent,
+                              uint16_t* pdevid,
+                              uint32_t* pflags);
+
+void scap_shard_merge_free(scap_shard_merge* merge);
+
+#ifdef __cplusplus
+};
+#endif
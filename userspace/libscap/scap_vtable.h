@@ -98,6 +98,14 @@ struct scap_savefile_vtable {
 	 */
 	void (*fseek_capture)(struct scap_engine_handle engine, uint64_t off);
 
+	/**
+	 * @brief seek through the capture to the first event at or after a timestamp
+	 * @param engine the handle to the engine
+	 * @param ts the timestamp of the first event to read
+	 * @return SCAP_SUCCESS or a failure code
+	 */
+	int32_t (*seek_timestamp)(struct scap_engine_handle engine, uint64_t ts);
+
 	/**
 	 * @brief restart a capture from the current offset
 	 * @param handle the full scap_t handle
@@ -183,6 +191,61 @@ struct scap_vtable {
 	                uint16_t* pdevid,
 	                uint32_t* pflags);
 
+	/**
+	 * @brief fetch up to max_events events
+	 * @param engine wraps the pointer to the engine-specific handle
+	 * @param pevents [out] where the pointers to the events get stored
+	 * @param pdevids [out] where the devices on which the events were
+	 *                received get stored
+	 * @param pflags [out] where the flags of the events get stored
+	 * @param max_events the size of the output arrays
+	 * @param pnevents [out] the number of events returned
+	 * @return SCAP_SUCCESS if at least one event is returned, otherwise
+	 *         the same codes as next()
+	 *
+	 * The memory pointed to by the returned events must remain valid at
+	 * least until the next call to next_batch() or next(). Optional: when
+	 * NULL, libscap builds the batch by calling next() and copying the
+	 * events.
+	 */
+	int32_t (*next_batch)(struct scap_engine_handle engine,
+	                      scap_evt** pevents,
+	                      uint16_t* pdevids,
+	                      uint32_t* pflags,
+	                      uint32_t max_events,
+	                      uint32_t* pnevents);
+
+	/**
+	 * @brief get the number of shards the event stream is split into
+	 * @param engine wraps the pointer to the engine-specific handle
+	 * @return the number of shards
+	 *
+	 * Optional: engines that don't support sharding leave it NULL and expose
+	 * a single shard, consumed through next()
+	 */
+	uint32_t (*get_n_shards)(struct scap_engine_handle engine);
+
+	/**
+	 * @brief fetch the next event of a shard
+	 * @param engine wraps the pointer to the engine-specific handle
+	 * @param shard the shard to consume, lower than get_n_shards()
+	 * @param pevent [out] where the pointer to the next event gets stored
+	 * @param pdevid [out] where the device on which the event was received
+	 *               gets stored
+	 * @param pflags [out] where the flags for the event get stored
+	 * @return same as next()
+	 *
+	 * Different shards are consumed from different threads at the same time,
+	 * so they must not share any state. The memory pointed to by *pevent
+	 * must remain valid at least until the next call to next_shard() for the
+	 * same shard. Optional, see get_n_shards().
+	 */
+	int32_t (*next_shard)(struct scap_engine_handle engine,
+	                      uint32_t shard,
+	                      scap_evt** pevent,
+	                      uint16_t* pdevid,
+	                      uint32_t* pflags);
+
 	/**
 	 * @brief start a capture
 	 * @param engine
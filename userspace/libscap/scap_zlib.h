@@ -41,6 +41,7 @@ limitations under the License.
 #define gzread(F, B, S) fread(B, 1, S, F)
 #define gztell(F) ftell(F)
 #define gzclearerr(F) clearerr(F)
+#define gzdirect(F) 1
 inline static const char *gzerror(FILE *F, int *E) {
 	*E = ferror(F);
 	return "error reading file descriptor";
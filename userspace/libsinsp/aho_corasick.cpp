@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/aho_corasick.h>
+
+#include <deque>
+
+uint32_t aho_corasick::add(std::string_view pattern) {
+	for(uint32_t i = 0; i < m_patterns.size(); i++) {
+		if(m_patterns[i] == pattern) {
+			return i;
+		}
+	}
+	m_patterns.emplace_back(pattern);
+	m_built = false;
+	return m_patterns.size() - 1;
+}
+
+void aho_corasick::build() {
+	// assign a class to every byte appearing in the patterns, class 0 is
+	// for all the others
+	for(auto& c : m_classes) {
+		c = 0;
+	}
+	m_num_classes = 1;
+	for(const auto& p : m_patterns) {
+		for(uint8_t c : p) {
+			c = fold(c);
+			if(m_classes[c] == 0) {
+				m_classes[c] = m_num_classes++;
+			}
+		}
+	}
+	if(m_case_insensitive) {
+		for(uint32_t c = 'A'; c <= 'Z'; c++) {
+			m_classes[c] = m_classes[c - 'A' + 'a'];
+		}
+	}
+
+	// build the trie, 0 is the root and UINT32_MAX a missing transition
+	std::vector<uint32_t> trie(m_num_classes, UINT32_MAX);
+	std::vector<std::vector<uint32_t>> outputs(1);
+	uint32_t num_states = 1;
+	for(uint32_t id = 0; id < m_patterns.size(); id++) {
+		uint32_t s = 0;
+		for(uint8_t c : m_patterns[id]) {
+			size_t t = s * m_num_classes + m_classes[c];
+			if(trie[t] == UINT32_MAX) {
+				trie[t] = num_states++;
+				trie.resize(num_states * m_num_classes, UINT32_MAX);
+				outputs.emplace_back();
+			}
+			s = trie[t];
+		}
+		outputs[s].push_back(id);
+	}
+
+	// compute failure links breadth first, and turn the trie into a DFA
+	// by replacing the missing transitions with the ones of the failure state
+	std::vector<uint32_t> fail(num_states, 0);
+	m_dict_links.assign(num_states, UINT32_MAX);
+	std::deque<uint32_t> queue;
+	for(uint32_t c = 0; c < m_num_classes; c++) {
+		uint32_t& next = trie[c];
+		if(next == UINT32_MAX) {
+			next = 0;
+		} else {
+			queue.push_back(next);
+		}
+	}
+	while(!queue.empty()) {
+		uint32_t s = queue.front();
+		queue.pop_front();
+		uint32_t f = fail[s];
+		m_dict_links[s] = outputs[f].empty() ? m_dict_links[f] : f;
+		for(uint32_t c = 0; c < m_num_classes; c++) {
+			uint32_t& next = trie[s * m_num_classes + c];
+			if(next == UINT32_MAX) {
+				next = trie[f * m_num_classes + c];
+			} else {
+				fail[next] = trie[f * m_num_classes + c];
+				queue.push_back(next);
+			}
+		}
+	}
+	m_dict_links[0] = UINT32_MAX;
+
+	m_outputs_begin.assign(num_states + 1, 0);
+	m_outputs.clear();
+	m_has_output.assign(num_states, 0);
+	for(uint32_t s = 0; s < num_states; s++) {
+		m_outputs_begin[s] = m_outputs.size();
+		m_outputs.insert(m_outputs.end(), outputs[s].begin(), outputs[s].end());
+	}
+	m_outputs_begin[num_states] = m_outputs.size();
+	for(uint32_t s = 0; s < num_states; s++) {
+		m_has_output[s] = !outputs[s].empty() || m_dict_links[s] != UINT32_MAX;
+	}
+
+	m_transitions = std::move(trie);
+	m_num_states = num_states;
+	m_built = true;
+}
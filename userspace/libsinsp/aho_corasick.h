@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+// Aho-Corasick automaton finding all the occurrences of a set of patterns
+// in a text with a single pass over it.
+//
+// The automaton is compiled into a DFA whose input symbols are classes of
+// bytes: all the bytes not appearing in any pattern share a class, which
+// keeps the transition table small. In case-insensitive mode the upper and
+// lower case of an ASCII letter are in the same class, so the text does
+// not need to be converted.
+//
+class aho_corasick {
+public:
+	explicit aho_corasick(bool case_insensitive = false):
+	        m_case_insensitive(case_insensitive) {}
+
+	// Adds a non-empty pattern and returns its id. Adding an existing
+	// pattern returns the id it already has. The automaton must be
+	// built again before scanning.
+	uint32_t add(std::string_view pattern);
+
+	void build();
+
+	inline bool built() const { return m_built; }
+	inline size_t size() const { return m_patterns.size(); }
+	inline size_t num_states() const { return m_num_states; }
+
+	// Calls `on_match(id, end)` for every occurrence of a pattern in the
+	// text, `end` being the offset right after the occurrence.
+	template<typename F>
+	void scan(std::string_view text, F&& on_match) const {
+		const uint32_t* trans = m_transitions.data();
+		uint32_t state = 0;
+		for(size_t i = 0; i < text.size(); i++) {
+			state = trans[state * m_num_classes + m_classes[(uint8_t)text[i]]];
+			// walk the states whose patterns end here
+			for(uint32_t s = m_has_output[state] ? state : UINT32_MAX; s != UINT32_MAX;
+			    s = m_dict_links[s]) {
+				for(uint32_t o = m_outputs_begin[s]; o < m_outputs_begin[s + 1]; o++) {
+					on_match(m_outputs[o], i + 1);
+				}
+			}
+		}
+	}
+
+private:
+	inline uint8_t fold(uint8_t c) const {
+		return m_case_insensitive && c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+	}
+
+	bool m_case_insensitive;
+	bool m_built = false;
+	std::vector<std::string> m_patterns;
+
+	uint32_t m_num_classes = 0;
+	uint32_t m_num_states = 0;
+	uint8_t m_classes[256] = {};
+	// m_transitions[state * m_num_classes + class] is the next state
+	std::vector<uint32_t> m_transitions;
+	// patterns ending at state s are m_outputs[m_outputs_begin[s]..m_outputs_begin[s + 1]]
+	std::vector<uint32_t> m_outputs_begin;
+	std::vector<uint32_t> m_outputs;
+	// nearest state reachable through failure links that has outputs
+	std::vector<uint32_t> m_dict_links;
+	// whether the state or any of its dictionary links has outputs
+	std::vector<uint8_t> m_has_output;
+};
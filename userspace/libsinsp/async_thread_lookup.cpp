@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/async_thread_lookup.h>
+
+#include <chrono>
+
+#include <libsinsp/utils.h>
+
+// How long the routine waits for requests before releasing the worker.
+static constexpr auto s_idle_wait = std::chrono::milliseconds(10);
+
+sinsp_async_thread_lookup::sinsp_async_thread_lookup(
+        scap_platform* platform,
+        const std::shared_ptr<sinsp_thread_pool>& tpool):
+        m_state(std::make_shared<state>()),
+        m_tpool(tpool) {
+	m_state->m_platform = platform;
+
+	// The routine keeps the state alive: the pool may run it once more after
+	// it has been unsubscribed.
+	auto st = m_state;
+	m_routine = m_tpool->subscribe([st]() {
+		run(*st);
+		return true;
+	});
+}
+
+sinsp_async_thread_lookup::~sinsp_async_thread_lookup() {
+	{
+		std::unique_lock<std::mutex> lock(m_state->m_mtx);
+		m_state->m_stop = true;
+		m_state->m_cv.notify_all();
+		m_state->m_cv.wait(lock, [this] { return !m_state->m_busy; });
+	}
+	m_tpool->unsubscribe(m_routine);
+}
+
+void sinsp_async_thread_lookup::request(int64_t tid, bool scan_sockets) {
+	std::lock_guard<std::mutex> lock(m_state->m_mtx);
+	if(!m_state->m_pending.insert(tid).second) {
+		return;
+	}
+	m_state->m_requests.emplace_back(tid, scan_sockets);
+	m_state->m_cv.notify_all();
+}
+
+std::vector<std::unique_ptr<sinsp_async_thread_lookup::result>>
+sinsp_async_thread_lookup::collect() {
+	std::vector<std::unique_ptr<result>> res;
+	std::lock_guard<std::mutex> lock(m_state->m_mtx);
+	res.swap(m_state->m_results);
+	for(const auto& r : res) {
+		m_state->m_pending.erase(r->m_tid);
+	}
+	m_state->m_num_results = 0;
+	return res;
+}
+
+size_t sinsp_async_thread_lookup::pending() {
+	std::lock_guard<std::mutex> lock(m_state->m_mtx);
+	return m_state->m_pending.size();
+}
+
+void sinsp_async_thread_lookup::run(state& st) {
+	std::unique_lock<std::mutex> lock(st.m_mtx);
+	st.m_cv.wait_for(lock, s_idle_wait, [&st] { return st.m_stop || !st.m_requests.empty(); });
+	if(st.m_stop || st.m_requests.empty()) {
+		return;
+	}
+
+	auto r = std::make_unique<result>();
+	r->m_tid = st.m_requests.front().first;
+	bool scan_sockets = st.m_requests.front().second;
+	st.m_requests.pop_front();
+	st.m_busy = true;
+	lock.unlock();
+
+	scap_proclist proclist;
+	init_proclist(&proclist,
+	              {default_refresh_start_end_callback,
+	               default_refresh_start_end_callback,
+	               on_new_entry,
+	               r.get()});
+
+	char error[SCAP_LASTERR_SIZE];
+	uint64_t ts_start = sinsp_utils::get_current_time_ns();
+	r->m_res = scap_proc_fetch(st.m_platform, &proclist, r->m_tid, scan_sockets, error);
+	r->m_duration_ns = sinsp_utils::get_current_time_ns() - ts_start;
+
+	lock.lock();
+	st.m_busy = false;
+	st.m_results.push_back(std::move(r));
+	st.m_num_results = st.m_results.size();
+	st.m_cv.notify_all();
+}
+
+int32_t sinsp_async_thread_lookup::on_new_entry(void* context,
+                                                char* error,
+                                                int64_t tid,
+                                                scap_threadinfo* tinfo,
+                                                scap_fdinfo* fdinfo,
+                                                scap_threadinfo** new_tinfo) {
+	auto r = static_cast<result*>(context);
+	if(fdinfo == nullptr) {
+		r->m_threads.push_back(*tinfo);
+	} else {
+		r->m_fds.push_back(*fdinfo);
+	}
+
+	if(new_tinfo != nullptr) {
+		*new_tinfo = tinfo;
+	}
+	return SCAP_SUCCESS;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <libscap/scap.h>
+#include <libsinsp/sinsp_thread_pool.h>
+
+//
+// Reads the threads missing from the thread table from /proc on a routine of
+// the thread pool, so that the event loop doesn't block on procfs:
+// - the event loop queues the lookups with request(), a thread is only queued
+//   once until its lookup completes;
+// - the routine reads every thread (and its fds) with scap_proc_fetch(), into a
+//   private result;
+// - the event loop takes the completed lookups with collect(), and adds them
+//   to the thread table itself.
+//
+class sinsp_async_thread_lookup {
+public:
+	// A completed lookup, with copies of the thread and of its fds.
+	struct result {
+		int64_t m_tid = -1;
+		int32_t m_res = SCAP_FAILURE;
+		uint64_t m_duration_ns = 0;
+		std::vector<scap_threadinfo> m_threads;
+		std::vector<scap_fdinfo> m_fds;
+	};
+
+	sinsp_async_thread_lookup(scap_platform* platform,
+	                          const std::shared_ptr<sinsp_thread_pool>& tpool);
+
+	// Stops the routine, waiting for the lookup in progress.
+	~sinsp_async_thread_lookup();
+
+	sinsp_async_thread_lookup(const sinsp_async_thread_lookup&) = delete;
+	sinsp_async_thread_lookup& operator=(const sinsp_async_thread_lookup&) = delete;
+
+	// Queues the lookup of `tid`, unless it is already in progress.
+	void request(int64_t tid, bool scan_sockets);
+
+	// Returns the lookups completed since the last call.
+	std::vector<std::unique_ptr<result>> collect();
+
+	// Cheap check for the event loop, before calling collect().
+	inline bool has_results() const { return m_state->m_num_results.load() > 0; }
+
+	// Number of lookups queued or in progress.
+	size_t pending();
+
+private:
+	struct state {
+		scap_platform* m_platform = nullptr;
+		std::mutex m_mtx;
+		std::condition_variable m_cv;
+		std::deque<std::pair<int64_t, bool>> m_requests;
+		std::unordered_set<int64_t> m_pending;  // queued or being read
+		std::vector<std::unique_ptr<result>> m_results;
+		std::atomic<size_t> m_num_results{0};
+		bool m_busy = false;
+		bool m_stop = false;
+	};
+
+	static int32_t on_new_entry(void* context,
+	                            char* error,
+	                            int64_t tid,
+	                            scap_threadinfo* tinfo,
+	                            scap_fdinfo* fdinfo,
+	                            scap_threadinfo** new_tinfo);
+
+	// Serves one queued lookup, waiting a bit for one when there are none:
+	// the routine returns regularly to share the worker with the others.
+	static void run(state& st);
+
+	std::shared_ptr<state> m_state;
+	std::shared_ptr<sinsp_thread_pool> m_tpool;
+	sinsp_thread_pool::routine_id_t m_routine = 0;
+};
@@ -66,17 +66,7 @@ void sinsp_dumper::open(sinsp* inspector, const std::string& filename, bool comp
 		throw sinsp_exception(error);
 	}
 
-	inspector->m_thread_manager->dump_threads_to_file(m_dumper);
-	inspector->m_usergroup_manager->dump_users_groups(*this);
-
-	// ask registered ASYNC plugins for a dump of their state
-	for(auto& p : inspector->m_plugin_manager->plugins()) {
-		if(p->caps() & CAP_ASYNC) {
-			p->dump_state(*this);
-		}
-	}
-
-	m_nevts = 0;
+	setup(inspector);
 }
 
 void sinsp_dumper::fdopen(sinsp* inspector, int fd, bool compress) {
@@ -92,6 +82,18 @@ void sinsp_dumper::fdopen(sinsp* inspector, int fd, bool compress) {
 		throw sinsp_exception(error);
 	}
 
+	setup(inspector);
+}
+
+void sinsp_dumper::setup(sinsp* inspector) {
+	if((m_index_chunk_events != 0 || m_index_chunk_bytes != 0) && !m_target_memory_buffer &&
+	   scap_dump_enable_index(m_dumper, m_index_chunk_events, m_index_chunk_bytes) !=
+	           SCAP_SUCCESS) {
+		std::string error = scap_dump_getlasterr(m_dumper);
+		close();
+		throw sinsp_exception(error);
+	}
+
 	inspector->m_thread_manager->dump_threads_to_file(m_dumper);
 	inspector->m_usergroup_manager->dump_users_groups(*this);
 
@@ -105,6 +107,11 @@ void sinsp_dumper::fdopen(sinsp* inspector, int fd, bool compress) {
 	m_nevts = 0;
 }
 
+void sinsp_dumper::enable_index(uint32_t chunk_events, uint64_t chunk_bytes) {
+	m_index_chunk_events = chunk_events;
+	m_index_chunk_bytes = chunk_bytes;
+}
+
 void sinsp_dumper::close() {
 	if(m_dumper != NULL) {
 		scap_dump_close(m_dumper);
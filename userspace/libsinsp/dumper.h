@@ -72,6 +72,15 @@ public:
 
 	void fdopen(sinsp* inspector, int fd, bool compress);
 
+	/*!
+	  \brief Writes an index of the events at the end of the file, to seek
+	  through it by timestamp (see `sinsp::seek_to_timestamp()`). Applies to
+	  the files opened from now on.
+	  \param chunk_events The max number of events per index entry, 0 for no limit.
+	  \param chunk_bytes The max size of the events per index entry, 0 for no limit.
+	*/
+	void enable_index(uint32_t chunk_events, uint64_t chunk_bytes = 0);
+
 	/*!
 	  \brief Closes the dump file.
 	*/
@@ -112,6 +121,10 @@ private:
 	uint8_t* m_target_memory_buffer;
 	uint64_t m_target_memory_buffer_size;
 	uint64_t m_nevts;
+	uint32_t m_index_chunk_events = 0;
+	uint64_t m_index_chunk_bytes = 0;
+
+	void setup(sinsp* inspector);
 };
 
 /*@}*/
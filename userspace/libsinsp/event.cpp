@@ -70,6 +70,8 @@ sinsp_evt::sinsp_evt():
         m_flags(EF_NONE),
         m_dump_flags(0),
         m_info(nullptr),
+        m_decoded_params(nullptr),
+        m_decoded_nparams(0),
         m_paramstr_storage(1024),
         m_resolved_paramstr_storage(1024),
         m_tinfo(nullptr),
@@ -587,6 +587,7 @@ public:
 	void init_from_raw(uint8_t* evdata, const uint16_t cpuid) {
 		m_flags = EF_NONE;
 		m_pevt = reinterpret_cast<scap_evt*>(evdata);
+		m_decoded_params = nullptr;
 		m_info = &m_event_info_table[m_pevt->type];
 		m_tinfo_ref.reset();
 		m_tinfo = nullptr;
@@ -608,8 +609,13 @@ public:
 	}
 
 	void load_params() {
-		scap_sized_buffer params[PPM_MAX_EVENT_PARAMS];
-		const auto nparams = scap_event_decode_params(m_pevt, params);
+		scap_sized_buffer buf[PPM_MAX_EVENT_PARAMS];
+		const scap_sized_buffer* params = m_decoded_params;
+		uint32_t nparams = m_decoded_nparams;
+		if(params == nullptr) {
+			nparams = scap_event_decode_params(m_pevt, buf);
+			params = buf;
+		}
 		m_params.clear();
 		for(uint32_t i = 0; i < nparams; i++) {
 			m_params.emplace_back(this,
@@ -629,7 +635,20 @@ public:
 
 	scap_evt* get_scap_evt() { return m_pevt; }
 
-	void set_scap_evt(scap_evt* v) { m_pevt = v; }
+	void set_scap_evt(scap_evt* v) {
+		m_pevt = v;
+		m_decoded_params = nullptr;
+	}
+
+	/*!
+	  \brief Use the params of the current scap event decoded ahead of time
+	  (see sinsp_event_decoder) instead of decoding them again when they are
+	  loaded. They must stay valid until the scap event is replaced.
+	*/
+	void set_decoded_params(const scap_sized_buffer* params, uint32_t nparams) {
+		m_decoded_params = params;
+		m_decoded_nparams = nparams;
+	}
 
 	const char* get_scap_evt_storage() const { return m_pevt_storage; }
 
@@ -780,6 +799,8 @@ private:
 	uint32_t m_dump_flags;
 	const ppm_event_info* m_info;
 	std::vector<sinsp_evt_param> m_params;
+	const scap_sized_buffer* m_decoded_params;
+	uint32_t m_decoded_nparams;
 
 	std::vector<char> m_paramstr_storage;
 	std::vector<char> m_resolved_paramstr_storage;
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+
+#include <libsinsp/event_decoder.h>
+
+#include <algorithm>
+#include <cstring>
+
+// The fd an event operates on, read from the position of its fd param.
+static int64_t decode_fd(const scap_evt* e, const scap_sized_buffer* params, uint32_t nparams) {
+	static const ppm_event_info* s_info = scap_get_event_info_table();
+	const auto type = static_cast<ppm_event_code>(e->type);
+	if(type >= PPM_EVENT_MAX || (s_info[type].flags & EF_USES_FD) == 0) {
+		return -1;
+	}
+
+	const int location = PPME_IS_ENTER(type) ? get_enter_event_fd_location(type)
+	                                         : get_exit_event_fd_location(type);
+	if(location < 0 || static_cast<uint32_t>(location) >= nparams ||
+	   params[location].size != sizeof(int64_t)) {
+		return -1;
+	}
+
+	int64_t fd;
+	memcpy(&fd, params[location].buf, sizeof(fd));
+	return fd;
+}
+
+sinsp_event_decoder::sinsp_event_decoder(uint32_t num_workers) {
+	for(uint32_t i = 0; i < num_workers; i++) {
+		m_workers.emplace_back([this]() { worker(); });
+	}
+}
+
+sinsp_event_decoder::~sinsp_event_decoder() {
+	finish();
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_stop = true;
+	}
+	m_cv.notify_all();
+	for(auto& w : m_workers) {
+		w.join();
+	}
+}
+
+void sinsp_event_decoder::start(scap_evt* const* evts, uint32_t len) {
+	finish();
+
+	if(len > m_capacity) {
+		m_capacity = len;
+		m_entries.resize(len);
+		m_chunks.reset(new std::atomic<uint8_t>[(len + s_chunk_size - 1) / s_chunk_size]);
+	}
+
+	const uint32_t num_chunks = (len + s_chunk_size - 1) / s_chunk_size;
+	for(uint32_t c = 0; c < num_chunks; c++) {
+		m_chunks[c].store(chunk_state::FREE, std::memory_order_relaxed);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+		m_evts = evts;
+		m_len = len;
+		m_num_chunks = num_chunks;
+		m_next_chunk.store(0, std::memory_order_relaxed);
+		m_generation++;
+	}
+	m_cv.notify_all();
+}
+
+const sinsp_event_decoder::decoded_evt& sinsp_event_decoder::get(uint32_t pos) {
+	const uint32_t chunk = pos / s_chunk_size;
+	if(m_chunks[chunk].load(std::memory_order_acquire) != chunk_state::DONE &&
+	   !claim_and_decode(chunk)) {
+		// a worker is decoding it, it is only a few events
+		while(m_chunks[chunk].load(std::memory_order_acquire) != chunk_state::DONE) {
+			std::this_thread::yield();
+		}
+	}
+	return m_entries[pos];
+}
+
+void sinsp_event_decoder::finish() {
+	if(m_len == 0) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mtx);
+	// the workers that didn't get to the batch yet are going to skip it
+	m_next_chunk.store(m_num_chunks, std::memory_order_relaxed);
+	m_num_chunks = 0;
+	m_idle_cv.wait(lock, [this]() { return m_active == 0; });
+	m_evts = nullptr;
+	m_len = 0;
+}
+
+void sinsp_event_decoder::worker() {
+	uint64_t generation = 0;
+	std::unique_lock<std::mutex> lock(m_mtx);
+	while(true) {
+		m_cv.wait(lock, [&]() { return m_stop || m_generation != generation; });
+		if(m_stop) {
+			return;
+		}
+		generation = m_generation;
+		const uint32_t num_chunks = m_num_chunks;
+		m_active++;
+		lock.unlock();
+
+		for(uint32_t c = m_next_chunk.fetch_add(1, std::memory_order_relaxed); c < num_chunks;
+		    c = m_next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+			claim_and_decode(c);
+		}
+
+		lock.lock();
+		if(--m_active == 0) {
+			m_idle_cv.notify_all();
+		}
+	}
+}
+
+bool sinsp_event_decoder::claim_and_decode(uint32_t chunk) {
+	uint8_t expected = chunk_state::FREE;
+	if(!m_chunks[chunk].compare_exchange_strong(expected,
+	                                            chunk_state::CLAIMED,
+	                                            std::memory_order_acq_rel)) {
+		return false;
+	}
+	decode_chunk(chunk);
+	m_chunks[chunk].store(chunk_state::DONE, std::memory_order_release);
+	return true;
+}
+
+void sinsp_event_decoder::decode_chunk(uint32_t chunk) {
+	const uint32_t end = std::min(m_len, (chunk + 1) * s_chunk_size);
+	for(uint32_t i = chunk * s_chunk_size; i < end; i++) {
+		const scap_evt* e = m_evts[i];
+		decoded_evt& d = m_entries[i];
+		d.m_nparams = scap_event_decode_params(e, d.m_params);
+		d.m_tid = e->tid;
+		d.m_fd = decode_fd(e, d.m_params, d.m_nparams);
+	}
+}
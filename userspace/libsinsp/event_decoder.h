@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+
+#pragma once
+
+#include <libscap/scap.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Decodes the events of a batch fetched from libscap on worker threads, ahead
+// of sinsp::next(), which parses them one by one on the capture thread. The
+// workers only read the events, so the parsing of an event can overlap with
+// the decoding of the next ones. For every event they slice the params (as
+// sinsp_evt::load_params() would) and extract the tid and the fd it operates
+// on, which the capture thread uses to prefetch the table entries of the
+// events it is about to parse.
+//
+// The events are split in small chunks claimed by the workers, or by the
+// capture thread itself when it reaches a chunk nobody claimed yet, so it
+// never waits for an idle worker. The batch is the bound of the queue: the
+// events must stay valid until finish() returns, which waits for the workers
+// to leave the batch before the next one is fetched.
+//
+class sinsp_event_decoder {
+public:
+	struct decoded_evt {
+		scap_sized_buffer m_params[PPM_MAX_EVENT_PARAMS];
+		uint32_t m_nparams = 0;
+		int64_t m_tid = -1;
+		int64_t m_fd = -1;  // -1 if the event doesn't operate on an fd
+	};
+
+	explicit sinsp_event_decoder(uint32_t num_workers);
+	~sinsp_event_decoder();
+
+	sinsp_event_decoder(const sinsp_event_decoder&) = delete;
+	sinsp_event_decoder& operator=(const sinsp_event_decoder&) = delete;
+
+	inline uint32_t num_workers() const { return static_cast<uint32_t>(m_workers.size()); }
+
+	// Hands a new batch to the workers, finishing the previous one.
+	void start(scap_evt* const* evts, uint32_t len);
+
+	// Returns the decoded event at `pos`, decoding it here if needed.
+	const decoded_evt& get(uint32_t pos);
+
+	// Returns the decoded event at `pos` only if it is ready, without waiting.
+	inline const decoded_evt* try_get(uint32_t pos) const {
+		if(pos >= m_len ||
+		   m_chunks[pos / s_chunk_size].load(std::memory_order_acquire) != chunk_state::DONE) {
+			return nullptr;
+		}
+		return &m_entries[pos];
+	}
+
+	// Waits for the workers to be done with the current batch.
+	void finish();
+
+private:
+	static constexpr uint32_t s_chunk_size = 8;
+
+	enum chunk_state : uint8_t { FREE = 0, CLAIMED = 1, DONE = 2 };
+
+	void worker();
+	bool claim_and_decode(uint32_t chunk);
+	void decode_chunk(uint32_t chunk);
+
+	std::vector<decoded_evt> m_entries;
+	std::unique_ptr<std::atomic<uint8_t>[]> m_chunks;
+	uint32_t m_capacity = 0;
+
+	// the current batch, only changed when the workers are idle
+	scap_evt* const* m_evts = nullptr;
+	uint32_t m_len = 0;
+	uint32_t m_num_chunks = 0;
+	std::atomic<uint32_t> m_next_chunk{0};
+
+	std::mutex m_mtx;
+	std::condition_variable m_cv;
+	std::condition_variable m_idle_cv;
+	uint64_t m_generation = 0;
+	uint32_t m_active = 0;
+	bool m_stop = false;
+	std::vector<std::thread> m_workers;
+};
@@ -23,15 +23,22 @@ limitations under the License.
 
 static constexpr const char* s_not_available_str = "<NA>";
 
-sinsp_evt_formatter::sinsp_evt_formatter(sinsp* inspector, filter_check_list& available_checks):
+sinsp_evt_formatter::sinsp_evt_formatter(
+        sinsp* inspector,
+        filter_check_list& available_checks,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_inspector(inspector),
-        m_available_checks(available_checks) {}
+        m_available_checks(available_checks),
+        m_cache_factory(cache_factory) {}
 
-sinsp_evt_formatter::sinsp_evt_formatter(sinsp* inspector,
-                                         const std::string& fmt,
-                                         filter_check_list& available_checks):
+sinsp_evt_formatter::sinsp_evt_formatter(
+        sinsp* inspector,
+        const std::string& fmt,
+        filter_check_list& available_checks,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_inspector(inspector),
-        m_available_checks(available_checks) {
+        m_available_checks(available_checks),
+        m_cache_factory(cache_factory) {
 	output_format of = sinsp_evt_formatter::OF_NORMAL;
 
 	if(m_inspector->get_buffer_format() == sinsp_evt::PF_JSON ||
@@ -141,6 +148,17 @@ void sinsp_evt_formatter::set_format(output_format of, const std::string& fmt) {
 				}
 			}
 
+			// install the extraction cache as the filter compiler does, with a
+			// storage layer for the values that plugins may overwrite
+			if(m_cache_factory) {
+				sinsp_filter_cache_factory::node_info_t node_info;
+				node_info.m_field = chk->get_transformed_field_info();
+				chk->m_extract_cache = m_cache_factory->new_extract_cache(ast.get(), node_info);
+				if(chk->get_field_info()->is_ptr_unstable() && chk->m_extract_cache) {
+					chk->add_transformer(filter_transformer_type::FTR_STORAGE);
+				}
+			}
+
 			auto factory = std::make_shared<sinsp_filter_factory>(m_inspector, m_available_checks);
 			formatter_visitor(factory, m_resolution_tokens).fill(ast.get());
 
@@ -60,12 +60,19 @@ public:
 	  \param fmt The printf-like format to use. The accepted format is the same
 	   as the one of the output in Falco rules, so refer to the Falco
 	   documentation for details.
+	  \param cache_factory Optional factory of the extraction caches installed
+	   on the fields of the format, as done by the filter compiler.
 	*/
-	sinsp_evt_formatter(sinsp *inspector, filter_check_list &available_checks);
+	sinsp_evt_formatter(
+	        sinsp *inspector,
+	        filter_check_list &available_checks,
+	        const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 
-	sinsp_evt_formatter(sinsp *inspector,
-	                    const std::string &fmt,
-	                    filter_check_list &available_checks);
+	sinsp_evt_formatter(
+	        sinsp *inspector,
+	        const std::string &fmt,
+	        filter_check_list &available_checks,
+	        const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 
 	virtual ~sinsp_evt_formatter() = default;
 
@@ -130,6 +137,7 @@ private:
 	std::vector<resolution_token> m_resolution_tokens;
 	sinsp *m_inspector = nullptr;
 	filter_check_list &m_available_checks;
+	std::shared_ptr<sinsp_filter_cache_factory> m_cache_factory;
 	bool m_require_all_values = false;
 	bool m_resolve_transformed_fields = false;
 
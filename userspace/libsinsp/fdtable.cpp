@@ -48,9 +48,19 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::find_ref(int64_t fd)
 	//
 	// Caching failed, do a real lookup
 	//
-	auto fdit = m_table.find(fd);
+	const std::shared_ptr<sinsp_fdinfo>* fdinfo = &m_nullptr_ret;
+	if(is_small_fd(fd)) {
+		if((size_t)fd < m_small_fds.size()) {
+			fdinfo = &m_small_fds[fd];
+		}
+	} else {
+		auto fdit = m_large_fds.find(fd);
+		if(fdit != m_large_fds.end()) {
+			fdinfo = &fdit->second;
+		}
+	}
 
-	if(fdit == m_table.end()) {
+	if(*fdinfo == nullptr) {
 		if(m_params->m_sinsp_stats_v2) {
 			m_params->m_sinsp_stats_v2->m_n_failed_fd_lookups++;
 		}
@@ -61,7 +71,7 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::find_ref(int64_t fd)
 		}
 
 		m_last_accessed_fd = fd;
-		m_last_accessed_fdinfo = fdit->second;
+		m_last_accessed_fdinfo = *fdinfo;
 		lookup_device(*m_last_accessed_fdinfo);
 		return m_last_accessed_fdinfo;
 	}
@@ -72,15 +82,31 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::add_ref(
         std::shared_ptr<sinsp_fdinfo>&& fdinfo) {
 	fdinfo->m_fd = fd;
 
-	const auto it = m_table.find(fd);
+	std::shared_ptr<sinsp_fdinfo>* slot = nullptr;
+	if(is_small_fd(fd)) {
+		if((size_t)fd >= m_small_fds.size()) {
+			// grow by powers of 2, there is usually a handful of fds
+			size_t size = m_small_fds.empty() ? 16 : m_small_fds.size();
+			while(size <= (size_t)fd) {
+				size *= 2;
+			}
+			m_small_fds.resize(size);
+		}
+		slot = &m_small_fds[fd];
+	} else {
+		auto it = m_large_fds.find(fd);
+		if(it != m_large_fds.end()) {
+			slot = &it->second;
+		}
+	}
 
 	// Three possible exits here:
 	// 1. fd is not on the table
 	//   a. the table size is under the limit so create a new entry
 	//   b. table size is over the limit, discard the fd
 	// 2. fd is already in the table, replace it
-	if(it == m_table.end()) {
-		if(m_table.size() == m_params->m_max_table_size) {
+	if(slot == nullptr || *slot == nullptr) {
+		if(m_size == m_params->m_max_table_size) {
 			return m_nullptr_ret;
 		}
 
@@ -90,7 +116,12 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::add_ref(
 			m_params->m_sinsp_stats_v2->m_n_added_fds++;
 		}
 
-		return m_table.emplace(fd, std::move(fdinfo)).first->second;
+		m_size++;
+		if(slot == nullptr) {
+			return m_large_fds.emplace(fd, std::move(fdinfo)).first->second;
+		}
+		*slot = std::move(fdinfo);
+		return *slot;
 	}
 
 	// the fd is already in the table. This can happen if:
@@ -107,18 +138,26 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::add_ref(
 
 	// Replace the fd as a struct copy.
 	m_last_accessed_fd = -1;
-	it->second = std::move(fdinfo);
-	return it->second;
+	*slot = std::move(fdinfo);
+	return *slot;
 }
 
 bool sinsp_fdtable::erase(int64_t fd) {
-	auto fdit = m_table.find(fd);
-
 	if(fd == m_last_accessed_fd) {
 		reset_cache();
 	}
 
-	if(fdit == m_table.end()) {
+	bool found = false;
+	if(is_small_fd(fd)) {
+		if((size_t)fd < m_small_fds.size() && m_small_fds[fd] != nullptr) {
+			m_small_fds[fd].reset();
+			found = true;
+		}
+	} else {
+		found = m_large_fds.erase(fd) != 0;
+	}
+
+	if(!found) {
 		//
 		// Looks like there's no fd to remove.
 		// Either the fd creation event was dropped or (more likely) our logic doesn't support the
@@ -130,7 +169,7 @@ bool sinsp_fdtable::erase(int64_t fd) {
 		}
 		return false;
 	} else {
-		m_table.erase(fdit);
+		m_size--;
 		if(m_params->m_sinsp_stats_v2 != nullptr) {
 			m_params->m_sinsp_stats_v2->m_n_noncached_fd_lookups++;
 			m_params->m_sinsp_stats_v2->m_n_removed_fds++;
@@ -140,12 +179,14 @@ bool sinsp_fdtable::erase(int64_t fd) {
 }
 
 void sinsp_fdtable::clear() {
-	m_table.clear();
+	m_small_fds.clear();
+	m_large_fds.clear();
+	m_size = 0;
 	reset_cache();
 }
 
 size_t sinsp_fdtable::size() const {
-	return m_table.size();
+	return m_size;
 }
 
 void sinsp_fdtable::reset_cache() {
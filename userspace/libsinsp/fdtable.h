@@ -61,7 +61,12 @@ public:
 	sinsp_fdinfo* add(int64_t fd, std::shared_ptr<sinsp_fdinfo>&& fdinfo);
 
 	inline bool const_loop(const fdtable_const_visitor_t callback) const {
-		for(auto it = m_table.begin(); it != m_table.end(); ++it) {
+		for(size_t fd = 0; fd < m_small_fds.size(); fd++) {
+			if(m_small_fds[fd] && !callback((int64_t)fd, *m_small_fds[fd])) {
+				return false;
+			}
+		}
+		for(auto it = m_large_fds.begin(); it != m_large_fds.end(); ++it) {
 			if(!callback(it->first, *it->second)) {
 				return false;
 			}
@@ -70,7 +75,12 @@ public:
 	}
 
 	inline bool loop(const fdtable_visitor_t callback) {
-		for(auto it = m_table.begin(); it != m_table.end(); ++it) {
+		for(size_t fd = 0; fd < m_small_fds.size(); fd++) {
+			if(m_small_fds[fd] && !callback((int64_t)fd, *m_small_fds[fd])) {
+				return false;
+			}
+		}
+		for(auto it = m_large_fds.begin(); it != m_large_fds.end(); ++it) {
 			if(!callback(it->first, *it->second)) {
 				return false;
 			}
@@ -79,21 +89,40 @@ public:
 	}
 
 	void retain(const fdtable_const_visitor_t& callback) {
-		for(auto it = m_table.begin(); it != m_table.end();) {
-			if(!callback(it->first, *it->second)) {
+		for(size_t fd = 0; fd < m_small_fds.size(); fd++) {
+			if(m_small_fds[fd] && !callback((int64_t)fd, *m_small_fds[fd])) {
 				// Invalidate the cache if we are removing the cached fd, otherwise a
 				// later lookup would return a dangling reference to the removed entry
 				// (the same hazard erase() guards against).
+				if((int64_t)fd == m_last_accessed_fd) {
+					reset_cache();
+				}
+				m_small_fds[fd].reset();
+				m_size--;
+			}
+		}
+		for(auto it = m_large_fds.begin(); it != m_large_fds.end();) {
+			if(!callback(it->first, *it->second)) {
 				if(it->first == m_last_accessed_fd) {
 					reset_cache();
 				}
-				it = m_table.erase(it);
+				it = m_large_fds.erase(it);
+				m_size--;
 			} else {
 				++it;
 			}
 		}
 	}
 
+	// Hints the cache about the entry of `fd`, if it is a small one.
+	inline void prefetch(int64_t fd) const {
+#if defined(__GNUC__) || defined(__clang__)
+		if(is_small_fd(fd) && (size_t)fd < m_small_fds.size()) {
+			__builtin_prefetch(m_small_fds[fd].get());
+		}
+#endif
+	}
+
 	// If the key is present, returns true, otherwise returns false.
 	bool erase(int64_t fd);
 
@@ -146,7 +175,17 @@ private:
 	// ctor_params object in sinsp constructor.
 	const std::shared_ptr<ctor_params> m_params;
 
-	std::unordered_map<int64_t, std::shared_ptr<sinsp_fdinfo>> m_table;
+	//
+	// Fds are mostly small and dense, so the ones below s_small_fd_limit are
+	// indexed directly in m_small_fds (grown on demand, null for free fds),
+	// the others are kept in m_large_fds.
+	//
+	static constexpr int64_t s_small_fd_limit = 1024;
+	std::vector<std::shared_ptr<sinsp_fdinfo>> m_small_fds;
+	std::unordered_map<int64_t, std::shared_ptr<sinsp_fdinfo>> m_large_fds;
+	size_t m_size = 0;
+
+	inline static bool is_small_fd(int64_t fd) { return fd >= 0 && fd < s_small_fd_limit; }
 
 	//
 	// Simple fd cache
@@ -28,7 +28,10 @@ limitations under the License.
 //
 
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <limits>
+#include <numeric>
 #include <json/json.h>
 
 #include <libsinsp/sinsp.h>
@@ -50,6 +53,19 @@ void sinsp_filter_expression::add_check(std::unique_ptr<sinsp_filter_check> chk)
 }
 
 bool sinsp_filter_expression::compare(sinsp_evt* evt) {
+	// the result of the expression may be shared with other filters, in which
+	// case the base class takes care of the comparison cache
+	if(m_compare_cache) {
+		return sinsp_filter_check::compare(evt);
+	}
+	return sinsp_filter_expression::compare_nocache(evt);
+}
+
+bool sinsp_filter_expression::compare_nocache(sinsp_evt* evt) {
+	if(m_adaptive) {
+		return compare_adaptive(evt);
+	}
+
 	bool res = true;
 
 	sinsp_filter_check* chk = nullptr;
@@ -107,6 +123,168 @@ done:
 	return res;
 }
 
+static inline uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+	                                                            start)
+	        .count();
+}
+
+bool sinsp_filter_expression::compare_adaptive(sinsp_evt* evt) {
+	auto& state = *m_adaptive;
+	bool sample = (state.m_num_evals & state.m_sample_mask) == 0;
+	state.m_num_evals++;
+
+	bool res = true;
+	auto size = m_checks.size();
+	for(size_t j = 0; j < size; j++) {
+		sinsp_filter_check* chk = m_checks[j].get();
+		if(j > 0 && ((chk->m_boolop & BO_OR) ? res : !res)) {
+			break;
+		}
+
+		auto& prof = state.m_children[j];
+		prof.m_num_evals++;
+		if(sample) {
+			auto start = std::chrono::steady_clock::now();
+			res = chk->compare(evt) != ((chk->m_boolop & BO_NOT) != 0);
+			prof.m_total_ns += elapsed_ns(start);
+			prof.m_num_samples++;
+			prof.m_num_passes += res ? 1 : 0;
+		} else {
+			res = chk->compare(evt) != ((chk->m_boolop & BO_NOT) != 0);
+		}
+	}
+
+	if(state.m_reorder_period != 0 && (state.m_num_evals & (state.m_reorder_period - 1)) == 0) {
+		reorder();
+	}
+	return res;
+}
+
+void sinsp_filter_expression::reorder() {
+	auto& state = *m_adaptive;
+	int32_t op = get_expr_boolop();
+	if(m_checks.size() < 2 || (op != BO_AND && op != BO_OR)) {
+		return;
+	}
+
+	// The children are sorted by their cost divided by the probability of
+	// short-circuiting the expression (being false for 'and', true for 'or'),
+	// which minimizes the expected cost of the whole expression. Children
+	// that were never sampled or never short-circuit go last.
+	auto rank = [op](const sinsp_filter_node_profile& p) {
+		double stop = op == BO_AND ? 1.0 - p.pass_rate() : p.pass_rate();
+		if(p.m_num_samples == 0 || stop <= 0) {
+			return std::numeric_limits<double>::infinity();
+		}
+		return p.cost_ns() / stop;
+	};
+
+	std::vector<double> ranks(m_checks.size());
+	std::transform(state.m_children.begin(), state.m_children.end(), ranks.begin(), rank);
+	std::vector<size_t> order(m_checks.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&ranks](size_t a, size_t b) {
+		return ranks[a] < ranks[b];
+	});
+
+	if(!std::is_sorted(order.begin(), order.end())) {
+		std::vector<std::unique_ptr<sinsp_filter_check>> checks(m_checks.size());
+		std::vector<sinsp_filter_node_profile> children(m_checks.size());
+		for(size_t j = 0; j < order.size(); j++) {
+			checks[j] = std::move(m_checks[order[j]]);
+			children[j] = state.m_children[order[j]];
+
+			// the first child has no operator, the others keep their 'not'
+			uint32_t neg = (uint32_t)checks[j]->m_boolop & BO_NOT;
+			checks[j]->m_boolop = (boolop)(j == 0 ? neg : (uint32_t)op | neg);
+		}
+		m_checks.swap(checks);
+		state.m_children.swap(children);
+		state.m_num_reorders++;
+	}
+
+	// decay the statistics so that they follow the recent events
+	for(auto& p : state.m_children) {
+		if(p.m_num_samples >= 2) {
+			p.m_num_evals /= 2;
+			p.m_num_samples /= 2;
+			p.m_num_passes /= 2;
+			p.m_total_ns /= 2;
+		}
+	}
+}
+
+void sinsp_filter_expression::set_adaptive(bool enabled,
+                                           uint32_t sample_period,
+                                           uint32_t reorder_period) {
+	if(!enabled) {
+		m_adaptive.reset();
+	} else {
+		if(!m_adaptive) {
+			m_adaptive = std::make_unique<adaptive_state>();
+		}
+		m_adaptive->m_sample_mask = sample_period - 1;
+		m_adaptive->m_reorder_period = reorder_period;
+		m_adaptive->m_children.resize(m_checks.size());
+	}
+
+	for(auto& chk : m_checks) {
+		auto expr = dynamic_cast<sinsp_filter_expression*>(chk.get());
+		if(expr) {
+			expr->set_adaptive(enabled, sample_period, reorder_period);
+		}
+	}
+}
+
+static std::string node_profile_name(const sinsp_filter_check* chk) {
+	std::string res = (chk->m_boolop & BO_NOT) ? "not" : "";
+	auto expr = dynamic_cast<const sinsp_filter_expression*>(chk);
+	if(expr) {
+		// a single child in brackets or negated
+		if(expr->m_checks.size() < 2) {
+			return res.empty() ? "()" : res;
+		}
+		return (res.empty() ? "" : res + " ") + (expr->get_expr_boolop() == BO_OR ? "or" : "and");
+	}
+
+	res += (res.empty() ? "" : " ");
+	res += chk->get_field_info() ? chk->get_field_info()->m_name : "<unknown>";
+	std::string op;
+	if(cmpop_to_str(chk->m_cmp, op)) {
+		res += " " + op;
+	}
+	return res;
+}
+
+void sinsp_filter_expression::get_profile(uint32_t depth,
+                                          std::vector<sinsp_filter_node_profile>& out) const {
+	for(size_t j = 0; j < m_checks.size(); j++) {
+		auto& prof = out.emplace_back();
+		if(m_adaptive) {
+			prof = m_adaptive->m_children[j];
+		}
+		prof.m_name = node_profile_name(m_checks[j].get());
+		prof.m_depth = depth;
+
+		auto expr = dynamic_cast<const sinsp_filter_expression*>(m_checks[j].get());
+		if(expr) {
+			expr->get_profile(depth + 1, out);
+		}
+	}
+}
+
+uint64_t sinsp_filter_expression::get_num_reorders() const {
+	uint64_t res = m_adaptive ? m_adaptive->m_num_reorders : 0;
+	for(auto& chk : m_checks) {
+		auto expr = dynamic_cast<const sinsp_filter_expression*>(chk.get());
+		if(expr) {
+			res += expr->get_num_reorders();
+		}
+	}
+	return res;
+}
+
 int32_t sinsp_filter_expression::get_expr_boolop() const {
 	if(m_checks.size() <= 1) {
 		return m_boolop;
@@ -136,13 +314,14 @@ sinsp_filter::sinsp_filter() {
 	m_curexpr = m_filter.get();
 }
 
-void sinsp_filter::push_expression(boolop op) {
+sinsp_filter_expression* sinsp_filter::push_expression(boolop op) {
 	sinsp_filter_expression* newexpr = new sinsp_filter_expression();
 	newexpr->m_boolop = op;
 	newexpr->m_parent = m_curexpr;
 
 	add_check(std::unique_ptr<sinsp_filter_check>(newexpr));
 	m_curexpr = newexpr;
+	return newexpr;
 }
 
 void sinsp_filter::pop_expression() {
@@ -157,7 +336,49 @@ void sinsp_filter::pop_expression() {
 }
 
 bool sinsp_filter::run(sinsp_evt* evt) {
-	return m_filter->compare(evt);
+	if(!m_adaptive || (m_profile.m_num_evals++ & m_sample_mask) != 0) {
+		return m_filter->compare(evt);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	bool res = m_filter->compare(evt);
+	m_profile.m_total_ns += elapsed_ns(start);
+	m_profile.m_num_samples++;
+	m_profile.m_num_passes += res ? 1 : 0;
+	return res;
+}
+
+static uint32_t round_up_pow2(uint32_t v) {
+	uint32_t res = 1;
+	while(res < v && res < (1u << 31)) {
+		res <<= 1;
+	}
+	return res;
+}
+
+void sinsp_filter::set_adaptive(bool enabled, uint32_t sample_period, uint32_t reorder_period) {
+	sample_period = round_up_pow2(sample_period);
+	reorder_period = reorder_period == 0 ? 0 : round_up_pow2(reorder_period);
+
+	m_adaptive = enabled;
+	m_sample_mask = sample_period - 1;
+	if(!enabled) {
+		m_profile = {};
+	}
+	m_filter->set_adaptive(enabled, sample_period, reorder_period);
+}
+
+std::vector<sinsp_filter_node_profile> sinsp_filter::get_profile() const {
+	std::vector<sinsp_filter_node_profile> res;
+	res.push_back(m_profile);
+	res[0].m_name = "filter";
+	res[0].m_depth = 0;
+	m_filter->get_profile(1, res);
+	return res;
+}
+
+uint64_t sinsp_filter::get_num_reorders() const {
+	return m_filter->get_num_reorders();
 }
 
 void sinsp_filter::add_check(std::unique_ptr<sinsp_filter_check> chk) {
@@ -447,9 +668,17 @@ std::unique_ptr<sinsp_filter> sinsp_filter_compiler::compile() {
 
 void sinsp_filter_compiler::visit(const libsinsp::filter::ast::and_expr* e) {
 	m_pos = e->get_pos();
-	bool nested = m_last_boolop != BO_AND;
+	// a subexpression with a shared result needs its own node, otherwise it
+	// can be merged in the parent one
+	sinsp_filter_cache_factory::node_info_t node_info;
+	auto cache = m_cache_factory->new_subexpr_cache(e, node_info);
+	bool nested = m_last_boolop != BO_AND || cache;
 	if(nested) {
-		m_filter->push_expression(m_last_boolop);
+		auto expr = m_filter->push_expression(m_last_boolop);
+		if(cache) {
+			expr->m_compare_cache = std::move(cache);
+			expr->m_cache_metrics = m_cache_factory->new_metrics(e, node_info);
+		}
 		m_last_boolop = BO_NONE;
 	}
 	for(auto& c : e->children) {
@@ -463,9 +692,17 @@ void sinsp_filter_compiler::visit(const libsinsp::filter::ast::and_expr* e) {
 
 void sinsp_filter_compiler::visit(const libsinsp::filter::ast::or_expr* e) {
 	m_pos = e->get_pos();
-	bool nested = m_last_boolop != BO_OR;
+	// a subexpression with a shared result needs its own node, otherwise it
+	// can be merged in the parent one
+	sinsp_filter_cache_factory::node_info_t node_info;
+	auto cache = m_cache_factory->new_subexpr_cache(e, node_info);
+	bool nested = m_last_boolop != BO_OR || cache;
 	if(nested) {
-		m_filter->push_expression(m_last_boolop);
+		auto expr = m_filter->push_expression(m_last_boolop);
+		if(cache) {
+			expr->m_compare_cache = std::move(cache);
+			expr->m_cache_metrics = m_cache_factory->new_metrics(e, node_info);
+		}
 		m_last_boolop = BO_NONE;
 	}
 	for(auto& c : e->children) {
@@ -659,6 +896,43 @@ void sinsp_filter_compiler::visit(const libsinsp::filter::ast::binary_check_expr
 	node_info.m_compare = check->m_cmp;
 	check->m_compare_cache = m_cache_factory->new_compare_cache(e, node_info);
 
+	// regex comparisons against a constant on the same field share a regex group,
+	// so that the field is scanned once per event for all of them
+	if(check->m_cmp.op == CO_REGEX && check->m_cmp.mod == CMPOP_MOD_NONE &&
+	   !check->has_filtercheck_value() && !node_info.m_field->is_list() &&
+	   check->get_filter_values().size() == 1) {
+		auto group = m_cache_factory->new_regex_group(e->left.get(), node_info);
+		if(group) {
+			const auto& v = check->get_filter_values()[0];
+			auto idx = group->add(std::string_view((const char*)v.first, v.second));
+			if(idx != SIZE_MAX) {
+				check->m_regex_group = std::move(group);
+				check->m_regex_group_idx = idx;
+			}
+		}
+	}
+
+	// the same goes for substring comparisons on string fields, that are matched
+	// all at once with a multi-pattern search
+	if((check->m_cmp.op == CO_CONTAINS || check->m_cmp.op == CO_ICONTAINS ||
+	    check->m_cmp.op == CO_STARTSWITH || check->m_cmp.op == CO_ENDSWITH) &&
+	   check->m_cmp.mod == CMPOP_MOD_NONE && !check->has_filtercheck_value() &&
+	   !node_info.m_field->is_list() && check->get_filter_values().size() == 1) {
+		auto type = check->get_transformed_field_info()->m_type;
+		auto group = type == PT_CHARBUF || type == PT_FSPATH || type == PT_FSRELPATH
+		                     ? m_cache_factory->new_substring_group(e->left.get(), node_info)
+		                     : nullptr;
+		if(group) {
+			const auto& v = check->get_filter_values()[0];
+			auto idx = group->add(check->m_cmp.op,
+			                      std::string_view((const char*)v.first, v.second));
+			if(idx != SIZE_MAX) {
+				check->m_substring_group = std::move(group);
+				check->m_substring_group_idx = idx;
+			}
+		}
+	}
+
 	m_filter->add_check(std::move(check));
 }
 
@@ -33,6 +33,38 @@ limitations under the License.
  *  @{
  */
 
+/*!
+  \brief Runtime statistics of a node of a filter, collected when the filter
+  is evaluated in adaptive mode (see sinsp_filter::set_adaptive()).
+*/
+struct sinsp_filter_node_profile {
+	// The field and operator of a check, or the operator of an expression
+	std::string m_name;
+
+	// The depth of the node in the filter tree, 0 for the whole filter
+	uint32_t m_depth = 0;
+
+	// The number of times the node was evaluated
+	uint64_t m_num_evals = 0;
+
+	// The number of evaluations whose cost and result were sampled
+	uint64_t m_num_samples = 0;
+
+	// The number of sampled evaluations in which the node was true
+	uint64_t m_num_passes = 0;
+
+	// The total cost of the sampled evaluations
+	uint64_t m_total_ns = 0;
+
+	inline double cost_ns() const {
+		return m_num_samples == 0 ? 0 : (double)m_total_ns / m_num_samples;
+	}
+
+	inline double pass_rate() const {
+		return m_num_samples == 0 ? 0 : (double)m_num_passes / m_num_samples;
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Filter expression class
 // A filter expression contains multiple filters connected by boolean expressions,
@@ -57,6 +89,8 @@ public:
 
 	bool compare(sinsp_evt*) override;
 
+	bool compare_nocache(sinsp_evt*) override;
+
 	void add_check(std::unique_ptr<sinsp_filter_check> chk);
 
 	//
@@ -67,8 +101,43 @@ public:
 	//
 	int32_t get_expr_boolop() const;
 
+	//
+	// In adaptive mode, the cost and the result of the children are sampled
+	// every `sample_period` evaluations, and the children of a consistent
+	// expression are reordered every `reorder_period` evaluations so that the
+	// expected cost of the expression is minimal. Applies to all the nested
+	// expressions as well.
+	//
+	void set_adaptive(bool enabled, uint32_t sample_period, uint32_t reorder_period);
+
+	//
+	// Appends the profile of the children to `out`, nested expressions included.
+	//
+	void get_profile(uint32_t depth, std::vector<sinsp_filter_node_profile>& out) const;
+
+	//
+	// The number of times the children have been reordered, nested expressions
+	// included.
+	//
+	uint64_t get_num_reorders() const;
+
 	sinsp_filter_expression* m_parent = nullptr;
 	std::vector<std::unique_ptr<sinsp_filter_check>> m_checks;
+
+private:
+	struct adaptive_state {
+		uint32_t m_sample_mask = 0;
+		uint32_t m_reorder_period = 0;
+		uint64_t m_num_evals = 0;
+		uint64_t m_num_reorders = 0;
+		// one for every check, in the same order
+		std::vector<sinsp_filter_node_profile> m_children;
+	};
+
+	bool compare_adaptive(sinsp_evt*);
+	void reorder();
+
+	std::unique_ptr<adaptive_state> m_adaptive;
 };
 
 /*!
@@ -81,14 +150,44 @@ public:
 
 	bool run(sinsp_evt* evt);
 
-	void push_expression(boolop op);
+	sinsp_filter_expression* push_expression(boolop op);
 	void pop_expression();
 	void add_check(std::unique_ptr<sinsp_filter_check> chk);
 
+	/*!
+	  \brief Enables or disables the adaptive evaluation of the filter. The
+	  cost and the pass rate of its nodes are sampled once every
+	  `sample_period` evaluations, and the children of every 'and'/'or' are
+	  reordered every `reorder_period` evaluations of it, so that the cheap
+	  and selective ones are evaluated first. The results of the filter don't
+	  change. Periods are rounded up to powers of 2, a `reorder_period` of 0
+	  only collects the profile.
+	*/
+	void set_adaptive(bool enabled, uint32_t sample_period = 16, uint32_t reorder_period = 4096);
+
+	inline bool is_adaptive() const { return m_adaptive; }
+
+	/*!
+	  \brief Returns the profile collected in adaptive mode: the whole filter
+	  first, then all its nodes depth-first in their current evaluation order.
+	  The statistics of the children of an expression are halved every time
+	  they are reordered, so that they reflect the recent events.
+	*/
+	std::vector<sinsp_filter_node_profile> get_profile() const;
+
+	/*!
+	  \brief Returns the number of times the nodes of the filter have been
+	  reordered in adaptive mode.
+	*/
+	uint64_t get_num_reorders() const;
+
 	std::unique_ptr<sinsp_filter_expression> m_filter;
 
 private:
 	sinsp_filter_expression* m_curexpr;
+	bool m_adaptive = false;
+	uint32_t m_sample_mask = 0;
+	sinsp_filter_node_profile m_profile;
 };
 
 class sinsp_filter_factory {
@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_cache.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <re2/re2.h>
+#include <re2/set.h>
+
+struct sinsp_filter_regex_group::compiled_set {
+	// same options used for the regexes compiled on their own
+	compiled_set(): set(re2::RE2::Options(re2::RE2::POSIX), re2::RE2::ANCHOR_BOTH) {}
+
+	re2::RE2::Set set;
+	size_t size = 0;  // number of patterns in the set
+};
+
+sinsp_filter_regex_group::sinsp_filter_regex_group() = default;
+
+sinsp_filter_regex_group::~sinsp_filter_regex_group() = default;
+
+size_t sinsp_filter_regex_group::add(std::string_view pattern) {
+	for(size_t i = 0; i < m_patterns.size(); i++) {
+		if(m_patterns[i] == pattern) {
+			return i;
+		}
+	}
+
+	// make sure the pattern can be added to a set before accepting it
+	re2::RE2::Set probe(re2::RE2::Options(re2::RE2::POSIX), re2::RE2::ANCHOR_BOTH);
+	std::string err;
+	if(probe.Add(re2::StringPiece(pattern.data(), pattern.size()), &err) < 0) {
+		return SIZE_MAX;
+	}
+
+	m_patterns.emplace_back(pattern);
+	m_matched_evtnum.push_back(UINT64_MAX);
+	return m_patterns.size() - 1;
+}
+
+bool sinsp_filter_regex_group::compile() {
+	// patterns can be added after the set has been used, e.g. when a new
+	// filter is compiled, so the set is rebuilt when it's not up to date
+	auto set = std::make_unique<compiled_set>();
+	std::string err;
+	for(const auto& p : m_patterns) {
+		if(set->set.Add(p, &err) < 0) {
+			return false;
+		}
+	}
+	if(!set->set.Compile()) {
+		return false;
+	}
+	set->size = m_patterns.size();
+	m_set = std::move(set);
+	m_evtnum = UINT64_MAX;
+	return true;
+}
+
+bool sinsp_filter_regex_group::match(const sinsp_evt* evt,
+                                     std::string_view text,
+                                     size_t idx,
+                                     bool& res) {
+	// a single pattern is faster on its own, and events without a number
+	// can't be told apart
+	if(m_failed || m_patterns.size() < 2 || idx >= m_patterns.size() || evt->get_num() == 0) {
+		return false;
+	}
+
+	if(!m_set || m_set->size != m_patterns.size()) {
+		if(!compile()) {
+			m_failed = true;
+			return false;
+		}
+	}
+
+	if(m_evtnum != evt->get_num()) {
+		re2::RE2::Set::ErrorInfo info;
+		m_matches.clear();
+		if(!m_set->set.Match(re2::StringPiece(text.data(), text.size()), &m_matches, &info) &&
+		   info.kind != re2::RE2::Set::kNoError) {
+			// e.g. the DFA ran out of memory, the patterns are evaluated
+			// on their own from now on
+			m_failed = true;
+			return false;
+		}
+		m_evtnum = evt->get_num();
+		for(int i : m_matches) {
+			m_matched_evtnum[i] = m_evtnum;
+		}
+	}
+
+	res = m_matched_evtnum[idx] == m_evtnum;
+	return true;
+}
+
+size_t sinsp_filter_substring_group::add(cmpop op, std::string_view pattern) {
+	if(op != CO_CONTAINS && op != CO_ICONTAINS && op != CO_STARTSWITH && op != CO_ENDSWITH) {
+		return SIZE_MAX;
+	}
+
+	// string comparisons stop at the first NUL, as strstr() does
+	pattern = pattern.substr(0, strnlen(pattern.data(), pattern.size()));
+
+	// an empty pattern is always matched and needs no automaton
+	uint32_t id = UINT32_MAX;
+	if(!pattern.empty()) {
+		id = (op == CO_ICONTAINS ? m_iautomaton : m_automaton).add(pattern);
+	}
+	for(size_t i = 0; i < m_entries.size(); i++) {
+		if(m_entries[i].op == op && m_entries[i].id == id) {
+			return i;
+		}
+	}
+
+	size_t idx = m_entries.size();
+	m_entries.push_back({op, id, (uint32_t)pattern.size()});
+	m_matched_evtnum.push_back(UINT64_MAX);
+	// the results of the current event don't include the new entry
+	m_evtnum = UINT64_MAX;
+
+	if(id == UINT32_MAX) {
+		m_empty_entries.push_back(idx);
+	} else {
+		auto& pattern_entries = op == CO_ICONTAINS ? m_ipattern_entries : m_pattern_entries;
+		if(id >= pattern_entries.size()) {
+			pattern_entries.resize(id + 1);
+		}
+		pattern_entries[id].push_back(idx);
+	}
+	return idx;
+}
+
+void sinsp_filter_substring_group::scan(std::string_view text) {
+	// patterns can be added after the group has been used, e.g. when a new
+	// filter is compiled, so the automatons are rebuilt when not up to date
+	if(!m_automaton.built()) {
+		m_automaton.build();
+	}
+	if(!m_iautomaton.built()) {
+		m_iautomaton.build();
+	}
+
+	for(auto i : m_empty_entries) {
+		m_matched_evtnum[i] = m_evtnum;
+	}
+
+	auto on_match = [this, &text](const std::vector<uint32_t>& entries, size_t end) {
+		for(auto i : entries) {
+			const auto& e = m_entries[i];
+			if((e.op == CO_STARTSWITH && end != e.len) ||
+			   (e.op == CO_ENDSWITH && end != text.size())) {
+				continue;
+			}
+			m_matched_evtnum[i] = m_evtnum;
+		}
+	};
+	if(m_automaton.size() > 0) {
+		m_automaton.scan(text, [&](uint32_t id, size_t end) {
+			on_match(m_pattern_entries[id], end);
+		});
+	}
+	if(m_iautomaton.size() > 0) {
+		m_iautomaton.scan(text, [&](uint32_t id, size_t end) {
+			on_match(m_ipattern_entries[id], end);
+		});
+	}
+}
+
+bool sinsp_filter_substring_group::match(const sinsp_evt* evt,
+                                         std::string_view text,
+                                         size_t idx,
+                                         bool& res) {
+	// events without a number can't be told apart
+	if(m_entries.size() < s_min_size || idx >= m_entries.size() || evt->get_num() == 0) {
+		return false;
+	}
+
+	if(m_evtnum != evt->get_num()) {
+		m_evtnum = evt->get_num();
+		scan(text.substr(0, strnlen(text.data(), text.size())));
+	}
+
+	res = m_matched_evtnum[idx] == m_evtnum;
+	return true;
+}
+
+template<typename T>
+static void flatten_children(const T* e, std::vector<std::string>& out) {
+	for(const auto& c : e->children) {
+		if(auto same = dynamic_cast<const T*>(c.get()); same != nullptr) {
+			flatten_children(same, out);
+		} else {
+			out.push_back(subexpr_sinsp_filter_cache_factory::normalized_string(c.get()));
+		}
+	}
+}
+
+template<typename T>
+static std::string normalized_logical_op(const T* e, const char* op) {
+	// the children of a logical operator can be evaluated in any order
+	// without changing its result
+	std::vector<std::string> children;
+	flatten_children(e, children);
+	std::sort(children.begin(), children.end());
+	children.erase(std::unique(children.begin(), children.end()), children.end());
+	if(children.size() == 1) {
+		return children[0];
+	}
+
+	std::string res = "(";
+	for(size_t i = 0; i < children.size(); i++) {
+		if(i > 0) {
+			res += op;
+		}
+		res += children[i];
+	}
+	res += ")";
+	return res;
+}
+
+std::string subexpr_sinsp_filter_cache_factory::normalized_string(const ast_expr_t* e) {
+	using namespace libsinsp::filter::ast;
+
+	if(auto a = dynamic_cast<const and_expr*>(e); a != nullptr) {
+		return normalized_logical_op(a, " and ");
+	}
+	if(auto o = dynamic_cast<const or_expr*>(e); o != nullptr) {
+		return normalized_logical_op(o, " or ");
+	}
+	if(auto n = dynamic_cast<const not_expr*>(e); n != nullptr) {
+		if(auto nn = dynamic_cast<const not_expr*>(n->child.get()); nn != nullptr) {
+			return normalized_string(nn->child.get());
+		}
+		return "not " + normalized_string(n->child.get());
+	}
+	return as_string(e);
+}
@@ -18,12 +18,16 @@ limitations under the License.
 
 #pragma once
 
+#include <libsinsp/aho_corasick.h>
 #include <libsinsp/event.h>
 #include <libsinsp/filter_field.h>
 #include <libsinsp/filter_compare.h>
 #include <libsinsp/filter/ast.h>
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -120,6 +124,99 @@ private:
 	bool m_result = false;
 };
 
+/**
+ * @brief Represents a group of regular expressions matched against the
+ * same extracted field. Instead of running every expression on its own, the
+ * group matches all of them at once with a single RE2::Set the first time one
+ * of them is evaluated for an event, and keeps the results for that event.
+ * All the users of a group must match the same text for a given event.
+ */
+class sinsp_filter_regex_group {
+public:
+	sinsp_filter_regex_group();
+	~sinsp_filter_regex_group();
+
+	/**
+	 * @brief Adds a pattern to the group and returns its index, or SIZE_MAX if
+	 * the pattern can't be part of a group. Adding a pattern already in the
+	 * group returns the index it already has.
+	 */
+	size_t add(std::string_view pattern);
+
+	/**
+	 * @brief Sets `res` to whether the pattern at index `idx` matches `text`
+	 * entirely. Returns false if the group can't answer for this event,
+	 * in which case the caller must evaluate the pattern on its own.
+	 */
+	bool match(const sinsp_evt* evt, std::string_view text, size_t idx, bool& res);
+
+	inline size_t size() const { return m_patterns.size(); }
+
+private:
+	struct compiled_set;
+
+	bool compile();
+
+	std::vector<std::string> m_patterns;
+	std::unique_ptr<compiled_set> m_set;
+	bool m_failed = false;
+	uint64_t m_evtnum = UINT64_MAX;
+	// for every pattern, the number of the last event it matched
+	std::vector<uint64_t> m_matched_evtnum;
+	std::vector<int> m_matches;
+};
+
+/**
+ * @brief Represents a group of substring comparisons (contains, icontains,
+ * startswith and endswith) against the same extracted field. The first time
+ * one of them is evaluated for an event, the field is scanned once for all the
+ * patterns of the group with an Aho-Corasick automaton, and the results are
+ * kept for that event. All the users of a group must match the same text for
+ * a given event.
+ */
+class sinsp_filter_substring_group {
+public:
+	/**
+	 * @brief Adds a pattern compared with `op` to the group and returns its
+	 * index, or SIZE_MAX if the comparison can't be part of a group. Adding a
+	 * comparison already in the group returns the index it already has.
+	 */
+	size_t add(cmpop op, std::string_view pattern);
+
+	/**
+	 * @brief Sets `res` to the result of the comparison at index `idx`
+	 * against `text`. Returns false if the group can't answer for this event,
+	 * in which case the caller must evaluate the comparison on its own.
+	 */
+	bool match(const sinsp_evt* evt, std::string_view text, size_t idx, bool& res);
+
+	inline size_t size() const { return m_entries.size(); }
+
+private:
+	// below this size comparing every pattern on its own is faster
+	static constexpr size_t s_min_size = 4;
+
+	struct entry {
+		cmpop op;
+		uint32_t id;  // id of the pattern in its automaton, UINT32_MAX if empty
+		uint32_t len;
+	};
+
+	void scan(std::string_view text);
+
+	std::vector<entry> m_entries;
+	std::vector<uint32_t> m_empty_entries;
+	// case sensitive and insensitive automatons, and for each of their
+	// patterns the indexes of the entries using it
+	aho_corasick m_automaton{false};
+	aho_corasick m_iautomaton{true};
+	std::vector<std::vector<uint32_t>> m_pattern_entries;
+	std::vector<std::vector<uint32_t>> m_ipattern_entries;
+	uint64_t m_evtnum = UINT64_MAX;
+	// for every entry, the number of the last event it matched
+	std::vector<uint64_t> m_matched_evtnum;
+};
+
 /**
  * @brief Represents a set of metrics and counters related to the usage
  * of cache optimizations in filters
@@ -130,6 +227,8 @@ struct sinsp_filter_cache_metrics {
 		m_num_extract_cache = 0;
 		m_num_compare = 0;
 		m_num_compare_cache = 0;
+		m_num_regex_group = 0;
+		m_num_substring_group = 0;
 	}
 
 	// The number of times extract() was called
@@ -143,6 +242,12 @@ struct sinsp_filter_cache_metrics {
 
 	// The number of times compare() could use a cached value
 	uint64_t m_num_compare_cache = 0;
+
+	// The number of times a regex comparison was answered by a regex group
+	uint64_t m_num_regex_group = 0;
+
+	// The number of times a substring comparison was answered by a substring group
+	uint64_t m_num_substring_group = 0;
 };
 
 /**
@@ -208,6 +313,38 @@ public:
 	                                                                node_info_t& info) {
 		return nullptr;
 	}
+
+	/**
+	 * @brief Given the provided AST node of a field extraction, returns a pointer
+	 * to the regex group shared by all the regex comparisons on that field.
+	 * Can return `nullptr` in case regex comparisons should not be grouped.
+	 */
+	virtual std::shared_ptr<sinsp_filter_regex_group> new_regex_group(const ast_expr_t* e,
+	                                                                  node_info_t& info) {
+		return nullptr;
+	}
+
+	/**
+	 * @brief Given the provided AST node of a field extraction, returns a pointer
+	 * to the substring group shared by all the substring comparisons on that field.
+	 * Can return `nullptr` in case substring comparisons should not be grouped.
+	 */
+	virtual std::shared_ptr<sinsp_filter_substring_group> new_substring_group(
+	        const ast_expr_t* e,
+	        node_info_t& info) {
+		return nullptr;
+	}
+
+	/**
+	 * @brief Given the provided AST node of a boolean expression (and, or),
+	 * returns a pointer to a comparison cache storing the result of the whole
+	 * subexpression in the compiled filter. Can return `nullptr` in case the
+	 * subexpression should not be cached.
+	 */
+	virtual std::shared_ptr<sinsp_filter_compare_cache> new_subexpr_cache(const ast_expr_t* e,
+	                                                                      node_info_t& info) {
+		return nullptr;
+	}
 };
 
 /**
@@ -222,6 +359,8 @@ public:
 	void reset() override {
 		m_extract_caches.clear();
 		m_compare_caches.clear();
+		m_regex_groups.clear();
+		m_substring_groups.clear();
 	}
 
 	std::shared_ptr<sinsp_filter_extract_cache> new_extract_cache(const ast_expr_t* e,
@@ -244,6 +383,19 @@ public:
 		return get_or_insert_ptr(key, m_compare_caches);
 	}
 
+	std::shared_ptr<sinsp_filter_regex_group> new_regex_group(const ast_expr_t* e,
+	                                                          node_info_t& info) override {
+		auto key = libsinsp::filter::ast::as_string(e);
+		return get_or_insert_ptr(key, m_regex_groups);
+	}
+
+	std::shared_ptr<sinsp_filter_substring_group> new_substring_group(
+	        const ast_expr_t* e,
+	        node_info_t& info) override {
+		auto key = libsinsp::filter::ast::as_string(e);
+		return get_or_insert_ptr(key, m_substring_groups);
+	}
+
 	inline const std::unordered_map<std::string, std::shared_ptr<sinsp_filter_extract_cache>>&
 	extract_cache() const {
 		return m_extract_caches;
@@ -254,7 +406,17 @@ public:
 		return m_compare_caches;
 	}
 
-private:
+	inline const std::unordered_map<std::string, std::shared_ptr<sinsp_filter_regex_group>>&
+	regex_groups() const {
+		return m_regex_groups;
+	}
+
+	inline const std::unordered_map<std::string, std::shared_ptr<sinsp_filter_substring_group>>&
+	substring_groups() const {
+		return m_substring_groups;
+	}
+
+protected:
 	template<typename T>
 	static inline std::shared_ptr<T> get_or_insert_ptr(
 	        const std::string& key,
@@ -268,4 +430,44 @@ private:
 
 	std::unordered_map<std::string, std::shared_ptr<sinsp_filter_extract_cache>> m_extract_caches;
 	std::unordered_map<std::string, std::shared_ptr<sinsp_filter_compare_cache>> m_compare_caches;
+	std::unordered_map<std::string, std::shared_ptr<sinsp_filter_regex_group>> m_regex_groups;
+	std::unordered_map<std::string, std::shared_ptr<sinsp_filter_substring_group>>
+	        m_substring_groups;
+};
+
+/**
+ * @brief A cache factory that, on top of what `exprstr_sinsp_filter_cache_factory`
+ * does, shares the result of boolean subexpressions across all the filters
+ * compiled with it. The filters form a DAG in which identical subexpressions
+ * are evaluated at most once per event. Subexpressions are identified by their
+ * normalized string: nested 'and'/'or' are flattened, their children are sorted
+ * and deduplicated, and double negations are removed.
+ */
+class subexpr_sinsp_filter_cache_factory : public exprstr_sinsp_filter_cache_factory {
+public:
+	virtual ~subexpr_sinsp_filter_cache_factory() = default;
+
+	void reset() override {
+		exprstr_sinsp_filter_cache_factory::reset();
+		m_subexpr_caches.clear();
+	}
+
+	std::shared_ptr<sinsp_filter_compare_cache> new_subexpr_cache(const ast_expr_t* e,
+	                                                              node_info_t& info) override {
+		return get_or_insert_ptr(normalized_string(e), m_subexpr_caches);
+	}
+
+	inline const std::unordered_map<std::string, std::shared_ptr<sinsp_filter_compare_cache>>&
+	subexpr_cache() const {
+		return m_subexpr_caches;
+	}
+
+	/**
+	 * @brief Returns the normalized string of a filter AST. Two ASTs with the
+	 * same normalized string always evaluate to the same result.
+	 */
+	static std::string normalized_string(const ast_expr_t* e);
+
+private:
+	std::unordered_map<std::string, std::shared_ptr<sinsp_filter_compare_cache>> m_subexpr_caches;
 };
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_ruleset.h>
+#include <libsinsp/filter/ppm_codes.h>
+
+#include <cstring>
+
+static const std::vector<size_t> s_no_filters;
+
+sinsp_filter_ruleset::sinsp_filter_ruleset(
+        const std::shared_ptr<sinsp_filter_factory>& factory,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
+        m_factory(factory),
+        m_cache_factory(cache_factory) {
+	if(!m_cache_factory) {
+		m_cache_factory = std::make_shared<subexpr_sinsp_filter_cache_factory>();
+	}
+}
+
+size_t sinsp_filter_ruleset::add(const std::string& fltstr, const std::string& source) {
+	libsinsp::filter::parser parser(fltstr);
+	std::unique_ptr<libsinsp::filter::ast::expr> ast;
+	try {
+		ast = parser.parse();
+	} catch(const sinsp_exception& e) {
+		throw sinsp_exception("filter error at " + parser.get_pos().as_string() + ": " +
+		                      e.what());
+	}
+	return add(ast.get(), source);
+}
+
+size_t sinsp_filter_ruleset::add(const libsinsp::filter::ast::expr* fltast,
+                                 const std::string& source) {
+	sinsp_filter_compiler compiler(m_factory, fltast, m_cache_factory);
+	auto filter = compiler.compile();
+	return add(std::move(filter), libsinsp::filter::ast::ppm_event_codes(fltast), source);
+}
+
+size_t sinsp_filter_ruleset::add(std::unique_ptr<sinsp_filter> filter,
+                                 const libsinsp::events::set<ppm_event_code>& codes,
+                                 const std::string& source) {
+	auto src = find_source(source.c_str());
+	if(src == nullptr) {
+		m_sources.push_back(std::make_unique<source_index>());
+		src = m_sources.back().get();
+		src->m_name = source;
+		src->m_filters.resize(PPM_EVENT_MAX);
+		// a new source may match an event source idx that was not resolved before
+		m_sources_by_idx.clear();
+		m_sources_by_idx_resolved.clear();
+	}
+
+	size_t idx = m_filters.size();
+	m_filters.push_back(std::move(filter));
+	codes.for_each([src, idx](ppm_event_code code) {
+		src->m_filters[code].push_back(idx);
+		return true;
+	});
+	return idx;
+}
+
+sinsp_filter_ruleset::source_index* sinsp_filter_ruleset::find_source(const char* name) {
+	for(auto& src : m_sources) {
+		if(src->m_name == name) {
+			return src.get();
+		}
+	}
+	return nullptr;
+}
+
+const sinsp_filter_ruleset::source_index* sinsp_filter_ruleset::source_of(const sinsp_evt* evt) {
+	auto name = evt->get_source_name();
+	if(name == sinsp_no_event_source_name) {
+		return find_source(sinsp_syscall_event_source_name);
+	}
+
+	// resolve the event source index only once, to avoid comparing
+	// the name of the source on every event
+	auto idx = evt->get_source_idx();
+	if(idx == sinsp_no_event_source_idx) {
+		return find_source(name);
+	}
+	if(idx >= m_sources_by_idx.size()) {
+		m_sources_by_idx.resize(idx + 1, nullptr);
+		m_sources_by_idx_resolved.resize(idx + 1, false);
+	}
+	if(!m_sources_by_idx_resolved[idx]) {
+		m_sources_by_idx[idx] = find_source(name);
+		m_sources_by_idx_resolved[idx] = true;
+	}
+	return m_sources_by_idx[idx];
+}
+
+bool sinsp_filter_ruleset::run(sinsp_evt* evt, std::vector<size_t>& matches) {
+	m_stats.m_num_events++;
+
+	auto src = source_of(evt);
+	auto code = evt->get_type();
+	if(src == nullptr || code >= PPM_EVENT_MAX) {
+		return false;
+	}
+
+	bool res = false;
+	const auto& filters = src->m_filters[code];
+	m_stats.m_num_filters_evaluated += filters.size();
+	for(auto idx : filters) {
+		if(m_filters[idx]->run(evt)) {
+			matches.push_back(idx);
+			m_stats.m_num_matches++;
+			res = true;
+		}
+	}
+	return res;
+}
+
+const std::vector<size_t>& sinsp_filter_ruleset::filters_for(const std::string& source,
+                                                              ppm_event_code code) const {
+	for(const auto& src : m_sources) {
+		if(src->m_name == source && code < PPM_EVENT_MAX) {
+			return src->m_filters[code];
+		}
+	}
+	return s_no_filters;
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <libsinsp/events/sinsp_events.h>
+#include <libsinsp/filter.h>
+#include <libsinsp/filter_cache.h>
+#include <libsinsp/sinsp_event_source.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @defgroup filter Filtering events
+ *  @{
+ */
+
+/*!
+  \brief A set of filters indexed by event source and event type, so that
+  evaluating an event only touches the filters that can match it. The event
+  types of a filter are derived from its AST, as in
+  libsinsp::filter::ast::ppm_event_codes().
+
+  The filters are compiled with a shared cache factory, by default a
+  subexpr_sinsp_filter_cache_factory, so that they also share the results
+  of their common subexpressions.
+*/
+class SINSP_PUBLIC sinsp_filter_ruleset {
+public:
+	struct stats_t {
+		// The number of events run through the ruleset
+		uint64_t m_num_events = 0;
+
+		// The number of filters evaluated, over all the events
+		uint64_t m_num_filters_evaluated = 0;
+
+		// The number of filters that matched, over all the events
+		uint64_t m_num_matches = 0;
+	};
+
+	explicit sinsp_filter_ruleset(
+	        const std::shared_ptr<sinsp_filter_factory>& factory,
+	        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory = nullptr);
+
+	/*!
+	  \brief Compiles a filter and adds it to the ruleset, the filter is
+	  evaluated on the events of the given source.
+	  \return The index of the filter in the ruleset.
+	  \note Throws a sinsp_exception if the filter is not valid
+	*/
+	size_t add(const std::string& fltstr,
+	           const std::string& source = sinsp_syscall_event_source_name);
+
+	size_t add(const libsinsp::filter::ast::expr* fltast,
+	           const std::string& source = sinsp_syscall_event_source_name);
+
+	/*!
+	  \brief Adds an already compiled filter, only evaluated on the events
+	  of the given source and types.
+	*/
+	size_t add(std::unique_ptr<sinsp_filter> filter,
+	           const libsinsp::events::set<ppm_event_code>& codes,
+	           const std::string& source = sinsp_syscall_event_source_name);
+
+	inline size_t size() const { return m_filters.size(); }
+
+	inline sinsp_filter& get(size_t idx) const { return *m_filters[idx]; }
+
+	/*!
+	  \brief Evaluates the filters that can match an event, and appends the
+	  indexes of the ones matching to `matches`, in increasing order.
+	  \return True if at least one filter matched.
+	  \note Events without a source name are considered as coming from the
+	  syscall event source.
+	*/
+	bool run(sinsp_evt* evt, std::vector<size_t>& matches);
+
+	/*!
+	  \brief Returns the indexes of the filters evaluated on the events of
+	  the given source and type.
+	*/
+	const std::vector<size_t>& filters_for(const std::string& source, ppm_event_code code) const;
+
+	inline const stats_t& stats() const { return m_stats; }
+
+	inline void reset_stats() { m_stats = {}; }
+
+	inline const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory() const {
+		return m_cache_factory;
+	}
+
+private:
+	struct source_index {
+		std::string m_name;
+		// for every event type, the filters to evaluate
+		std::vector<std::vector<size_t>> m_filters;
+	};
+
+	source_index* find_source(const char* name);
+
+	const source_index* source_of(const sinsp_evt* evt);
+
+	std::shared_ptr<sinsp_filter_factory> m_factory;
+	std::shared_ptr<sinsp_filter_cache_factory> m_cache_factory;
+	std::vector<std::unique_ptr<sinsp_filter>> m_filters;
+	std::vector<std::unique_ptr<source_index>> m_sources;
+	// index of the event source of the inspector -> source of the ruleset, resolved
+	// the first time an event of that source is seen
+	std::vector<const source_index*> m_sources_by_idx;
+	std::vector<bool> m_sources_by_idx_resolved;
+	stats_t m_stats;
+};
+
+/*@}*/
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_set.h>
+
+sinsp_filter_set::sinsp_filter_set(
+        const std::shared_ptr<sinsp_filter_factory>& factory,
+        const std::shared_ptr<subexpr_sinsp_filter_cache_factory>& cache_factory):
+        m_factory(factory),
+        m_cache_factory(cache_factory) {
+	if(!m_cache_factory) {
+		m_cache_factory = std::make_shared<subexpr_sinsp_filter_cache_factory>();
+	}
+}
+
+size_t sinsp_filter_set::add(const std::string& fltstr) {
+	sinsp_filter_compiler compiler(m_factory, fltstr, m_cache_factory);
+	return add(compiler);
+}
+
+size_t sinsp_filter_set::add(const libsinsp::filter::ast::expr* fltast) {
+	sinsp_filter_compiler compiler(m_factory, fltast, m_cache_factory);
+	return add(compiler);
+}
+
+size_t sinsp_filter_set::add(sinsp_filter_compiler& compiler) {
+	m_filters.push_back(compiler.compile());
+	m_results.resize((m_filters.size() + 63) / 64, 0);
+	return m_filters.size() - 1;
+}
+
+const std::vector<uint64_t>& sinsp_filter_set::run(sinsp_evt* evt) {
+	std::fill(m_results.begin(), m_results.end(), 0);
+	for(size_t i = 0; i < m_filters.size(); i++) {
+		if(m_filters[i]->run(evt)) {
+			m_results[i / 64] |= uint64_t(1) << (i % 64);
+		}
+	}
+	return m_results;
+}
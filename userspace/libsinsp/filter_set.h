@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <libsinsp/filter.h>
+#include <libsinsp/filter_cache.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @defgroup filter Filtering events
+ *  @{
+ */
+
+/*!
+  \brief A set of filters, e.g. the conditions of a ruleset, compiled into
+  a single DAG. The filters share the caches of their field extractions and
+  comparisons, and the results of their identical boolean subexpressions,
+  so that every distinct node is evaluated at most once per event.
+
+  \note Sharing results relies on the event number, events numbered 0 are
+  evaluated by every filter on its own.
+*/
+class SINSP_PUBLIC sinsp_filter_set {
+public:
+	/*!
+	  \brief Constructs the set
+
+	  \param factory Pointer to a filter factory to be used to build
+	  the filtercheck trees
+	  \param cache_factory The cache factory shared by the filters, a new
+	  one is created if null
+	*/
+	explicit sinsp_filter_set(
+	        const std::shared_ptr<sinsp_filter_factory>& factory,
+	        const std::shared_ptr<subexpr_sinsp_filter_cache_factory>& cache_factory = nullptr);
+
+	/*!
+	  \brief Compiles a filter and adds it to the set.
+	  \return The index of the filter in the set.
+	  \note Throws a sinsp_exception if the filter is not valid
+	*/
+	size_t add(const std::string& fltstr);
+
+	size_t add(const libsinsp::filter::ast::expr* fltast);
+
+	inline size_t size() const { return m_filters.size(); }
+
+	/*!
+	  \brief Evaluates all the filters of the set on an event.
+	  \return A bitmap of the results, in which bit (i % 64) of word (i / 64)
+	  is set if the filter at index i matched. The bitmap is valid until the
+	  next call.
+	*/
+	const std::vector<uint64_t>& run(sinsp_evt* evt);
+
+	/*!
+	  \brief Returns whether the filter at index idx matched in the last run.
+	*/
+	inline bool matched(size_t idx) const {
+		return (m_results[idx / 64] & (uint64_t(1) << (idx % 64))) != 0;
+	}
+
+	inline sinsp_filter& get(size_t idx) const { return *m_filters[idx]; }
+
+	inline const std::shared_ptr<subexpr_sinsp_filter_cache_factory>& cache_factory() const {
+		return m_cache_factory;
+	}
+
+private:
+	size_t add(sinsp_filter_compiler& compiler);
+
+	std::shared_ptr<sinsp_filter_factory> m_factory;
+	std::shared_ptr<subexpr_sinsp_filter_cache_factory> m_cache_factory;
+	std::vector<std::unique_ptr<sinsp_filter>> m_filters;
+	std::vector<uint64_t> m_results;
+};
+
+/*@}*/
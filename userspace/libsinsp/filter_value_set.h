@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <libsinsp/filter_value.h>
+
+//
+// Set of filter values used by the 'in' and 'intersects' operators, and by
+// equality operators with a modifier. Values are added while compiling the
+// filter and looked up on every event, so the set is built for lookups:
+// - the values are stored in a flat open-addressing table (linear probing),
+//   every slot keeps the length and part of the hash of its value, so a
+//   lookup usually touches a single cache line and compares the bytes of a
+//   value only when both match;
+// - values whose length is not in the set are rejected before hashing, with
+//   a bitmap of the lengths (modulo 64) and their min/max.
+//
+// The set does not own the bytes of the values, they must outlive it.
+//
+class filter_value_set {
+public:
+	filter_value_set() = default;
+
+	void insert(const filter_value_t& val) {
+		if(contains(val)) {
+			return;
+		}
+		if((m_size + 1) * 2 > m_slots.size()) {
+			grow();
+		}
+		insert_slot(m_slots, {val.first, val.second, tag(hash(val))});
+		m_size++;
+
+		m_len_mask |= len_bit(val.second);
+		if(val.second < m_min_len) {
+			m_min_len = val.second;
+		}
+		if(val.second > m_max_len) {
+			m_max_len = val.second;
+		}
+	}
+
+	inline bool contains(const filter_value_t& val) const {
+		if(val.second < m_min_len || val.second > m_max_len ||
+		   (m_len_mask & len_bit(val.second)) == 0) {
+			return false;
+		}
+
+		size_t h = hash(val);
+		uint32_t t = tag(h);
+		size_t mask = m_slots.size() - 1;
+		for(size_t i = h & mask;; i = (i + 1) & mask) {
+			const slot& s = m_slots[i];
+			if(s.tag == 0) {
+				return false;
+			}
+			if(s.tag == t && s.len == val.second && memcmp(s.ptr, val.first, val.second) == 0) {
+				return true;
+			}
+		}
+	}
+
+	// Removes all the values, the memory of the table is kept.
+	void clear() {
+		std::fill(m_slots.begin(), m_slots.end(), slot{});
+		m_size = 0;
+		m_len_mask = 0;
+		m_min_len = (std::numeric_limits<uint32_t>::max)();
+		m_max_len = 0;
+	}
+
+	inline size_t size() const { return m_size; }
+	inline bool empty() const { return m_size == 0; }
+
+private:
+	struct slot {
+		const uint8_t* ptr = nullptr;
+		uint32_t len = 0;
+		uint32_t tag = 0;  // 0 marks an empty slot
+	};
+
+	static constexpr size_t s_min_slots = 16;
+
+	static inline size_t hash(const filter_value_t& val) { return g_hash_membuf{}(val); }
+
+	// The low bits of the hash select the slot, the tag keeps the high ones.
+	static inline uint32_t tag(size_t h) { return (uint32_t)((uint64_t)h >> 32) | 1; }
+
+	static inline uint64_t len_bit(uint32_t len) { return uint64_t(1) << (len % 64); }
+
+	static void insert_slot(std::vector<slot>& slots, const slot& s) {
+		size_t mask = slots.size() - 1;
+		size_t i = hash({(uint8_t*)s.ptr, s.len}) & mask;
+		while(slots[i].tag != 0) {
+			i = (i + 1) & mask;
+		}
+		slots[i] = s;
+	}
+
+	void grow() {
+		std::vector<slot> slots(m_slots.empty() ? s_min_slots : m_slots.size() * 2);
+		for(const auto& s : m_slots) {
+			if(s.tag != 0) {
+				insert_slot(slots, s);
+			}
+		}
+		m_slots.swap(slots);
+	}
+
+	std::vector<slot> m_slots;
+	size_t m_size = 0;
+	uint64_t m_len_mask = 0;
+	uint32_t m_min_len = (std::numeric_limits<uint32_t>::max)();
+	uint32_t m_max_len = 0;
+};
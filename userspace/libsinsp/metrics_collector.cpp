@@ -18,8 +18,10 @@ limitations under the License.
 
 #include <libsinsp/sinsp_int.h>
 #include <libsinsp/metrics_collector.h>
+#include <libsinsp/filter.h>
 #include <libsinsp/plugin_manager.h>
 #include <cmath>
+#include <unordered_set>
 #include <re2/re2.h>
 
 #ifdef __linux__
@@ -251,16 +253,26 @@ libs_state_counters::libs_state_counters(const std::shared_ptr<sinsp_stats_v2>&
                                          sinsp_thread_manager* thread_manager):
         m_sinsp_stats_v2(sinsp_stats_v2),
         m_n_fds(0),
-        m_n_threads(0) {
+        m_n_threads(0),
+        m_args_env_saved_bytes(0) {
 	if(thread_manager != nullptr) {
 		m_n_threads = thread_manager->get_thread_count();
 		threadinfo_map_t* threadtable = thread_manager->get_threads();
 		if(threadtable != nullptr) {
-			threadtable->loop([this](sinsp_threadinfo& tinfo) {
+			// Every shared vector is counted once, the other references to it are saved copies.
+			std::unordered_set<const void*> shared;
+			auto count_shared = [this, &shared](const sinsp_shared_strvec& v) {
+				if(v.shared_id() != nullptr && !shared.insert(v.shared_id()).second) {
+					m_args_env_saved_bytes += v.byte_size();
+				}
+			};
+			threadtable->loop([this, &count_shared](sinsp_threadinfo& tinfo) {
 				sinsp_fdtable* fdtable = tinfo.get_fd_table();
 				if(fdtable != nullptr) {
 					this->m_n_fds += fdtable->size();
 				}
+				count_shared(tinfo.m_args);
+				count_shared(tinfo.m_env);
 				return true;
 			});
 		}
@@ -282,6 +294,12 @@ std::vector<metrics_v2> libs_state_counters::to_metrics() {
 	                                METRIC_VALUE_UNIT_COUNT,
 	                                METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT,
 	                                m_n_fds));
+	metrics.emplace_back(new_metric("args_env_saved_bytes",
+	                                METRICS_V2_STATE_COUNTERS,
+	                                METRIC_VALUE_TYPE_U64,
+	                                METRIC_VALUE_UNIT_MEMORY_BYTES,
+	                                METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT,
+	                                m_args_env_saved_bytes));
 
 	if(m_sinsp_stats_v2 == nullptr) {
 		return metrics;
@@ -437,6 +455,55 @@ void libs_metrics_collector::snapshot() {
 			m_metrics.insert(m_metrics.end(), plugin_metrics.begin(), plugin_metrics.end());
 		}
 	}
+
+	/*
+	 * filter profiles
+	 */
+	if(m_metrics_flags & METRICS_V2_FILTER_PROFILE) {
+		for(const auto& [name, filter] : m_filters) {
+			if(!filter->is_adaptive()) {
+				continue;
+			}
+			auto profile = filter->get_profile();
+			const auto& root = profile.front();
+			m_metrics.emplace_back(
+			        libsinsp_metrics::new_metric((N_FILTER_EVALS_PREFIX + name).c_str(),
+			                                     METRICS_V2_FILTER_PROFILE,
+			                                     METRIC_VALUE_TYPE_U64,
+			                                     METRIC_VALUE_UNIT_COUNT,
+			                                     METRIC_VALUE_METRIC_TYPE_MONOTONIC,
+			                                     root.m_num_evals));
+			m_metrics.emplace_back(
+			        libsinsp_metrics::new_metric((FILTER_COST_NS_PREFIX + name).c_str(),
+			                                     METRICS_V2_FILTER_PROFILE,
+			                                     METRIC_VALUE_TYPE_D,
+			                                     METRIC_VALUE_UNIT_TIME_NS,
+			                                     METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT,
+			                                     root.cost_ns()));
+			m_metrics.emplace_back(
+			        libsinsp_metrics::new_metric((FILTER_PASS_RATIO_PREFIX + name).c_str(),
+			                                     METRICS_V2_FILTER_PROFILE,
+			                                     METRIC_VALUE_TYPE_D,
+			                                     METRIC_VALUE_UNIT_RATIO,
+			                                     METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT,
+			                                     root.pass_rate()));
+			m_metrics.emplace_back(
+			        libsinsp_metrics::new_metric((N_FILTER_REORDERS_PREFIX + name).c_str(),
+			                                     METRICS_V2_FILTER_PROFILE,
+			                                     METRIC_VALUE_TYPE_U64,
+			                                     METRIC_VALUE_UNIT_COUNT,
+			                                     METRIC_VALUE_METRIC_TYPE_MONOTONIC,
+			                                     filter->get_num_reorders()));
+		}
+	}
+}
+
+void libs_metrics_collector::add_filter(const std::string& name, const sinsp_filter* filter) {
+	m_filters[name] = filter;
+}
+
+void libs_metrics_collector::remove_filter(const std::string& name) {
+	m_filters.erase(name);
 }
 
 const std::vector<metrics_v2>& libs_metrics_collector::get_metrics() const {
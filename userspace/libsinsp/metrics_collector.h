@@ -28,6 +28,8 @@ limitations under the License.
 #include <string_view>
 #include <map>
 
+class sinsp_filter;
+
 struct sinsp_stats_v2 {
 	///@(
 	/** fdtable state related counters, unit: count. */
@@ -306,6 +308,8 @@ private:
 	                   ///< with each active thread in the sinsp state thread table, unit: count.
 	uint64_t m_n_threads;  ///< Total number of threads currently stored in the sinsp state thread
 	                       ///< table, unit: count.
+	uint64_t m_args_env_saved_bytes;  ///< Memory saved by sharing the args and env of the threads
+	                                  ///< instead of copying them, unit: bytes.
 };
 
 class libs_metrics_collector {
@@ -328,6 +332,15 @@ public:
 	*/
 	std::vector<metrics_v2>& get_metrics();
 
+	/*!
+	\brief Registers a filter whose adaptive profile is reported under `name` when
+	METRICS_V2_FILTER_PROFILE is enabled (see sinsp_filter::set_adaptive()). The filter
+	must outlive the collector or be removed before being destroyed.
+	*/
+	void add_filter(const std::string& name, const sinsp_filter* filter);
+
+	void remove_filter(const std::string& name);
+
 private:
 	sinsp* m_inspector;
 	std::shared_ptr<sinsp_stats_v2> m_sinsp_stats_v2;
@@ -336,6 +349,7 @@ private:
 	                           METRICS_V2_PLUGINS | METRICS_V2_KERNEL_COUNTERS_PER_CPU |
 	                           METRICS_V2_KERNEL_ITER_COUNTERS;
 	std::vector<metrics_v2> m_metrics;
+	std::map<std::string, const sinsp_filter*> m_filters;
 };
 
 }  // namespace libs::metrics
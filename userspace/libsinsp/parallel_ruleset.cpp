@@ -0,0 +1,429 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/parallel_ruleset.h>
+#include <libsinsp/filter/ppm_codes.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+
+// The fields whose comparisons read the state of the inspector instead of
+// comparing the extracted values, see their compare_nocache() overrides
+static bool compares_from_state(const std::string& field, const std::optional<std::string>& arg) {
+	if(field == "fd.ip" || field == "fd.port" || field == "fd.proto" || field == "fd.net" ||
+	   field == "fd.cip.name" || field == "fd.sip.name" || field == "fd.lip.name" ||
+	   field == "fd.rip.name") {
+		return true;
+	}
+	if(field == "proc.apid" || field == "proc.aname" || field == "proc.aexe" ||
+	   field == "proc.aexepath" || field == "proc.acmdline" || field == "proc.aenv") {
+		return !arg.has_value();
+	}
+	return false;
+}
+
+namespace {
+struct worker_fields_checker : public libsinsp::filter::ast::const_base_expr_visitor {
+	using libsinsp::filter::ast::const_base_expr_visitor::visit;
+
+	void visit(const libsinsp::filter::ast::transformer_list_expr* e) override {
+		for(auto& c : e->children) {
+			c->accept(this);
+		}
+	}
+
+	void visit(const libsinsp::filter::ast::field_expr* e) override {
+		if(compares_from_state(e->field, e->arg)) {
+			throw sinsp_exception("filter error: field '" + libsinsp::filter::ast::as_string(e) +
+			                      "' can't be evaluated on a worker thread");
+		}
+	}
+};
+}  // namespace
+
+// Gives the filters and formatters of a worker the extraction caches of
+// their fields, filled by the worker with the values extracted by submit()
+class sinsp_parallel_ruleset::worker_cache_factory : public subexpr_sinsp_filter_cache_factory {
+public:
+	explicit worker_cache_factory(sinsp_parallel_ruleset* owner): m_owner(owner) {}
+
+	std::shared_ptr<sinsp_filter_extract_cache> new_extract_cache(const ast_expr_t* e,
+	                                                              node_info_t& info) override {
+		auto key = libsinsp::filter::ast::as_string(e);
+		if(info.m_field && info.m_field->m_type == PT_IPNET) {
+			throw sinsp_exception("filter error: field '" + key +
+			                      "' can't be evaluated on a worker thread");
+		}
+
+		auto field = m_owner->register_field(e, key);
+		auto cache = get_or_insert_ptr(key, m_extract_caches);
+		if(field >= m_by_field.size()) {
+			m_by_field.resize(field + 1);
+		}
+		m_by_field[field] = cache;
+		return cache;
+	}
+
+	inline sinsp_filter_extract_cache& cache_of(uint32_t field) { return *m_by_field[field]; }
+
+private:
+	sinsp_parallel_ruleset* m_owner;
+	std::vector<std::shared_ptr<sinsp_filter_extract_cache>> m_by_field;
+};
+
+sinsp_parallel_ruleset::sinsp_parallel_ruleset(sinsp* inspector,
+                                               filter_check_list& available_checks,
+                                               uint32_t num_workers,
+                                               uint32_t max_pending):
+        m_inspector(inspector),
+        m_available_checks(available_checks),
+        m_factory(std::make_shared<sinsp_filter_factory>(inspector, available_checks)),
+        m_num_threads(num_workers),
+        m_max_pending(std::max<uint32_t>(max_pending, 1)) {
+	m_jobs.reset(new job[m_max_pending]);
+
+	// without threads, a single worker is run by submit()
+	for(uint32_t i = 0; i < std::max<uint32_t>(num_workers, 1); i++) {
+		auto w = std::make_unique<worker>();
+		w->m_caches = std::make_shared<worker_cache_factory>(this);
+		w->m_ruleset = std::make_unique<sinsp_filter_ruleset>(m_factory, w->m_caches);
+		m_workers.push_back(std::move(w));
+	}
+}
+
+sinsp_parallel_ruleset::~sinsp_parallel_ruleset() {
+	m_stop = true;
+	for(auto& w : m_workers) {
+		if(w->m_thread.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(w->m_mtx);
+			}
+			w->m_cv.notify_all();
+			w->m_thread.join();
+		}
+	}
+}
+
+size_t sinsp_parallel_ruleset::add(const std::string& fltstr,
+                                   const std::string& format,
+                                   const std::string& source) {
+	if(m_started) {
+		throw sinsp_exception("filters can't be added after events were submitted");
+	}
+
+	libsinsp::filter::parser parser(fltstr);
+	std::unique_ptr<libsinsp::filter::ast::expr> ast;
+	try {
+		ast = parser.parse();
+	} catch(const sinsp_exception& e) {
+		throw sinsp_exception("filter error at " + parser.get_pos().as_string() + ": " +
+		                      e.what());
+	}
+	worker_fields_checker checker;
+	ast->accept(&checker);
+
+	// every worker evaluates its own copy of the filter and of the formatter,
+	// which also registers the fields they use
+	m_added_fields.clear();
+	for(auto& w : m_workers) {
+		std::unique_ptr<sinsp_evt_formatter> formatter;
+		if(!format.empty()) {
+			formatter = std::make_unique<sinsp_evt_formatter>(m_inspector,
+			                                                  m_available_checks,
+			                                                  w->m_caches);
+			formatter->set_format(sinsp_evt_formatter::OF_NORMAL, format);
+		}
+		w->m_ruleset->add(ast.get(), source);
+		w->m_formatters.push_back(std::move(formatter));
+	}
+	std::sort(m_added_fields.begin(), m_added_fields.end());
+	m_added_fields.erase(std::unique(m_added_fields.begin(), m_added_fields.end()),
+	                     m_added_fields.end());
+
+	source_fields* src = nullptr;
+	for(auto& s : m_sources) {
+		if(s->m_name == source) {
+			src = s.get();
+		}
+	}
+	if(src == nullptr) {
+		m_sources.push_back(std::make_unique<source_fields>());
+		src = m_sources.back().get();
+		src->m_name = source;
+		src->m_active.resize(PPM_EVENT_MAX, false);
+		src->m_fields.resize(PPM_EVENT_MAX);
+		m_sources_by_idx.clear();
+		m_sources_by_idx_resolved.clear();
+	}
+
+	// the events the filter applies to need all of its fields
+	libsinsp::filter::ast::ppm_event_codes(ast.get()).for_each([this, src](ppm_event_code code) {
+		src->m_active[code] = true;
+		auto& fields = src->m_fields[code];
+		fields.insert(fields.end(), m_added_fields.begin(), m_added_fields.end());
+		std::sort(fields.begin(), fields.end());
+		fields.erase(std::unique(fields.begin(), fields.end()), fields.end());
+		return true;
+	});
+
+	return m_num_filters++;
+}
+
+uint32_t sinsp_parallel_ruleset::register_field(const libsinsp::filter::ast::expr* e,
+                                                const std::string& key) {
+	uint32_t field;
+	auto it = m_field_ids.find(key);
+	if(it != m_field_ids.end()) {
+		field = it->second;
+	} else {
+		field = static_cast<uint32_t>(m_extractors.size());
+		m_extractors.push_back(sinsp_extractor_compiler(m_factory, e).compile());
+		m_field_ids.emplace(key, field);
+	}
+	m_added_fields.push_back(field);
+	return field;
+}
+
+const sinsp_parallel_ruleset::source_fields* sinsp_parallel_ruleset::fields_of(
+        const sinsp_evt* evt) {
+	auto find_source = [this](const char* name) -> const source_fields* {
+		for(const auto& src : m_sources) {
+			if(src->m_name == name) {
+				return src.get();
+			}
+		}
+		return nullptr;
+	};
+
+	auto name = evt->get_source_name();
+	if(name == sinsp_no_event_source_name) {
+		return find_source(sinsp_syscall_event_source_name);
+	}
+
+	auto idx = evt->get_source_idx();
+	if(idx == sinsp_no_event_source_idx) {
+		return find_source(name);
+	}
+	if(idx >= m_sources_by_idx.size()) {
+		m_sources_by_idx.resize(idx + 1, nullptr);
+		m_sources_by_idx_resolved.resize(idx + 1, false);
+	}
+	if(!m_sources_by_idx_resolved[idx]) {
+		m_sources_by_idx[idx] = find_source(name);
+		m_sources_by_idx_resolved[idx] = true;
+	}
+	return m_sources_by_idx[idx];
+}
+
+void sinsp_parallel_ruleset::start() {
+	m_started = true;
+	for(uint32_t i = 0; i < m_num_threads; i++) {
+		m_workers[i]->m_thread = std::thread(&sinsp_parallel_ruleset::run_worker, this, i);
+	}
+}
+
+void sinsp_parallel_ruleset::submit(sinsp_evt* evt) {
+	m_stats.m_num_submitted++;
+
+	auto src = fields_of(evt);
+	auto code = evt->get_type();
+	if(src == nullptr || code >= PPM_EVENT_MAX || !src->m_active[code]) {
+		return;
+	}
+
+	if(!m_started) {
+		start();
+	}
+
+	// the slot is free once the matches of its previous event are delivered
+	uint64_t seq = m_next_seq;
+	if(seq >= m_next_delivery + m_max_pending) {
+		m_stats.m_num_waits++;
+		wait_done(slot_of(m_next_delivery), m_next_delivery);
+		deliver(false);
+	}
+
+	// copy the event along with the values of the fields it needs, the
+	// workers never read the state of the inspector
+	auto& j = slot_of(seq);
+	auto pevt = reinterpret_cast<const uint8_t*>(evt->get_scap_evt());
+	j.m_evt.assign(pevt, pevt + evt->get_scap_evt()->len);
+	j.m_evtnum = evt->get_num();
+	j.m_cpuid = evt->get_cpuid();
+	j.m_source_idx = evt->get_source_idx();
+	j.m_source_name = evt->get_source_name();
+	j.m_fields.clear();
+	j.m_values.clear();
+	j.m_data.clear();
+	m_offsets.clear();
+	for(auto field : src->m_fields[code]) {
+		field_values fv;
+		fv.m_field = field;
+		fv.m_first = static_cast<uint32_t>(j.m_values.size());
+		m_values.clear();
+		fv.m_res = m_extractors[field]->extract(evt, m_values);
+		fv.m_num = fv.m_res ? static_cast<uint32_t>(m_values.size()) : 0;
+		for(uint32_t i = 0; i < fv.m_num; i++) {
+			const auto& v = m_values[i];
+			m_offsets.push_back(static_cast<uint32_t>(j.m_data.size()));
+			j.m_values.push_back(extract_value_t{nullptr, v.len});
+			if(v.len > 0) {
+				j.m_data.insert(j.m_data.end(), v.ptr, v.ptr + v.len);
+			}
+			// string values are compared and printed up to their terminator
+			j.m_data.push_back(0);
+		}
+		j.m_fields.push_back(fv);
+	}
+	for(size_t i = 0; i < j.m_values.size(); i++) {
+		j.m_values[i].ptr = j.m_data.data() + m_offsets[i];
+	}
+	j.m_matches.clear();
+	j.m_error = nullptr;
+
+	m_next_seq++;
+	m_stats.m_num_evaluated++;
+
+	if(m_num_threads == 0) {
+		evaluate(*m_workers[0], j, seq);
+		j.m_done = seq;
+		return;
+	}
+
+	// the flags are sequentially consistent, either the worker sees the
+	// event before sleeping, or it's notified
+	j.m_submitted = seq;
+	auto& w = *m_workers[seq % m_workers.size()];
+	if(w.m_waiting) {
+		std::lock_guard<std::mutex> lock(w.m_mtx);
+		w.m_cv.notify_one();
+	}
+}
+
+void sinsp_parallel_ruleset::run_worker(uint32_t idx) {
+	auto& w = *m_workers[idx];
+	uint64_t n = m_workers.size();
+
+	// the worker evaluates every n-th event, in order
+	uint64_t seq = idx == 0 ? n : idx;
+	while(true) {
+		auto& j = slot_of(seq);
+		if(j.m_submitted != seq) {
+			std::unique_lock<std::mutex> lock(w.m_mtx);
+			w.m_waiting = true;
+			w.m_cv.wait(lock, [&]() { return m_stop || j.m_submitted == seq; });
+			w.m_waiting = false;
+			if(m_stop) {
+				return;
+			}
+		}
+
+		evaluate(w, j, seq);
+
+		j.m_done = seq;
+		if(m_capture_waiting) {
+			std::lock_guard<std::mutex> lock(m_done_mtx);
+			m_done_cv.notify_all();
+		}
+		seq += n;
+	}
+}
+
+void sinsp_parallel_ruleset::evaluate(worker& w, job& j, uint64_t seq) {
+	try {
+		// the event is numbered by its sequence, so that the caches of the
+		// worker are valid for this event only
+		auto& evt = w.m_evt;
+		evt.init_from_raw(j.m_evt.data(), j.m_cpuid);
+		evt.set_num(seq);
+		evt.set_source_idx(j.m_source_idx);
+		evt.set_source_name(j.m_source_name);
+		for(const auto& f : j.m_fields) {
+			auto first = j.m_values.begin() + f.m_first;
+			w.m_values.assign(first, first + f.m_num);
+			w.m_caches->cache_of(f.m_field).update(&evt, f.m_res, w.m_values);
+		}
+
+		w.m_matches.clear();
+		w.m_ruleset->run(&evt, w.m_matches);
+		for(auto idx : w.m_matches) {
+			match m;
+			m.m_evtnum = j.m_evtnum;
+			m.m_ts = evt.get_ts();
+			m.m_filter = idx;
+			if(w.m_formatters[idx]) {
+				w.m_formatters[idx]->tostring(&evt, m.m_output);
+			}
+			j.m_matches.push_back(std::move(m));
+		}
+	} catch(...) {
+		j.m_error = std::current_exception();
+	}
+}
+
+void sinsp_parallel_ruleset::wait_done(job& j, uint64_t seq) {
+	if(j.m_done == seq) {
+		return;
+	}
+	std::unique_lock<std::mutex> lock(m_done_mtx);
+	m_capture_waiting = true;
+	m_done_cv.wait(lock, [&]() { return j.m_done == seq; });
+	m_capture_waiting = false;
+}
+
+void sinsp_parallel_ruleset::deliver(bool wait_all) {
+	while(m_next_delivery < m_next_seq) {
+		auto& j = slot_of(m_next_delivery);
+		if(wait_all) {
+			wait_done(j, m_next_delivery);
+		} else if(j.m_done != m_next_delivery) {
+			break;
+		}
+		m_next_delivery++;
+
+		if(j.m_error) {
+			auto err = j.m_error;
+			j.m_error = nullptr;
+			std::rethrow_exception(err);
+		}
+		m_stats.m_num_matches += j.m_matches.size();
+		for(auto& m : j.m_matches) {
+			m_ready.push_back(std::move(m));
+		}
+	}
+}
+
+void sinsp_parallel_ruleset::take_ready(std::vector<match>& matches) {
+	for(auto& m : m_ready) {
+		matches.push_back(std::move(m));
+	}
+	m_ready.clear();
+}
+
+bool sinsp_parallel_ruleset::poll(std::vector<match>& matches) {
+	deliver(false);
+	bool res = !m_ready.empty();
+	take_ready(matches);
+	return res;
+}
+
+void sinsp_parallel_ruleset::flush(std::vector<match>& matches) {
+	deliver(true);
+	take_ready(matches);
+}
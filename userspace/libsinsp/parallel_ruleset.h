@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <libsinsp/eventformatter.h>
+#include <libsinsp/filter_ruleset.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/** @defgroup filter Filtering events
+ *  @{
+ */
+
+/*!
+  \brief A set of filters, each with an optional output format, evaluated on
+  a pool of worker threads after the inspector has parsed an event.
+
+  The state of the inspector (threads, fds, ...) keeps changing while the
+  workers run, so they never read it: when an event is submitted, the values
+  of all the fields that the filters of its source and type (and their
+  formats) use are extracted on the calling thread and copied along with the
+  event. The workers only compare and format those values, through the
+  extraction caches of their own copy of the filters. The filters whose
+  comparisons read the state without extracting a value (e.g. fd.ip, or
+  proc.aname without an argument) can't be evaluated on a copy and are
+  rejected by add(), as are the ipnet fields, whose values are never cached.
+
+  The events are spread over the workers in the order they are submitted,
+  and the matches are delivered in the same order. At most `max_pending`
+  events are in flight, submit() waits for the oldest one to be evaluated
+  when the limit is reached. Without workers, the events are evaluated by
+  submit() itself.
+*/
+class SINSP_PUBLIC sinsp_parallel_ruleset {
+public:
+	struct match {
+		// The number and timestamp of the matching event
+		uint64_t m_evtnum = 0;
+		uint64_t m_ts = 0;
+
+		// The index of the matching filter
+		size_t m_filter = 0;
+
+		// The output of the filter for the event, empty if it has no format
+		std::string m_output;
+	};
+
+	struct stats_t {
+		// The number of events submitted
+		uint64_t m_num_submitted = 0;
+
+		// The number of events handed to the workers, the others could not
+		// match any filter
+		uint64_t m_num_evaluated = 0;
+
+		// The number of matches delivered
+		uint64_t m_num_matches = 0;
+
+		// The number of times submit() waited for the workers
+		uint64_t m_num_waits = 0;
+	};
+
+	sinsp_parallel_ruleset(sinsp* inspector,
+	                       filter_check_list& available_checks,
+	                       uint32_t num_workers,
+	                       uint32_t max_pending = 1024);
+	~sinsp_parallel_ruleset();
+
+	sinsp_parallel_ruleset(const sinsp_parallel_ruleset&) = delete;
+	sinsp_parallel_ruleset& operator=(const sinsp_parallel_ruleset&) = delete;
+
+	/*!
+	  \brief Compiles a filter and its output format, and adds it to the
+	  ruleset. The filter is evaluated on the events of the given source.
+	  \return The index of the filter in the ruleset.
+	  \note Throws a sinsp_exception if the filter or the format are not
+	  valid, if they use fields that can't be evaluated on a worker, or if
+	  events were already submitted.
+	*/
+	size_t add(const std::string& fltstr,
+	           const std::string& format = "",
+	           const std::string& source = sinsp_syscall_event_source_name);
+
+	inline size_t size() const { return m_num_filters; }
+
+	inline uint32_t num_workers() const { return m_num_threads; }
+
+	/*!
+	  \brief Hands an event to the workers, it must have been processed by
+	  the inspector already. The event can be reused as soon as this returns.
+	*/
+	void submit(sinsp_evt* evt);
+
+	/*!
+	  \brief Appends to `matches` the matches of the events evaluated so far,
+	  in the order the events were submitted, without waiting.
+	  \return True if at least one match was appended.
+	  \note Rethrows the exceptions raised while evaluating the events.
+	*/
+	bool poll(std::vector<match>& matches);
+
+	/*!
+	  \brief Waits for all the submitted events to be evaluated, and appends
+	  their matches to `matches` in the order the events were submitted.
+	*/
+	void flush(std::vector<match>& matches);
+
+	inline const stats_t& stats() const { return m_stats; }
+
+private:
+	// The values of a field extracted from an event
+	struct field_values {
+		uint32_t m_field;
+		bool m_res;
+		uint32_t m_first;  // first value in job::m_values
+		uint32_t m_num;
+	};
+
+	// An event in flight, and its matches once evaluated. The slot of event
+	// `seq` is reused by event `seq + max_pending` once its matches have
+	// been delivered.
+	struct job {
+		std::atomic<uint64_t> m_submitted{0};  // seq of the event, once filled
+		std::atomic<uint64_t> m_done{0};       // seq of the event, once evaluated
+
+		uint64_t m_evtnum = 0;
+		uint16_t m_cpuid = 0;
+		size_t m_source_idx = 0;
+		const char* m_source_name = nullptr;
+		std::vector<uint8_t> m_evt;
+		std::vector<field_values> m_fields;
+		std::vector<extract_value_t> m_values;
+		std::vector<uint8_t> m_data;
+
+		std::vector<match> m_matches;
+		std::exception_ptr m_error;
+	};
+
+	// The fields to extract for the events of a source, by event type
+	struct source_fields {
+		std::string m_name;
+		std::vector<bool> m_active;  // whether any filter applies
+		std::vector<std::vector<uint32_t>> m_fields;
+	};
+
+	class worker_cache_factory;
+
+	struct worker {
+		std::shared_ptr<worker_cache_factory> m_caches;
+		std::unique_ptr<sinsp_filter_ruleset> m_ruleset;
+		std::vector<std::unique_ptr<sinsp_evt_formatter>> m_formatters;
+		sinsp_evt m_evt;
+		std::vector<size_t> m_matches;
+		std::vector<extract_value_t> m_values;
+
+		std::mutex m_mtx;
+		std::condition_variable m_cv;
+		std::atomic<bool> m_waiting{false};
+		std::thread m_thread;
+	};
+
+	// Returns the index of the field extracted for an AST node, registering it.
+	uint32_t register_field(const libsinsp::filter::ast::expr* e, const std::string& key);
+
+	const source_fields* fields_of(const sinsp_evt* evt);
+	void start();
+	void run_worker(uint32_t idx);
+	void evaluate(worker& w, job& j, uint64_t seq);
+	inline job& slot_of(uint64_t seq) { return m_jobs[seq % m_max_pending]; }
+	void wait_done(job& j, uint64_t seq);
+	void deliver(bool wait_all);
+	void take_ready(std::vector<match>& matches);
+
+	sinsp* m_inspector;
+	filter_check_list& m_available_checks;
+	std::shared_ptr<sinsp_filter_factory> m_factory;
+	uint32_t m_num_threads;
+	uint32_t m_max_pending;
+	size_t m_num_filters = 0;
+
+	// the fields extracted on the calling thread, indexed by the string of
+	// their AST node, and the ones used by the filter being added
+	std::unordered_map<std::string, uint32_t> m_field_ids;
+	std::vector<std::unique_ptr<sinsp_filter_check>> m_extractors;
+	std::vector<uint32_t> m_added_fields;
+	std::vector<std::unique_ptr<source_fields>> m_sources;
+	std::vector<const source_fields*> m_sources_by_idx;
+	std::vector<bool> m_sources_by_idx_resolved;
+	std::vector<extract_value_t> m_values;
+	std::vector<uint32_t> m_offsets;
+
+	std::unique_ptr<job[]> m_jobs;
+	uint64_t m_next_seq = 1;
+	uint64_t m_next_delivery = 1;
+	std::vector<match> m_ready;
+
+	std::vector<std::unique_ptr<worker>> m_workers;
+	bool m_started = false;
+	std::atomic<bool> m_stop{false};
+	std::mutex m_done_mtx;
+	std::condition_variable m_done_cv;
+	std::atomic<bool> m_capture_waiting{false};
+
+	stats_t m_stats;
+};
+
+/*@}*/
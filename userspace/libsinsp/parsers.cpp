@@ -1514,6 +1514,8 @@ void sinsp_parser::parse_execve_exit(sinsp_evt &evt, sinsp_parser_verdict &verdi
 	//
 	if(evt.get_tinfo()->is_invalid()) {
 		evt.get_tinfo()->m_ptid = evt.get_param(5)->as<uint64_t>();
+		// What /proc showed before the execve is stale, don't wait for it.
+		evt.get_tinfo()->m_partial = false;
 
 		/* We are not in a namespace we recover also vtid and vpid */
 		if((evt.get_tinfo()->m_flags & PPM_CL_CHILD_IN_PIDNS) == 0) {
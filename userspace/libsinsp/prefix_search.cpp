@@ -23,26 +23,79 @@ limitations under the License.
 using namespace std;
 
 void path_prefix_search::add_search_path(const char *path) {
-	bool dummy = true;
-	return path_prefix_map<bool>::add_search_path(path, dummy);
+	filter_value_t mem((uint8_t *)path, (uint32_t)strlen(path));
+	add_search_path(mem);
 }
 
 void path_prefix_search::add_search_path(const filter_value_t &path) {
 	bool dummy = true;
+	add_literal_path(path);
 	return path_prefix_map<bool>::add_search_path(path, dummy);
 }
 
 void path_prefix_search::add_search_path(const std::string &str) {
-	bool dummy = true;
-	return path_prefix_map<bool>::add_search_path(str, dummy);
+	filter_value_t mem((uint8_t *)str.c_str(), (uint32_t)str.length());
+	add_search_path(mem);
+}
+
+void path_prefix_search::add_literal_path(const filter_value_t &path) {
+	path_prefix_map_ut::filter_components_t components;
+	path_prefix_map_ut::split_path(path, components);
+
+	std::string normalized;
+	for(const auto &comp : components) {
+		if(comp.find_first_of("?*[") != std::string::npos) {
+			m_has_globs = true;
+			return;
+		}
+		normalized += "/" + comp;
+	}
+
+	if(normalized.empty()) {
+		m_match_all = true;
+		return;
+	}
+
+	m_literal_paths_storage.push_back(std::move(normalized));
+	const std::string &stored = m_literal_paths_storage.back();
+	m_literal_paths.insert(filter_value_t((uint8_t *)stored.data(), (uint32_t)stored.size()));
 }
 
 bool path_prefix_search::match(const char *path) {
-	const bool *val = path_prefix_map<bool>::match(path);
-	return (val != NULL);
+	filter_value_t mem((uint8_t *)path, (uint32_t)strlen(path));
+	return match(mem);
 }
 
 bool path_prefix_search::match(const filter_value_t &path) {
+	if(!m_has_globs) {
+		if(m_match_all) {
+			return true;
+		}
+
+		// Look up every prefix of the path ending at a component boundary. This only works
+		// if the path is written as the search paths are: absolute and without empty
+		// components, the other paths go through the generic match below.
+		const uint8_t *p = path.first;
+		uint32_t len = path.second;
+		bool normalized = len > 0 && p[0] == '/';
+		for(uint32_t i = 1; normalized && i <= len; i++) {
+			if(i < len && p[i] != '/') {
+				continue;
+			}
+			if(p[i - 1] == '/') {
+				// a trailing '/' is fine, an empty component is not
+				normalized = i == len;
+				break;
+			}
+			if(m_literal_paths.contains(filter_value_t((uint8_t *)p, i))) {
+				return true;
+			}
+		}
+		if(normalized) {
+			return false;
+		}
+	}
+
 	const bool *val = path_prefix_map<bool>::match(path);
 	return (val != NULL);
 }
@@ -27,6 +27,7 @@ limitations under the License.
 #include <unordered_map>
 
 #include <libsinsp/filter_value.h>
+#include <libsinsp/filter_value_set.h>
 #include <libsinsp/utils.h>
 
 namespace path_prefix_map_ut {
@@ -410,4 +411,16 @@ public:
 	bool match(const filter_value_t &path);
 
 	std::string as_string();
+
+private:
+	void add_literal_path(const filter_value_t &path);
+
+	// Search paths without glob characters, stored as /comp1/comp2. When
+	// there are no glob search paths, a normalized path can be matched by
+	// looking up its prefixes in this set, without splitting it into
+	// components.
+	std::list<std::string> m_literal_paths_storage;
+	filter_value_set m_literal_paths;
+	bool m_has_globs = false;
+	bool m_match_all = false;  // "/" is a search path
 };
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//
+// Copy-on-write vector of strings, used for the arguments and the environment
+// of the threads. The same values are usually held by many threads (all the
+// threads of a process, all the workers forked by a server, ...), so:
+// - copies share the same vector, cloning a thread only takes a reference;
+// - assigned values are interned in a process-wide pool, threads that load
+//   the same values separately (e.g. from /proc) end up sharing them too;
+// - read access is const only, so it never unshares the vector. Writes go
+//   through the explicit mutators, or through edit(), which make a private
+//   copy of the vector first when it is shared.
+//
+class sinsp_shared_strvec {
+public:
+	using vec_t = std::vector<std::string>;
+	using value_type = std::string;
+	using size_type = vec_t::size_type;
+	using const_iterator = vec_t::const_iterator;
+
+	sinsp_shared_strvec() = default;
+	sinsp_shared_strvec(const vec_t& v) { assign(vec_t(v)); }
+	sinsp_shared_strvec(vec_t&& v) { assign(std::move(v)); }
+	sinsp_shared_strvec(std::initializer_list<std::string> l) { assign(vec_t(l)); }
+
+	sinsp_shared_strvec& operator=(const vec_t& v) {
+		assign(vec_t(v));
+		return *this;
+	}
+
+	sinsp_shared_strvec& operator=(vec_t&& v) {
+		assign(std::move(v));
+		return *this;
+	}
+
+	inline const vec_t& get() const { return m_rep ? m_rep->m_vec : empty_vec(); }
+	inline operator const vec_t&() const { return get(); }
+
+	inline size_type size() const { return get().size(); }
+	inline bool empty() const { return get().empty(); }
+	inline const std::string& operator[](size_type i) const { return get()[i]; }
+	inline const std::string& at(size_type i) const { return get().at(i); }
+	inline const std::string& front() const { return get().front(); }
+	inline const std::string& back() const { return get().back(); }
+	inline const_iterator begin() const { return get().begin(); }
+	inline const_iterator end() const { return get().end(); }
+	inline const_iterator cbegin() const { return get().cbegin(); }
+	inline const_iterator cend() const { return get().cend(); }
+
+	inline bool operator==(const sinsp_shared_strvec& o) const {
+		return m_rep == o.m_rep || get() == o.get();
+	}
+	inline bool operator!=(const sinsp_shared_strvec& o) const { return !(*this == o); }
+	inline bool operator==(const vec_t& o) const { return get() == o; }
+	inline bool operator!=(const vec_t& o) const { return get() != o; }
+
+	// Replaces the values, interning them.
+	void assign(vec_t&& v) {
+		if(v.empty()) {
+			m_rep.reset();
+			return;
+		}
+		m_rep = pool().intern(std::move(v));
+	}
+
+	// Returns the vector for in-place changes, it is not interned anymore.
+	vec_t& edit() {
+		if(!m_rep) {
+			m_rep = std::make_shared<rep>();
+		} else if(m_rep->m_interned || m_rep.use_count() > 1) {
+			auto r = std::make_shared<rep>();
+			r->m_vec = m_rep->m_vec;
+			m_rep = std::move(r);
+		}
+		return m_rep->m_vec;
+	}
+
+	void clear() { m_rep.reset(); }
+	void push_back(const std::string& s) { edit().push_back(s); }
+	void push_back(std::string&& s) { edit().push_back(std::move(s)); }
+
+	template<typename... Args>
+	std::string& emplace_back(Args&&... args) {
+		return edit().emplace_back(std::forward<Args>(args)...);
+	}
+
+	// Identifies the storage of the values: copies and vectors interned with
+	// the same values share it. Null when empty.
+	inline const void* shared_id() const { return m_rep.get(); }
+
+	// Approximate memory held by the values.
+	inline size_t byte_size() const { return m_rep ? m_rep->byte_size() : 0; }
+
+	// Number of vectors currently interned, for all the instances.
+	static size_t interned_count() { return pool().size(); }
+
+private:
+	struct rep {
+		vec_t m_vec;
+		size_t m_hash = 0;
+		size_t m_bytes = 0;  // only computed for interned vectors, they never change
+		bool m_interned = false;
+
+		size_t byte_size() const {
+			if(m_interned) {
+				return m_bytes;
+			}
+			size_t res = sizeof(rep);
+			for(const auto& s : m_vec) {
+				res += sizeof(std::string) + s.size();
+			}
+			return res;
+		}
+	};
+
+	// Interned vectors are indexed by the hash of their values, the pool only
+	// keeps weak references, and the last owner of a vector removes it.
+	class strvec_pool {
+	public:
+		std::shared_ptr<rep> intern(vec_t&& v) {
+			size_t h = hash(v);
+			std::lock_guard<std::mutex> lock(m_mtx);
+			auto range = m_entries.equal_range(h);
+			for(auto it = range.first; it != range.second; ++it) {
+				// The entry is removed before its vector is deleted, so it can be
+				// read here. Only matching vectors are locked: dropping a locked
+				// reference could release a vector, and take the mutex again.
+				if(it->second.m_ptr->m_vec == v) {
+					if(auto r = it->second.m_ref.lock()) {
+						return r;
+					}
+				}
+			}
+
+			auto* raw = new rep();
+			raw->m_vec = std::move(v);
+			raw->m_hash = h;
+			raw->m_bytes = raw->byte_size();
+			raw->m_interned = true;
+			std::shared_ptr<rep> r(raw, [this](rep* p) { release(p); });
+			m_entries.emplace(h, entry{raw, r});
+			return r;
+		}
+
+		size_t size() {
+			std::lock_guard<std::mutex> lock(m_mtx);
+			return m_entries.size();
+		}
+
+	private:
+		struct entry {
+			const rep* m_ptr;
+			std::weak_ptr<rep> m_ref;
+		};
+
+		static size_t hash(const vec_t& v) {
+			size_t h = v.size();
+			for(const auto& s : v) {
+				h ^= std::hash<std::string>{}(s) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			}
+			return h;
+		}
+
+		void release(rep* p) {
+			{
+				std::lock_guard<std::mutex> lock(m_mtx);
+				auto range = m_entries.equal_range(p->m_hash);
+				for(auto it = range.first; it != range.second; ++it) {
+					if(it->second.m_ptr == p) {
+						m_entries.erase(it);
+						break;
+					}
+				}
+			}
+			delete p;
+		}
+
+		std::mutex m_mtx;
+		std::unordered_multimap<size_t, entry> m_entries;
+	};
+
+	// Never destroyed: vectors may still be released during static destruction.
+	static strvec_pool& pool() {
+		static strvec_pool* s_pool = new strvec_pool();
+		return *s_pool;
+	}
+
+	static const vec_t& empty_vec() {
+		static const vec_t s_empty;
+		return s_empty;
+	}
+
+	std::shared_ptr<rep> m_rep;
+};
+
+// Lets stl_container_table_adapter access the values, plugins may write them.
+inline sinsp_shared_strvec::vec_t& stl_container_data(sinsp_shared_strvec& v) {
+	return v.edit();
+}
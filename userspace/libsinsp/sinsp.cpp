@@ -245,6 +245,7 @@ sinsp::sinsp(bool with_metrics):
 
 	m_proc_scan_timeout_ms = SCAP_PROC_SCAN_TIMEOUT_NONE;
 	m_proc_scan_log_interval_ms = SCAP_PROC_SCAN_LOG_NONE;
+	m_proc_scan_threads = 0;
 
 	m_replay_scap_evt = nullptr;
 
@@ -422,6 +423,10 @@ void sinsp::init() {
 		ASSERT(res == SCAP_SUCCESS || res == SCAP_NOT_SUPPORTED);
 		(void)res;
 	}
+
+	if(m_async_thread_lookups && m_thread_pool && m_platform && !is_capture()) {
+		m_thread_manager->start_async_lookups(m_thread_pool);
+	}
 	m_inited = true;
 }
 
@@ -467,6 +472,7 @@ void sinsp::open_common(scap_open_args* oargs,
 	oargs->log_fn = &sinsp_scap_log_fn;
 	oargs->proc_scan_timeout_ms = m_proc_scan_timeout_ms;
 	oargs->proc_scan_log_interval_ms = m_proc_scan_log_interval_ms;
+	oargs->proc_scan_threads = m_proc_scan_threads;
 
 	m_h = scap_alloc();
 	if(m_h == nullptr) {
@@ -572,6 +578,10 @@ void sinsp::open_kmod(unsigned long driver_buffer_bytes_dim,
 	/* Engine-specific args. */
 	scap_kmod_engine_params params;
 	params.buffer_bytes_dim = driver_buffer_bytes_dim;
+	params.relaxed_ordering_batch = m_relaxed_ordering_batch;
+	params.relaxed_ordering_window_ns = m_relaxed_ordering_window_ns;
+	// sinsp consumes all the events from a single thread.
+	params.n_shards = 0;
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_linux_alloc_platform({::on_proc_table_refresh_start,
@@ -647,6 +657,7 @@ void sinsp::open_savefile(const std::string& filename, int fd) {
 
 	params.start_offset = 0;
 	params.fbuffer_size = 0;
+	params.use_mmap = true;
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_savefile_alloc_platform({::on_proc_table_refresh_start,
@@ -719,6 +730,10 @@ void sinsp::open_modern_bpf(unsigned long driver_buffer_bytes_dim,
 	params.cpus_for_each_buffer = cpus_for_each_buffer;
 	params.allocate_online_only = online_only;
 	params.disable_iterators = disable_iterators;
+	params.relaxed_ordering_batch = m_relaxed_ordering_batch;
+	params.relaxed_ordering_window_ns = m_relaxed_ordering_window_ns;
+	// sinsp consumes all the events from a single thread.
+	params.n_shards = 0;
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_linux_alloc_platform({::on_proc_table_refresh_start,
@@ -844,6 +859,9 @@ std::string sinsp::get_error_desc(const std::string& msg) {
 }
 
 void sinsp::close() {
+	// the lookups in progress read from the platform
+	m_thread_manager->stop_async_lookups();
+
 	if(m_platform) {
 		scap_platform_close(m_platform);
 		scap_platform_free(m_platform);
@@ -851,10 +869,15 @@ void sinsp::close() {
 	}
 
 	if(m_h) {
+		// the decoding threads may still read the current batch
+		m_delayed_scap_evt.reset();
 		scap_close(m_h);
 		m_h = nullptr;
 	}
 
+	// the delayed and batched events were owned by the handle
+	m_delayed_scap_evt.reset();
+
 	m_is_dumping = false;
 
 	deinit_state();
@@ -1120,6 +1143,44 @@ void sinsp::on_new_entry_from_proc(void* context,
 	}
 }
 
+void sinsp::apply_async_thread_lookups() {
+	for(const auto& res : m_thread_manager->collect_async_lookups()) {
+		m_thread_manager->add_async_lookup_duration(res->m_duration_ns);
+
+		// The placeholder is gone if the thread exited meanwhile, and it has been replaced if
+		// an event described the thread (e.g. its clone): the result is stale then.
+		auto placeholder = m_thread_manager->find_thread(res->m_tid, true);
+		if(!placeholder || !placeholder->m_partial) {
+			continue;
+		}
+		placeholder->m_partial = false;
+
+		if(res->m_res != SCAP_SUCCESS || res->m_threads.empty()) {
+			// keep the placeholder as a fake entry, as for the synchronous lookups
+			continue;
+		}
+
+		scap_threadinfo& stinfo = res->m_threads.front();
+		on_new_entry_from_proc(this, stinfo.tid, &stinfo, nullptr);
+		auto tinfo = m_thread_manager->find_thread(stinfo.tid, true);
+		if(!tinfo || tinfo == placeholder) {
+			continue;
+		}
+
+		for(auto& fdinfo : res->m_fds) {
+			on_new_entry_from_proc(this, stinfo.tid, &stinfo, &fdinfo);
+		}
+
+		// The children cloned meanwhile were linked to the placeholder.
+		for(const auto& child : placeholder->m_children) {
+			auto child_tinfo = child.lock();
+			if(child_tinfo && !child_tinfo->is_dead() && child_tinfo->m_ptid == tinfo->m_tid) {
+				tinfo->add_child(child_tinfo);
+			}
+		}
+	}
+}
+
 void sinsp::on_proc_table_refresh_start() {
 	m_is_full_procfs_scan_in_progress = true;
 	m_suppress.initialize();
@@ -1229,6 +1290,15 @@ void sinsp::restart_capture() {
 	m_nevts = nevts;
 }
 
+void sinsp::seek_to_timestamp(uint64_t ts) {
+	// The pending events come from the previous position
+	m_delayed_scap_evt.reset();
+
+	if(scap_seek_to_timestamp(m_h, ts) != SCAP_SUCCESS) {
+		throw sinsp_exception(std::string("scap error: ") + scap_getlasterr(m_h));
+	}
+}
+
 uint64_t sinsp::max_buf_used() const {
 	if(m_h) {
 		return scap_max_buf_used(m_h);
@@ -1354,10 +1424,29 @@ int32_t sinsp::fetch_next_event(sinsp_evt*& evt) {
 	return res;
 }
 
+void sinsp::prefetch_next_events() {
+	// The entries are requested at decreasing distances, so that each step
+	// finds the memory the previous one brought in: the thread table slot a
+	// few events ahead, then the thread, and the fd of the next event.
+	if(const auto* d = m_delayed_scap_evt.lookahead(4)) {
+		m_thread_manager->prefetch_thread_slot(d->m_tid);
+	}
+	if(const auto* d = m_delayed_scap_evt.lookahead(2)) {
+		m_thread_manager->prefetch_thread(d->m_tid);
+	}
+	if(const auto* d = m_delayed_scap_evt.lookahead(1); d != nullptr && d->m_fd >= 0) {
+		m_thread_manager->prefetch_fd(d->m_tid, d->m_fd);
+	}
+}
+
 int32_t sinsp::next(sinsp_evt** puevt) {
 	*puevt = nullptr;
 	sinsp_evt* evt = &m_evt;
 
+	if(m_thread_manager->has_async_lookups()) {
+		apply_async_thread_lookups();
+	}
+
 	// fetch the next event
 	int32_t res = fetch_next_event(evt);
 
@@ -1403,6 +1492,10 @@ int32_t sinsp::next(sinsp_evt** puevt) {
 	/* Here we shouldn't receive unknown events */
 	ASSERT(!libsinsp::events::is_unknown_event((ppm_event_code)evt->get_type()));
 
+	if(m_delayed_scap_evt.m_decoder) {
+		prefetch_next_events();
+	}
+
 	uint64_t ts = evt->get_ts();
 
 	if(m_firstevent_ts == 0 && !libsinsp::events::is_metaevent((ppm_event_code)evt->get_type())) {
@@ -2002,6 +2095,10 @@ void sinsp::set_proc_scan_log_interval_ms(uint64_t val) {
 	m_proc_scan_log_interval_ms = val;
 }
 
+void sinsp::set_proc_scan_threads(uint32_t val) {
+	m_proc_scan_threads = val;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Note: this is defined here so we can inline it in sinso::next
 ///////////////////////////////////////////////////////////////////////////////
@@ -47,6 +47,7 @@ limitations under the License.
 #include <libsinsp/capture_stats_source.h>
 #include <libsinsp/dumper.h>
 #include <libsinsp/event.h>
+#include <libsinsp/event_decoder.h>
 #include <libsinsp/filter.h>
 #include <libsinsp/ifinfo.h>
 #include <libsinsp/eventformatter.h>
@@ -164,6 +165,15 @@ public:
 
 	void fseek(uint64_t filepos) { scap_fseek(m_h, filepos); }
 
+	/*!
+	  \brief Moves the reading of a capture file to the events with a timestamp
+	  greater or equal to `ts`. The capture must have been written with an index
+	  (see `sinsp_dumper::enable_index()`).
+
+	  \note The thread and fd tables don't reflect the events that are skipped.
+	*/
+	void seek_to_timestamp(uint64_t ts);
+
 	/*!
 	  \brief Ends a capture and release all resources.
 	*/
@@ -226,6 +236,43 @@ public:
 	 */
 	void set_dropfailed(bool dropfailed);
 
+	/*!
+	 * \brief [EXPERIMENTAL] Consume the kmod and modern_bpf ring buffers in relaxed
+	 * ordering mode: up to `max_batch` events are consumed from a buffer before moving to
+	 * the next one, so events coming from different CPUs are no longer strictly ordered by
+	 * timestamp. The max reordering observed is reported in the `max_reorder_ns` metric.
+	 * Must be called before opening the inspector.
+
+	 * @param max_batch max events consumed from a buffer in a row, 0 disables the mode
+	 * @param window_ns a batch also ends when its events span more than `window_ns`, 0
+	 * means no limit
+	 */
+	void set_relaxed_ordering(uint32_t max_batch, uint64_t window_ns = 0) {
+		m_relaxed_ordering_batch = max_batch;
+		m_relaxed_ordering_window_ns = window_ns;
+	}
+
+	/*!
+	 * \brief Fetch events from libscap in batches of `batch_size` (see `scap_next_batch`)
+	 * instead of one at a time. Events are still parsed and returned one by one by `next()`,
+	 * only the per-event cost of reading them from the capture is reduced.
+	 *
+	 * @param batch_size max events fetched at once, 0 or 1 disables batching
+	 */
+	void set_scap_batch_size(uint32_t batch_size) { m_delayed_scap_evt.set_batch_size(batch_size); }
+
+	/*!
+	 * \brief Decode the events of each batch (see `set_scap_batch_size`) on `num_workers`
+	 * threads, ahead of their parsing. The workers slice the event params and find the thread
+	 * and fd of the events, so that `next()` only has to update the state, and can prefetch the
+	 * table entries of the next events. Events are still parsed one by one, in order.
+	 *
+	 * @param num_workers number of decoding threads, 0 disables the pipeline
+	 */
+	void set_decode_workers(uint32_t num_workers) {
+		m_delayed_scap_evt.set_decoder_workers(num_workers);
+	}
+
 	/*!
 	  \brief Determine if this inspector is going to load user tables on
 	  startup.
@@ -366,6 +413,12 @@ public:
 	 */
 	void set_proc_scan_log_interval_ms(uint64_t val);
 
+	/*!
+	 * \brief sets the number of threads scanning /proc when the capture is opened, the
+	 *        processes are split among them. Values of 0 (default) and 1 mean a serial scan.
+	 */
+	void set_proc_scan_threads(uint32_t val);
+
 	/*!
 	  \brief Returns a new instance of a filtercheck supporting fields for
 	  a generic event source (e.g. evt.num, evt.time, evt.pluginname...)
@@ -669,6 +722,8 @@ public:
 	                            int64_t tid,
 	                            scap_threadinfo* tinfo,
 	                            scap_fdinfo* fdinfo);
+	void apply_async_thread_lookups();
+	void prefetch_next_events();
 	void set_get_procs_cpu_from_driver(bool get_procs_cpu_from_driver) {
 		m_get_procs_cpu_from_driver = get_procs_cpu_from_driver;
 	}
@@ -776,6 +831,17 @@ public:
 	std::shared_ptr<sinsp_thread_pool> get_thread_pool();
 	bool set_thread_pool(const std::shared_ptr<sinsp_thread_pool>& tpool);
 
+	/*!
+	  \brief Read the threads missing from the thread table from /proc on a routine of the
+	  thread pool, instead of blocking the event processing. A missing thread is added right
+	  away as a placeholder (see thread.is_partial), which is replaced once the thread is read.
+
+	  \note It requires a thread pool, and takes effect when the next capture is opened. It has
+	  no effect when reading capture files.
+	*/
+	void set_async_thread_lookups(bool enable) { m_async_thread_lookups = enable; }
+	bool get_async_thread_lookups() const { return m_async_thread_lookups; }
+
 	/**
 	 * \brief Get a new timestamp.
 	 *
@@ -903,6 +969,7 @@ private:
 	int32_t m_quantization_interval = -1;
 
 	std::shared_ptr<sinsp_thread_pool> m_thread_pool;
+	bool m_async_thread_lookups = false;
 
 	bool m_is_full_procfs_scan_in_progress = false;
 
@@ -960,6 +1027,9 @@ public:
 
 	int32_t m_statsd_port;
 
+	uint32_t m_relaxed_ordering_batch = 0;
+	uint64_t m_relaxed_ordering_window_ns = 0;
+
 	//
 	// Some thread table limits
 	//
@@ -1008,29 +1078,111 @@ public:
 	// temp storage for scap_next
 	// stores top scap_evt while qualified events from m_async_events_queue are being processed
 	struct {
-		inline auto next(scap_t* h) {
+		inline int32_t next(scap_t* h) {
+			if(m_batch_size > 1) {
+				return next_from_batch(h);
+			}
 			auto res = scap_next(h, &m_pevt, &m_cpuid, &m_dump_flags);
 			if(res != SCAP_SUCCESS) {
 				clear();
 			}
 			return res;
 		}
+		inline int32_t next_from_batch(scap_t* h) {
+			if(m_batch_pos == m_batch_len) {
+				if(m_decoder) {
+					m_decoder->finish();
+				}
+				m_batch_pos = 0;
+				auto res = scap_next_batch(h,
+				                           m_batch_evts.data(),
+				                           m_batch_cpuids.data(),
+				                           m_batch_dump_flags.data(),
+				                           m_batch_size,
+				                           &m_batch_len);
+				if(res != SCAP_SUCCESS) {
+					m_batch_len = 0;
+					clear();
+					return res;
+				}
+				if(m_decoder) {
+					m_decoder->start(m_batch_evts.data(), m_batch_len);
+				}
+			}
+			m_pevt = m_batch_evts[m_batch_pos];
+			m_cpuid = m_batch_cpuids[m_batch_pos];
+			m_dump_flags = m_batch_dump_flags[m_batch_pos];
+			m_pevt_pos = m_batch_pos;
+			m_batch_pos++;
+#if defined(__GNUC__) || defined(__clang__)
+			// the next event is going to be parsed right after this one
+			if(m_batch_pos < m_batch_len) {
+				__builtin_prefetch(m_batch_evts[m_batch_pos]);
+			}
+#endif
+			return SCAP_SUCCESS;
+		}
+		inline void set_batch_size(uint32_t batch_size) {
+			reset();
+			m_batch_size = batch_size;
+			m_batch_evts.resize(batch_size);
+			m_batch_cpuids.resize(batch_size);
+			m_batch_dump_flags.resize(batch_size);
+		}
+		inline void set_decoder_workers(uint32_t num_workers) {
+			reset();
+			m_decoder.reset();
+			if(num_workers > 0) {
+				m_decoder = std::make_unique<sinsp_event_decoder>(num_workers);
+			}
+		}
 		inline void move(sinsp_evt* evt) {
 			evt->set_scap_evt(m_pevt);
 			evt->set_cpuid(m_cpuid);
 			evt->set_dump_flags(m_dump_flags);
+			if(m_decoder && m_pevt_pos < m_batch_len) {
+				const auto& d = m_decoder->get(m_pevt_pos);
+				evt->set_decoded_params(d.m_params, d.m_nparams);
+			}
 			clear();
 		}
+		// the decoded event `distance` positions after the last moved one, if
+		// it is already available
+		inline const sinsp_event_decoder::decoded_evt* lookahead(uint32_t distance) const {
+			return m_decoder ? m_decoder->try_get(m_batch_pos + distance - 1) : nullptr;
+		}
 		inline bool empty() const { return m_pevt == nullptr; }
 		inline void clear() {
 			m_pevt = nullptr;
+			m_pevt_pos = UINT32_MAX;
 			m_cpuid = 0;
 			m_dump_flags = 0;
 		}
+		// drops the delayed event and what is left of the current batch
+		inline void reset() {
+			if(m_decoder) {
+				m_decoder->finish();
+			}
+			clear();
+			m_batch_pos = 0;
+			m_batch_len = 0;
+		}
 
 		scap_evt* m_pevt{nullptr};
 		uint16_t m_cpuid{0};
 		uint32_t m_dump_flags;
+
+		// events fetched with `scap_next_batch` and not served yet
+		uint32_t m_batch_size{0};
+		uint32_t m_batch_pos{0};
+		uint32_t m_batch_len{0};
+		std::vector<scap_evt*> m_batch_evts;
+		std::vector<uint16_t> m_batch_cpuids;
+		std::vector<uint32_t> m_batch_dump_flags;
+		uint32_t m_pevt_pos{UINT32_MAX};  // position of m_pevt in the batch
+
+		// decodes the events of the batch ahead of their parsing
+		std::unique_ptr<sinsp_event_decoder> m_decoder;
 	} m_delayed_scap_evt;
 
 	//
@@ -1055,6 +1207,7 @@ public:
 	//
 	uint64_t m_proc_scan_timeout_ms;
 	uint64_t m_proc_scan_log_interval_ms;
+	uint32_t m_proc_scan_threads;
 
 	libsinsp::sinsp_suppress m_suppress;
 
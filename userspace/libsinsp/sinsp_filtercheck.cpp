@@ -66,8 +66,6 @@ sinsp_filter_check::sinsp_filter_check() {
 	m_boolop = BO_NONE;
 	m_inspector = NULL;
 	m_field = NULL;
-	m_val_storages_min_size = (std::numeric_limits<uint32_t>::max)();
-	m_val_storages_max_size = (std::numeric_limits<uint32_t>::min)();
 }
 
 void sinsp_filter_check::set_inspector(sinsp* inspector) {
@@ -610,14 +608,6 @@ void sinsp_filter_check::add_filter_value(const char* str, uint32_t len, uint32_
 		// If the operator is IN or INTERSECTS, populate the map search
 		ensure_unique_ptr_allocated(m_val_storages_members);
 		m_val_storages_members->insert(item);
-
-		if(parsed_len < m_val_storages_min_size) {
-			m_val_storages_min_size = parsed_len;
-		}
-
-		if(parsed_len > m_val_storages_max_size) {
-			m_val_storages_max_size = parsed_len;
-		}
 	} else if(m_cmp.mod != CMPOP_MOD_NONE && (m_cmp.op == CO_EQ || m_cmp.op == CO_NE)) {
 		// equality-based ops with a modifier use hash-set lookup:
 		//   "== anyof (...)" → set membership in matches_any_rhs
@@ -824,8 +814,7 @@ bool sinsp_filter_check::compare_rhs(comparator cmp,
 					}
 				} else {
 					ensure_unique_ptr_allocated(m_val_storages_members);
-					if(it.len < m_val_storages_min_size || it.len > m_val_storages_max_size ||
-					   m_val_storages_members->find(item) == m_val_storages_members->end()) {
+					if(!m_val_storages_members->contains(item)) {
 						return false;
 					}
 				}
@@ -847,8 +836,7 @@ bool sinsp_filter_check::compare_rhs(comparator cmp,
 					}
 				} else {
 					ensure_unique_ptr_allocated(m_val_storages_members);
-					if(it.len >= m_val_storages_min_size && it.len <= m_val_storages_max_size &&
-					   m_val_storages_members->find(item) != m_val_storages_members->end()) {
+					if(m_val_storages_members->contains(item)) {
 						return true;
 					}
 				}
@@ -979,9 +967,7 @@ bool sinsp_filter_check::compare_rhs(comparator cmp,
 				// against the set of rhs values. sinsp_filter_checks only extract a
 				// single value, so CO_INTERSECTS is really the same as CO_IN.
 				ensure_unique_ptr_allocated(m_val_storages_members);
-				if(item.second >= m_val_storages_min_size &&
-				   item.second <= m_val_storages_max_size &&
-				   m_val_storages_members->find(item) != m_val_storages_members->end()) {
+				if(m_val_storages_members->contains(item)) {
 					return true;
 				}
 			} else {
@@ -1050,7 +1036,7 @@ bool sinsp_filter_check::matches_any_rhs(const filter_value_t& item,
 	ASSERT(n_rhs > 0);
 	// "== anyof (...)" can be interpreted as "is in set {...}".
 	if(cmp.op == CO_EQ && m_val_storages_members) {
-		return m_val_storages_members->find(item) != m_val_storages_members->end();
+		return m_val_storages_members->contains(item);
 	}
 
 	for(uint16_t i = 0; i < n_rhs; i++) {
@@ -1068,7 +1054,7 @@ bool sinsp_filter_check::matches_all_rhs(const filter_value_t& item,
 	ASSERT(n_rhs > 0);
 	// "!= allof (...)" can be interpreted as "not in set {...}".
 	if(cmp.op == CO_NE && m_val_storages_members) {
-		return m_val_storages_members->find(item) == m_val_storages_members->end();
+		return !m_val_storages_members->contains(item);
 	}
 
 	for(uint16_t i = 0; i < n_rhs; i++) {
@@ -1221,6 +1207,38 @@ bool sinsp_filter_check::compare_nocache(sinsp_evt* evt) {
 		populate_filter_values_with_rhs_extracted_values(m_rhs_filter_check->m_extracted_values);
 	}
 
+	// the regex may have already been matched along with the other ones on the same field
+	if(m_regex_group && m_extracted_values.size() == 1) {
+		const auto& v = m_extracted_values[0];
+		const auto item = craft_filter_value(lhs_type, v.ptr, v.len, m_cmp.op);
+		bool res = false;
+		if(m_regex_group->match(evt,
+		                        std::string_view((const char*)item.first, item.second),
+		                        m_regex_group_idx,
+		                        res)) {
+			if(m_cache_metrics != NULL) {
+				m_cache_metrics->m_num_regex_group++;
+			}
+			return res;
+		}
+	}
+
+	// same for substring comparisons
+	if(m_substring_group && m_extracted_values.size() == 1) {
+		const auto& v = m_extracted_values[0];
+		const auto item = craft_filter_value(lhs_type, v.ptr, v.len, m_cmp.op);
+		bool res = false;
+		if(m_substring_group->match(evt,
+		                            std::string_view((const char*)item.first, item.second),
+		                            m_substring_group_idx,
+		                            res)) {
+			if(m_cache_metrics != NULL) {
+				m_cache_metrics->m_num_substring_group++;
+			}
+			return res;
+		}
+	}
+
 	return compare_rhs(m_cmp, lhs_type, m_extracted_values);
 }
 
@@ -1285,8 +1303,6 @@ void sinsp_filter_check::populate_filter_values_with_rhs_extracted_values(
 	if(m_cmp.op == CO_IN || m_cmp.op == CO_INTERSECTS) {
 		ensure_unique_ptr_allocated(m_val_storages_members);
 		m_val_storages_members->clear();
-		m_val_storages_min_size = (std::numeric_limits<uint32_t>::max)();
-		m_val_storages_max_size = (std::numeric_limits<uint32_t>::min)();
 	}
 
 	for(const auto& v : values) {
@@ -1294,14 +1310,7 @@ void sinsp_filter_check::populate_filter_values_with_rhs_extracted_values(
 		m_vals.push_back(item);
 
 		if(m_cmp.op == CO_IN || m_cmp.op == CO_INTERSECTS) {
-			m_val_storages_members->insert(std::move(item));
-			if(v.len < m_val_storages_min_size) {
-				m_val_storages_min_size = v.len;
-			}
-
-			if(v.len > m_val_storages_max_size) {
-				m_val_storages_max_size = v.len;
-			}
+			m_val_storages_members->insert(item);
 		}
 	}
 }
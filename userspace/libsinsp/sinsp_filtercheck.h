@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include <libsinsp/filter_value.h>
+#include <libsinsp/filter_value_set.h>
 #include <libsinsp/prefix_search.h>
 #include <libsinsp/event.h>
 #include <libsinsp/filter_compare.h>
@@ -178,6 +179,10 @@ public:
 	std::shared_ptr<sinsp_filter_compare_cache> m_compare_cache = nullptr;
 	std::shared_ptr<sinsp_filter_extract_cache> m_extract_cache = nullptr;
 	std::shared_ptr<sinsp_filter_cache_metrics> m_cache_metrics = nullptr;
+	std::shared_ptr<sinsp_filter_regex_group> m_regex_group = nullptr;
+	size_t m_regex_group_idx = SIZE_MAX;  // index of the regex of this check in m_regex_group
+	std::shared_ptr<sinsp_filter_substring_group> m_substring_group = nullptr;
+	size_t m_substring_group_idx = SIZE_MAX;  // index of this check in m_substring_group
 	boolop m_boolop = BO_NONE;
 	comparator m_cmp;
 
@@ -332,11 +337,8 @@ private:
 	std::unique_ptr<filtercheck_field_info> m_transformed_field = nullptr;
 
 	// used for comparing right-hand lists of values
-	std::unique_ptr<std::unordered_set<filter_value_t, g_hash_membuf, g_equal_to_membuf>>
-	        m_val_storages_members;
+	std::unique_ptr<filter_value_set> m_val_storages_members;
 	std::unique_ptr<path_prefix_search> m_val_storages_paths;
-	uint32_t m_val_storages_min_size;
-	uint32_t m_val_storages_max_size;
 
 	// One compiled RE2 per RHS value; populated by add_filter_value for CO_REGEX.
 	std::vector<std::unique_ptr<re2::RE2>> m_val_regexes;
@@ -710,6 +710,14 @@ static const filtercheck_field_info sinsp_filter_check_thread_fields[] = {
          "Standard Error fd name",
          "The name of the file descriptor 2, corresponding to stderr, of the process generating "
          "the event."},
+        {PT_BOOL,
+         EPF_NONE,
+         PF_NA,
+         "thread.is_partial",
+         "Partial Thread",
+         "'true' if the thread generating the event was missing from the thread table and its "
+         "information is still being read from /proc in the background. Until then, most of the "
+         "thread and process fields have default values."},
 };
 
 sinsp_filter_check_thread::sinsp_filter_check_thread(): m_argid(-1) {
@@ -1278,6 +1286,9 @@ uint8_t* sinsp_filter_check_thread::extract_single(sinsp_evt* evt, uint32_t* len
 	case TYPE_ISMAINTHREAD:
 		m_val.u32 = (uint32_t)tinfo->is_main_thread();
 		return extract_single_val(m_val.u32, len);
+	case TYPE_THREAD_IS_PARTIAL:
+		m_val.u32 = (uint32_t)tinfo->m_partial;
+		return extract_single_val(m_val.u32, len);
 	case TYPE_EXECTIME: {
 		if(const auto etype = evt->get_type(); etype == PPME_SCHEDSWITCH_6_E) {
 			m_val.u64 = extract_exectime(evt);
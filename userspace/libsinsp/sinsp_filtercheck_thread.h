@@ -114,6 +114,7 @@ public:
 		TYPE_FD_STDIN_NAME,
 		TYPE_FD_STDOUT_NAME,
 		TYPE_FD_STDERR_NAME,
+		TYPE_THREAD_IS_PARTIAL,
 	};
 
 	sinsp_filter_check_thread();
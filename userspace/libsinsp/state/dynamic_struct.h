@@ -27,88 +27,30 @@ limitations under the License.
 #include <memory>
 #include <cstring>
 #include <deque>
+#include <vector>
 
 namespace libsinsp::state {
 
-struct dynamic_field_value {
+/**
+ * @brief Position of a dynamic field in the storage block of the structs
+ * (see extensible_struct).
+ */
+struct dynamic_field_layout {
 	ss_plugin_state_type m_type;
-	ss_plugin_state_data m_data;
-	// Stable std::string storage for SS_PLUGIN_ST_STRING fields.
-	// raw_read_field returns &m_str for string fields, giving callers
-	// a const std::string* that remains valid across multiple reads.
-	// m_data.str is kept pointing at m_str.c_str() for the plugin C API.
-	std::string m_str;
-
-	explicit dynamic_field_value(ss_plugin_state_type type): m_type(type), m_data{} {
-		memset(&m_data, 0, sizeof(m_data));
-		if(m_type == SS_PLUGIN_ST_STRING) {
-			m_data.str = m_str.c_str();
-		}
-	}
-
-	void update(const borrowed_state_data& val) {
-		if(m_type == SS_PLUGIN_ST_STRING) {
-			m_str = val.data().str ? val.data().str : "";
-			m_data.str = m_str.c_str();
-		} else {
-			m_data = val.data();
-		}
-	}
-
-	dynamic_field_value(const dynamic_field_value& rhs) noexcept:
-	        m_type(rhs.m_type),
-	        m_data{},
-	        m_str() {
-		*this = rhs;
-	}
-
-	dynamic_field_value& operator=(const dynamic_field_value& rhs) {
-		m_type = rhs.m_type;
-		if(m_type == SS_PLUGIN_ST_STRING) {
-			m_str = rhs.m_str;
-			m_data.str = m_str.c_str();
-		} else {
-			m_data = rhs.m_data;
-		}
-		return *this;
-	}
-
-	dynamic_field_value(dynamic_field_value&& rhs) noexcept: m_type(rhs.m_type), m_data{}, m_str() {
-		*this = std::move(rhs);
-	}
-
-	dynamic_field_value& operator=(dynamic_field_value&& rhs) noexcept {
-		m_type = rhs.m_type;
-		if(m_type == SS_PLUGIN_ST_STRING) {
-			m_str = std::move(rhs.m_str);
-			m_data.str = m_str.c_str();
-			rhs.m_data.str = rhs.m_str.c_str();
-		} else {
-			m_data = rhs.m_data;
-		}
-		rhs.m_type = static_cast<ss_plugin_state_type>(0);  // invalid type
-		return *this;
-	}
-
-	~dynamic_field_value() = default;
+	uint32_t m_size;
+	uint32_t m_offset;
 };
 
 class extensible_struct;
 
 template<typename T>
 borrowed_state_data read_dynamic_field(const void* obj, size_t index) {
-	auto dstruct = static_cast<const T*>(obj);
-	if(auto ptr = dstruct->_access_dynamic_field_for_read(index)) {
-		return borrowed_state_data(ptr->m_data);
-	}
-	return {};
+	return static_cast<const T*>(obj)->_read_dynamic_field(index);
 }
 
 template<typename T>
 void write_dynamic_field(void* obj, size_t index, const libsinsp::state::borrowed_state_data& in) {
-	auto dstruct = static_cast<T*>(obj);
-	auto ptr = dstruct->_access_dynamic_field_for_write(index);
-	ptr->update(in);
+	static_cast<T*>(obj)->_write_dynamic_field(index, in);
 }
 
 /**
@@ -165,14 +107,62 @@ public:
 		m_definitions_ordered.push_back(std::move(field));
 		const auto& def = m_definitions_ordered.back();
 		m_definitions[def.name()] = &def;
+
+		// fields are only appended, so the offsets of the existing ones
+		// never change and the structs can grow their storage lazily
+		m_layout.push_back(layout_of(def.type_id(), m_block_size));
+		m_block_size = m_layout.back().m_offset + m_layout.back().m_size;
 		return def;
 	}
 
 	const std::unordered_map<std::string, const accessor*>& fields() const { return m_definitions; }
 
+	/**
+	 * @brief Returns the size of the storage block holding all the dynamic
+	 * fields of a struct.
+	 */
+	inline size_t block_size() const { return m_block_size; }
+
 protected:
+	static dynamic_field_layout layout_of(ss_plugin_state_type type, size_t offset) {
+		size_t size = 0;
+		size_t align = 0;
+		switch(type) {
+		case SS_PLUGIN_ST_INT8:
+		case SS_PLUGIN_ST_UINT8:
+			size = align = sizeof(uint8_t);
+			break;
+		case SS_PLUGIN_ST_INT16:
+		case SS_PLUGIN_ST_UINT16:
+			size = align = sizeof(uint16_t);
+			break;
+		case SS_PLUGIN_ST_INT32:
+		case SS_PLUGIN_ST_UINT32:
+			size = align = sizeof(uint32_t);
+			break;
+		case SS_PLUGIN_ST_INT64:
+		case SS_PLUGIN_ST_UINT64:
+			size = align = sizeof(uint64_t);
+			break;
+		case SS_PLUGIN_ST_BOOL:
+			size = align = sizeof(ss_plugin_bool);
+			break;
+		case SS_PLUGIN_ST_STRING:
+			size = sizeof(std::string);
+			align = alignof(std::string);
+			break;
+		default:
+			throw sinsp_exception("unsupported type of dynamic field: " +
+			                      std::string(type_name(type)));
+		}
+		offset = (offset + align - 1) & ~(align - 1);
+		return {type, (uint32_t)size, (uint32_t)offset};
+	}
+
 	std::deque<accessor> m_definitions_ordered;
 	std::unordered_map<std::string, const accessor*> m_definitions;
+	std::vector<dynamic_field_layout> m_layout;  // one for every definition, in order
+	size_t m_block_size = 0;
 	accessor::reader_fn m_reader;
 	accessor::writer_fn m_writer;
 
@@ -21,7 +21,10 @@ limitations under the License.
 #include <libsinsp/state/dynamic_struct.h>
 #include <libsinsp/state/static_struct.h>
 
-#include <vector>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
 
 namespace libsinsp::state {
 class extensible_struct : public table_entry {
@@ -30,9 +33,23 @@ public:
 	        const std::shared_ptr<dynamic_field_infos>& dynamic_fields = nullptr):
 	        m_dynamic_fields(dynamic_fields) {}
 
-	inline extensible_struct(extensible_struct&&) = default;
+	inline extensible_struct(extensible_struct&& s) noexcept:
+	        m_fields(std::move(s.m_fields)),
+	        m_num_fields(s.m_num_fields),
+	        m_dynamic_fields(std::move(s.m_dynamic_fields)) {
+		s.m_num_fields = 0;
+	}
 	inline extensible_struct(const extensible_struct& s) { deep_fields_copy(s); }
-	inline extensible_struct& operator=(extensible_struct&&) = default;
+	inline extensible_struct& operator=(extensible_struct&& s) noexcept {
+		if(this != &s) {
+			destroy_fields();
+			m_fields = std::move(s.m_fields);
+			m_num_fields = s.m_num_fields;
+			m_dynamic_fields = std::move(s.m_dynamic_fields);
+			s.m_num_fields = 0;
+		}
+		return *this;
+	}
 	inline extensible_struct& operator=(const extensible_struct& s) {
 		if(this == &s) {
 			return *this;
@@ -40,6 +57,7 @@ public:
 		deep_fields_copy(s);
 		return *this;
 	}
+	~extensible_struct() override { destroy_fields(); }
 
 	// dynamic_struct interface
 
@@ -58,6 +76,8 @@ public:
 		if(!defs) {
 			throw sinsp_exception("dynamic struct constructed with null field definitions");
 		}
+		// the fields in use are laid out with the previous definitions
+		destroy_fields();
 		m_dynamic_fields = defs;
 	}
 
@@ -70,63 +90,108 @@ protected:
 	}
 
 private:
-	inline dynamic_field_value* _access_dynamic_field_for_write(size_t index) {
+	inline const dynamic_field_layout& field_layout(size_t index) const {
 		if(!m_dynamic_fields) {
 			throw sinsp_exception("dynamic struct has no field definitions");
 		}
-		if(index >= m_dynamic_fields->m_definitions_ordered.size()) {
+		if(index >= m_dynamic_fields->m_layout.size()) {
 			throw sinsp_exception("dynamic struct access overflow: " + std::to_string(index));
 		}
-		while(m_fields.size() <= index) {
-			const auto& def = m_dynamic_fields->m_definitions_ordered[m_fields.size()];
-			m_fields.emplace_back(def.type_id());
-		}
-		return &m_fields[index];
+		return m_dynamic_fields->m_layout[index];
 	}
 
-	inline const dynamic_field_value* _access_dynamic_field_for_read(size_t index) const {
-		if(!m_dynamic_fields) {
-			throw sinsp_exception("dynamic struct has no field definitions");
+	inline std::string* string_field(const dynamic_field_layout& layout) const {
+		return std::launder(reinterpret_cast<std::string*>(m_fields.get() + layout.m_offset));
+	}
+
+	inline borrowed_state_data _read_dynamic_field(size_t index) const {
+		const auto& layout = field_layout(index);
+		ss_plugin_state_data out;
+		memset(&out, 0, sizeof(out));
+		if(index < m_num_fields) {
+			if(layout.m_type == SS_PLUGIN_ST_STRING) {
+				out.str = string_field(layout)->c_str();
+			} else {
+				// all the members of the union start at its beginning
+				memcpy(&out, m_fields.get() + layout.m_offset, layout.m_size);
+			}
 		}
-		if(index >= m_dynamic_fields->m_definitions_ordered.size()) {
-			throw sinsp_exception("dynamic struct access overflow: " + std::to_string(index));
+		return borrowed_state_data(out);
+	}
+
+	inline void _write_dynamic_field(size_t index, const borrowed_state_data& in) {
+		const auto& layout = field_layout(index);
+		if(index >= m_num_fields) {
+			grow_fields();
 		}
-		if(m_fields.size() <= index) {
-			return nullptr;
+		if(layout.m_type == SS_PLUGIN_ST_STRING) {
+			*string_field(layout) = in.data().str ? in.data().str : "";
+		} else {
+			memcpy(m_fields.get() + layout.m_offset, &in.data(), layout.m_size);
 		}
-		return &m_fields[index];
 	}
 
-	struct cloner {
-		extensible_struct* self;
-		const extensible_struct* other;
-		size_t index;
-
-		template<typename T>
-		void operator()() const {
-			auto ptr = self->_access_dynamic_field_for_write(index);
-			auto val = other->_access_dynamic_field_for_read(index);
-			*ptr = *val;
+	// Allocates a block holding all the fields defined so far, and moves the
+	// ones in use into it. Fields are zero-initialized, strings are empty.
+	void grow_fields() {
+		const auto& layouts = m_dynamic_fields->m_layout;
+		std::unique_ptr<uint8_t[]> fields(new uint8_t[m_dynamic_fields->m_block_size]());
+		for(size_t i = 0; i < layouts.size(); i++) {
+			const auto& layout = layouts[i];
+			uint8_t* ptr = fields.get() + layout.m_offset;
+			if(layout.m_type == SS_PLUGIN_ST_STRING) {
+				auto str = new(ptr) std::string();
+				if(i < m_num_fields) {
+					*str = std::move(*string_field(layout));
+				}
+			} else if(i < m_num_fields) {
+				memcpy(ptr, m_fields.get() + layout.m_offset, layout.m_size);
+			}
 		}
-	};
+		destroy_fields();
+		m_fields = std::move(fields);
+		m_num_fields = layouts.size();
+	}
 
-	inline void deep_fields_copy(const extensible_struct& other_const) {
-		// note: const cast should be safe here as we're not going to resize
-		// nor edit the dynamic fields allocated in "other"
-		auto& other = const_cast<extensible_struct&>(other_const);
+	void destroy_fields() {
+		for(size_t i = 0; i < m_num_fields; i++) {
+			const auto& layout = m_dynamic_fields->m_layout[i];
+			if(layout.m_type == SS_PLUGIN_ST_STRING) {
+				std::destroy_at(string_field(layout));
+			}
+		}
+		m_fields.reset();
+		m_num_fields = 0;
+	}
 
+	inline void deep_fields_copy(const extensible_struct& other) {
 		// copy the definitions
 		set_dynamic_fields(other.dynamic_fields());
+		destroy_fields();
 
 		// deep copy of all the fields
-		m_fields.clear();
-		for(size_t i = 0; i < other.m_fields.size(); i++) {
-			const auto& info = m_dynamic_fields->m_definitions_ordered[i];
-			dispatch_lambda(info.type_id(), cloner{this, &other, i});
+		if(other.m_num_fields == 0) {
+			return;
+		}
+		grow_fields();
+		const auto& layouts = m_dynamic_fields->m_layout;
+		for(size_t i = 0; i < other.m_num_fields; i++) {
+			const auto& layout = layouts[i];
+			if(layout.m_type == SS_PLUGIN_ST_STRING) {
+				*string_field(layout) = *other.string_field(layout);
+			} else {
+				memcpy(m_fields.get() + layout.m_offset,
+				       other.m_fields.get() + layout.m_offset,
+				       layout.m_size);
+			}
 		}
 	}
 
-	std::vector<dynamic_field_value> m_fields;
+	// All the dynamic fields, laid out as described by the definitions. Only
+	// the first m_num_fields are in use: the block is allocated on the first
+	// write, and grown if more fields have been defined since then.
+	std::unique_ptr<uint8_t[]> m_fields;
+	size_t m_num_fields = 0;
 	std::shared_ptr<dynamic_field_infos> m_dynamic_fields;
 	// end of dynamic_struct interface
 
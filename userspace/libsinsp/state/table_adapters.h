@@ -156,6 +156,16 @@ private:
 	std::pair<Tfirst, Tsecond>* m_value;
 };
 
+/**
+ * @brief Returns the STL container read and written by
+ * stl_container_table_adapter. Types wrapping a container (e.g. copy-on-write
+ * ones) can overload it to expose the wrapped one.
+ */
+template<typename T>
+inline T& stl_container_data(T& container) {
+	return container;
+}
+
 /**
  * @brief A template that helps converting STL container types (e.g.
  * std::vector, std::list, etc) into tables compatible with the libsinsp
@@ -189,7 +199,7 @@ public:
 
 	size_t entries_count() const override { return m_container.size(); }
 
-	void clear_entries() override { m_container.clear(); }
+	void clear_entries() override { stl_container_data(m_container).clear(); }
 
 	std::unique_ptr<libsinsp::state::table_entry> new_entry() const override {
 		auto ret = std::make_unique<wrapper_t>();
@@ -198,7 +208,7 @@ public:
 
 	bool foreach_entry(std::function<bool(libsinsp::state::table_entry& e)> pred) override {
 		wrapper_t w;
-		for(auto& v : m_container) {
+		for(auto& v : stl_container_data(m_container)) {
 			w.set_value(&v);
 			if(!pred(w)) {
 				return false;
@@ -211,7 +221,7 @@ public:
 		if(key >= m_container.size()) {
 			return nullptr;
 		}
-		return wrap_value(&m_container[key]);
+		return wrap_value(&stl_container_data(m_container)[key]);
 	}
 
 	std::shared_ptr<libsinsp::state::table_entry> add_entry(
@@ -232,15 +242,17 @@ public:
 			                      std::string(this->name()));
 		}
 
-		m_container.resize(key + 1);
-		return wrap_value(&m_container[key]);
+		auto& container = stl_container_data(m_container);
+		container.resize(key + 1);
+		return wrap_value(&container[key]);
 	}
 
 	bool erase_entry(const uint64_t& key) override {
 		if(key >= m_container.size()) {
 			return false;
 		}
-		m_container.erase(m_container.begin() + key);
+		auto& container = stl_container_data(m_container);
+		container.erase(container.begin() + key);
 		return true;
 	}
 
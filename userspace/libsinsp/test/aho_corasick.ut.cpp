@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libsinsp/aho_corasick.h>
+
+#include <set>
+#include <string>
+#include <utility>
+
+using match_set = std::set<std::pair<uint32_t, size_t>>;
+
+static match_set scan(const aho_corasick& ac, std::string_view text) {
+	match_set res;
+	ac.scan(text, [&](uint32_t id, size_t end) { res.emplace(id, end); });
+	return res;
+}
+
+TEST(aho_corasick, scan) {
+	aho_corasick ac;
+	auto he = ac.add("he");
+	auto she = ac.add("she");
+	auto his = ac.add("his");
+	auto hers = ac.add("hers");
+	// duplicates get the same id
+	ASSERT_EQ(ac.add("she"), she);
+	ASSERT_EQ(ac.size(), 4);
+	ASSERT_FALSE(ac.built());
+	ac.build();
+	ASSERT_TRUE(ac.built());
+
+	// overlapping occurrences are all reported, found through failure links
+	match_set expected = {{she, 4}, {he, 4}, {hers, 6}};
+	ASSERT_EQ(scan(ac, "ushers"), expected);
+	expected = {{his, 3}};
+	ASSERT_EQ(scan(ac, "his"), expected);
+	ASSERT_EQ(scan(ac, "HIS"), match_set{});
+	ASSERT_EQ(scan(ac, ""), match_set{});
+	ASSERT_EQ(scan(ac, "xyz"), match_set{});
+}
+
+TEST(aho_corasick, case_insensitive) {
+	aho_corasick ac(true);
+	auto bin = ac.add("/BIN/");
+	auto sh = ac.add("sh");
+	ac.build();
+
+	match_set expected = {{bin, 5}, {sh, 7}};
+	ASSERT_EQ(scan(ac, "/bin/Sh"), expected);
+	expected = {{bin, 9}};
+	ASSERT_EQ(scan(ac, "/usr/bIn/"), expected);
+}
+
+TEST(aho_corasick, binary_text) {
+	aho_corasick ac;
+	auto a = ac.add(std::string_view("a\0b", 3));
+	auto ff = ac.add("\xff");
+	ac.build();
+
+	match_set expected = {{a, 4}, {ff, 5}};
+	ASSERT_EQ(scan(ac, std::string_view("\0a\0b\xff", 5)), expected);
+}
+
+TEST(aho_corasick, rebuild) {
+	aho_corasick ac;
+	auto foo = ac.add("foo");
+	ac.build();
+	ASSERT_EQ(scan(ac, "barfoo"), (match_set{{foo, 6}}));
+
+	auto bar = ac.add("bar");
+	ASSERT_FALSE(ac.built());
+	ac.build();
+	ASSERT_EQ(scan(ac, "barfoo"), (match_set{{bar, 3}, {foo, 6}}));
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+#include <sinsp_with_test_input.h>
+
+#include <atomic>
+#include <list>
+#include <thread>
+
+namespace {
+
+// Runs every routine in a loop on its own thread.
+class test_thread_pool : public sinsp_thread_pool {
+public:
+	~test_thread_pool() { purge(); }
+
+	routine_id_t subscribe(const std::function<bool()>& func) override {
+		auto& r = m_routines.emplace_back();
+		r.m_func = func;
+		auto* raw = &r;
+		r.m_thread = std::thread([raw] {
+			while(!raw->m_stop && raw->m_func()) {
+			}
+		});
+		return reinterpret_cast<routine_id_t>(raw);
+	}
+
+	bool unsubscribe(routine_id_t id) override {
+		for(auto it = m_routines.begin(); it != m_routines.end(); ++it) {
+			if(reinterpret_cast<routine_id_t>(&*it) == id) {
+				stop(*it);
+				m_routines.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void purge() override {
+		for(auto& r : m_routines) {
+			stop(r);
+		}
+		m_routines.clear();
+	}
+
+	size_t routines_num() override { return m_routines.size(); }
+
+private:
+	struct routine {
+		std::function<bool()> m_func;
+		std::atomic<bool> m_stop{false};
+		std::thread m_thread;
+	};
+
+	static void stop(routine& r) {
+		r.m_stop = true;
+		r.m_thread.join();
+	}
+
+	std::list<routine> m_routines;
+};
+
+}  // namespace
+
+TEST_F(sinsp_with_test_input, async_thread_lookup) {
+	auto tpool = std::make_shared<test_thread_pool>();
+	ASSERT_TRUE(m_inspector.set_thread_pool(tpool));
+	m_inspector.set_async_thread_lookups(true);
+
+	add_default_init_thread();
+	add_simple_thread(42, 42, INIT_TID, "lookedup");
+	open_inspector();
+	ASSERT_EQ(tpool->routines_num(), 1);
+
+	// Forget the thread, as if the initial scan had missed it.
+	m_inspector.m_thread_manager->remove_thread(42);
+	ASSERT_EQ(m_inspector.m_thread_manager->find_thread(42, true), nullptr);
+
+	// It is added right away as a placeholder...
+	auto evt = generate_random_event(42);
+	ASSERT_EQ(get_field_as_string(evt, "thread.is_partial"), "true");
+	ASSERT_EQ(get_field_as_string(evt, "proc.name"), "<NA>");
+
+	// ...which the event loop replaces once the thread has been read.
+	for(int i = 0; i < 1000 && get_field_as_string(evt, "thread.is_partial") == "true"; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		evt = generate_random_event(42);
+	}
+	ASSERT_EQ(get_field_as_string(evt, "thread.is_partial"), "false");
+	ASSERT_EQ(get_field_as_string(evt, "proc.name"), "lookedup");
+	ASSERT_EQ(get_field_as_string(evt, "proc.pid"), "42");
+
+	m_inspector.close();
+	ASSERT_EQ(tpool->routines_num(), 0);
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <libsinsp/event_decoder.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// events reading fds, closing them (fd in the enter event), and without fds
+static std::vector<scap_evt*> make_events(uint32_t n) {
+	char error[SCAP_LASTERR_SIZE];
+	char data[16] = {};
+	std::vector<scap_evt*> evts;
+	for(uint32_t j = 0; j < n; j++) {
+		const int64_t fd = 3 + j;
+		switch(j % 3) {
+		case 0:
+			evts.push_back(scap_create_event(error,
+			                                 j,
+			                                 100 + j,
+			                                 PPME_SYSCALL_READ_X,
+			                                 4,
+			                                 (int64_t)sizeof(data),
+			                                 scap_const_sized_buffer{data, sizeof(data)},
+			                                 fd,
+			                                 (uint32_t)sizeof(data)));
+			break;
+		case 1:
+			evts.push_back(scap_create_event(error, j, 100 + j, PPME_SYSCALL_CLOSE_E, 1, fd));
+			break;
+		default:
+			evts.push_back(scap_create_event(error,
+			                                 j,
+			                                 100 + j,
+			                                 PPME_GENERIC_X,
+			                                 2,
+			                                 (uint16_t)j,
+			                                 (uint16_t)j));
+			break;
+		}
+	}
+	return evts;
+}
+
+static void check_batch(sinsp_event_decoder& decoder, const std::vector<scap_evt*>& evts) {
+	decoder.start(evts.data(), evts.size());
+	// the last events first, so that some chunks are decoded by this thread
+	for(uint32_t j = evts.size(); j > 0; j--) {
+		const auto& d = decoder.get(j - 1);
+		ASSERT_EQ(decoder.try_get(j - 1), &d);
+
+		scap_sized_buffer params[PPM_MAX_EVENT_PARAMS];
+		const uint32_t nparams = scap_event_decode_params(evts[j - 1], params);
+		ASSERT_EQ(d.m_nparams, nparams);
+		for(uint32_t i = 0; i < nparams; i++) {
+			ASSERT_EQ(d.m_params[i].buf, params[i].buf);
+			ASSERT_EQ(d.m_params[i].size, params[i].size);
+		}
+		ASSERT_EQ(d.m_tid, 100 + j - 1);
+		ASSERT_EQ(d.m_fd, (j - 1) % 3 == 2 ? -1 : (int64_t)(3 + j - 1));
+	}
+	ASSERT_EQ(decoder.try_get(evts.size()), nullptr);
+	decoder.finish();
+}
+
+TEST(event_decoder, decode_batches) {
+	auto evts = make_events(100);
+	for(uint32_t workers : {0, 1, 3}) {
+		sinsp_event_decoder decoder(workers);
+		ASSERT_EQ(decoder.num_workers(), workers);
+		for(int i = 0; i < 20; i++) {
+			check_batch(decoder, evts);
+		}
+		// smaller and empty batches reuse the entries
+		std::vector<scap_evt*> half(evts.begin(), evts.begin() + 37);
+		check_batch(decoder, half);
+		decoder.start(nullptr, 0);
+		ASSERT_EQ(decoder.try_get(0), nullptr);
+	}
+	for(auto evt : evts) {
+		free(evt);
+	}
+}
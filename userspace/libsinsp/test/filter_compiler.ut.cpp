@@ -906,6 +906,197 @@ TEST_F(sinsp_with_test_input, filter_cache_corner_cases) {
 	cf->metrics->reset();
 }
 
+TEST_F(sinsp_with_test_input, filter_regex_group) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	auto cf = std::make_shared<test_sinsp_filter_cache_factory>();
+
+	// the filters sharing the cache factory must stay alive, as the cached
+	// extracted values point to their storage
+	std::vector<std::unique_ptr<sinsp_filter>> filters;
+	auto run = [&](const std::string& str) {
+		filters.push_back(sinsp_filter_compiler(ff, str, cf).compile());
+		return filters.back()->run(evt);
+	};
+
+	// a single regex on a field is matched on its own
+	ASSERT_TRUE(run("proc.name regex 'in.*'"));
+	EXPECT_EQ(cf->metrics->m_num_regex_group, 0);
+
+	// all the regexes on the same field are matched at once
+	ASSERT_TRUE(run("proc.name regex '.*it' and not proc.name regex 'bash.*'"));
+	EXPECT_EQ(cf->metrics->m_num_regex_group, 2);
+	ASSERT_EQ(cf->regex_groups().size(), 1);
+	EXPECT_EQ(cf->regex_groups().begin()->second->size(), 3);
+
+	// new patterns can still be added after the group has been used
+	evt->set_num(evt->get_num() + 1);
+	ASSERT_FALSE(run("proc.name regex 'bash.*' or proc.name regex 'ini'"));
+	ASSERT_TRUE(run("proc.name regex 'in.*' and proc.name regex 'init'"));
+	EXPECT_EQ(cf->metrics->m_num_regex_group, 6);
+	EXPECT_EQ(cf->regex_groups().begin()->second->size(), 5);
+
+	// regexes on other fields, or with modifiers, are not grouped
+	ASSERT_TRUE(run("evt.source regex 'sys.*' and evt.source regex '.*call'"));
+	ASSERT_TRUE(run("proc.name regex anyof ('bash.*', 'init')"));
+	EXPECT_EQ(cf->regex_groups().size(), 2);
+	EXPECT_EQ(cf->regex_groups().begin()->second->size() +
+	                  std::next(cf->regex_groups().begin())->second->size(),
+	          7);
+}
+
+TEST_F(sinsp_with_test_input, filter_substring_group) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	auto cf = std::make_shared<test_sinsp_filter_cache_factory>();
+
+	std::vector<std::unique_ptr<sinsp_filter>> filters;
+	auto run = [&](const std::string& str) {
+		filters.push_back(sinsp_filter_compiler(ff, str, cf).compile());
+		return filters.back()->run(evt);
+	};
+
+	// a few comparisons on a field are evaluated on their own
+	ASSERT_TRUE(run("proc.exepath contains bin and proc.exepath icontains /SBIN/"));
+	EXPECT_EQ(cf->metrics->m_num_substring_group, 0);
+
+	// more of them are all matched at once
+	evt->set_num(evt->get_num() + 1);
+	ASSERT_TRUE(
+	        run("proc.exepath contains bin and proc.exepath icontains /SBIN/ and "
+	            "proc.exepath startswith /sbin and proc.exepath endswith init"));
+	EXPECT_EQ(cf->metrics->m_num_substring_group, 4);
+	ASSERT_EQ(cf->substring_groups().size(), 1);
+	EXPECT_EQ(cf->substring_groups().begin()->second->size(), 4);
+
+	// each operator keeps its own semantics on the same patterns
+	ASSERT_FALSE(
+	        run("proc.exepath contains /usr or proc.exepath contains BIN or "
+	            "proc.exepath startswith init or proc.exepath endswith /sbin or "
+	            "proc.exepath icontains INITX"));
+	EXPECT_EQ(cf->metrics->m_num_substring_group, 9);
+
+	// patterns can be added after the group has been used for the same event
+	ASSERT_TRUE(run("proc.exepath contains '' and proc.exepath endswith /sbin/init"));
+	EXPECT_EQ(cf->metrics->m_num_substring_group, 11);
+	EXPECT_EQ(cf->substring_groups().begin()->second->size(), 11);
+
+	// comparisons with modifiers or on non-string fields are not grouped
+	ASSERT_TRUE(run("proc.exepath contains anyof (bin, usr)"));
+	ASSERT_TRUE(run("proc.pid = 1 and evt.num > 0"));
+	EXPECT_EQ(cf->substring_groups().size(), 1);
+	EXPECT_EQ(cf->metrics->m_num_substring_group, 11);
+}
+
+TEST_F(sinsp_with_test_input, filter_adaptive_reorder) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	auto run = [&](sinsp_filter& f, int n, bool expected) {
+		for(int i = 0; i < n; i++) {
+			evt->set_num(evt->get_num() + 1);
+			EXPECT_EQ(f.run(evt), expected);
+		}
+	};
+	auto names = [](const sinsp_filter& f) {
+		std::vector<std::string> res;
+		for(const auto& p : f.get_profile()) {
+			res.push_back(std::string(p.m_depth, ' ') + p.m_name);
+		}
+		return res;
+	};
+
+	// the child that is always false moves first in an 'and'
+	auto f = sinsp_filter_compiler(ff, "proc.name = init and proc.exepath contains /usr").compile();
+	f->set_adaptive(true, 1, 4);
+	run(*f, 3, false);
+	EXPECT_EQ(f->get_num_reorders(), 0);
+	run(*f, 1, false);
+	EXPECT_EQ(f->get_num_reorders(), 1);
+	EXPECT_EQ(names(*f),
+	          std::vector<std::string>(
+	                  {"filter", " and", "  proc.exepath contains", "  proc.name ="}));
+	run(*f, 4, false);
+	EXPECT_EQ(f->get_num_reorders(), 1);
+
+	auto profile = f->get_profile();
+	EXPECT_EQ(profile[0].m_num_evals, 8);
+	EXPECT_EQ(profile[0].m_num_samples, 8);
+	EXPECT_EQ(profile[0].pass_rate(), 0);
+	EXPECT_EQ(profile[2].m_num_passes, 0);
+	EXPECT_GT(profile[2].m_num_evals, profile[3].m_num_evals);
+
+	// nested expressions are reordered too, and keep their negations
+	f = sinsp_filter_compiler(ff,
+	                          "proc.exepath contains /usr or "
+	                          "(proc.pid = 1 and (proc.name = foo or not proc.name = bar))")
+	            .compile();
+	f->set_adaptive(true, 1, 2);
+	run(*f, 2, true);
+	EXPECT_EQ(names(*f),
+	          std::vector<std::string>({"filter",
+	                                    " or",
+	                                    "  and",
+	                                    "   proc.pid =",
+	                                    "   or",
+	                                    "    not",
+	                                    "     proc.name =",
+	                                    "    proc.name =",
+	                                    "  proc.exepath contains"}));
+	EXPECT_EQ(f->get_num_reorders(), 2);
+	run(*f, 4, true);
+
+	// disabling the adaptive mode drops the profile but keeps the order
+	f->set_adaptive(false);
+	EXPECT_EQ(f->get_profile()[0].m_num_evals, 0);
+	EXPECT_EQ(f->get_num_reorders(), 0);
+	run(*f, 1, true);
+}
+
+TEST_F(sinsp_with_test_input, filter_adaptive_metrics) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	auto f = sinsp_filter_compiler(ff, "proc.name = init and proc.exepath contains /usr").compile();
+	auto g = sinsp_filter_compiler(ff, "proc.name = init").compile();
+	f->set_adaptive(true, 1, 2);
+	for(int i = 0; i < 4; i++) {
+		evt->set_num(evt->get_num() + 1);
+		f->run(evt);
+		g->run(evt);
+	}
+
+	libs::metrics::libs_metrics_collector collector(&m_inspector, METRICS_V2_FILTER_PROFILE);
+	collector.add_filter("f", f.get());
+	collector.add_filter("g", g.get());
+	collector.snapshot();
+
+	// filters that are not adaptive have no profile
+	std::map<std::string, metrics_v2> metrics;
+	for(const auto& m : collector.get_metrics()) {
+		metrics[m.name] = m;
+	}
+	ASSERT_EQ(metrics.size(), 4);
+	EXPECT_EQ(metrics.at("n_filter_evals_f").value.u64, 4);
+	EXPECT_EQ(metrics.at("filter_pass_ratio_f").value.d, 0);
+	EXPECT_GT(metrics.at("filter_cost_ns_f").value.d, 0);
+	EXPECT_EQ(metrics.at("n_filter_reorders_f").value.u64, 1);
+
+	collector.remove_filter("f");
+	collector.snapshot();
+	EXPECT_TRUE(collector.get_metrics().empty());
+}
+
 TEST_F(sinsp_with_test_input, filter_cache_pointer_instability) {
 	sinsp_filter_check_list flist;
 
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_ruleset.h>
+#include <gtest/gtest.h>
+#include <sinsp_with_test_input.h>
+
+TEST_F(sinsp_with_test_input, filter_ruleset_event_type_index) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	sinsp_filter_ruleset ruleset(ff);
+	ASSERT_EQ(ruleset.add("evt.type = getcwd"), 0);
+	ASSERT_EQ(ruleset.add("evt.type in (open, openat) and proc.name = init"), 1);
+	ASSERT_EQ(ruleset.add("proc.name = init"), 2);
+	ASSERT_EQ(ruleset.add("evt.type = getcwd and proc.name = bash"), 3);
+	ASSERT_EQ(ruleset.add("evt.type = getcwd", "some_plugin_source"), 4);
+	ASSERT_EQ(ruleset.size(), 5);
+
+	std::vector<size_t> expected = {0, 2, 3};
+	ASSERT_EQ(ruleset.filters_for(sinsp_syscall_event_source_name, PPME_SYSCALL_GETCWD_E),
+	          expected);
+	expected = {1, 2};
+	ASSERT_EQ(ruleset.filters_for(sinsp_syscall_event_source_name, PPME_SYSCALL_OPEN_E),
+	          expected);
+	expected = {4};
+	ASSERT_EQ(ruleset.filters_for("some_plugin_source", PPME_SYSCALL_GETCWD_E), expected);
+	ASSERT_TRUE(ruleset.filters_for("unknown", PPME_SYSCALL_GETCWD_E).empty());
+
+	// only the filters that can match a getcwd event are evaluated
+	std::vector<size_t> matches;
+	auto evt = generate_getcwd_failed_entry_event();
+	ASSERT_TRUE(ruleset.run(evt, matches));
+	expected = {0, 2};
+	ASSERT_EQ(matches, expected);
+	ASSERT_EQ(ruleset.stats().m_num_events, 1);
+	ASSERT_EQ(ruleset.stats().m_num_filters_evaluated, 3);
+	ASSERT_EQ(ruleset.stats().m_num_matches, 2);
+
+	ruleset.reset_stats();
+	ASSERT_EQ(ruleset.stats().m_num_events, 0);
+}
+
+TEST_F(sinsp_with_test_input, filter_ruleset_compiled_filters) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	sinsp_filter_ruleset ruleset(ff);
+
+	// the event types given with a compiled filter are used as they are
+	libsinsp::events::set<ppm_event_code> codes;
+	codes.insert(PPME_SYSCALL_OPEN_E);
+	ASSERT_EQ(ruleset.add(sinsp_filter_compiler(ff, "proc.name = init").compile(), codes), 0);
+
+	std::vector<size_t> matches;
+	ASSERT_FALSE(ruleset.run(generate_getcwd_failed_entry_event(), matches));
+	ASSERT_TRUE(matches.empty());
+	ASSERT_EQ(ruleset.stats().m_num_filters_evaluated, 0);
+
+	ASSERT_THROW(ruleset.add("evt.type ="), sinsp_exception);
+	ASSERT_EQ(ruleset.size(), 1);
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter_set.h>
+#include <gtest/gtest.h>
+#include <sinsp_with_test_input.h>
+
+namespace {
+
+struct metrics_cache_factory : public subexpr_sinsp_filter_cache_factory {
+	const std::shared_ptr<sinsp_filter_cache_metrics> metrics =
+	        std::make_shared<sinsp_filter_cache_metrics>();
+
+	std::shared_ptr<sinsp_filter_cache_metrics> new_metrics(const ast_expr_t* e,
+	                                                        node_info_t& info) override {
+		return metrics;
+	}
+};
+
+std::string normalized(const std::string& str) {
+	auto ast = libsinsp::filter::parser(str).parse();
+	return subexpr_sinsp_filter_cache_factory::normalized_string(ast.get());
+}
+
+}  // namespace
+
+TEST(filter_set, normalized_string) {
+	// the order and nesting of the children of a logical operator don't matter
+	ASSERT_EQ(normalized("x.a = 1 and (x.b = 2 and x.c = 3)"),
+	          normalized("x.c = 3 and x.b = 2 and x.a = 1"));
+	ASSERT_EQ(normalized("x.a = 1 or x.b = 2 or x.a = 1"), normalized("x.b = 2 or x.a = 1"));
+	ASSERT_EQ(normalized("x.a = 1 and x.a = 1"), normalized("x.a = 1"));
+	ASSERT_EQ(normalized("not not (x.a = 1 or x.b = 2)"), normalized("x.b = 2 or x.a = 1"));
+
+	ASSERT_NE(normalized("(x.a = 1 or x.b = 2) and x.c = 3"),
+	          normalized("x.a = 1 or (x.b = 2 and x.c = 3)"));
+	ASSERT_NE(normalized("not x.a = 1 and x.b = 2"), normalized("not (x.a = 1 and x.b = 2)"));
+	ASSERT_NE(normalized("x.a = 1 and x.b = 2"), normalized("x.a = 1 or x.b = 2"));
+}
+
+TEST_F(sinsp_with_test_input, filter_set_shared_subexpressions) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	auto cf = std::make_shared<metrics_cache_factory>();
+	sinsp_filter_set set(ff, cf);
+
+	ASSERT_EQ(set.add("evt.type = getcwd and (proc.name = init or proc.name = bash)"), 0);
+	ASSERT_EQ(set.add("(proc.name = bash or proc.name = init) and proc.exepath = /sbin/init"), 1);
+	ASSERT_EQ(set.add("not (proc.name = init or proc.name = bash)"), 2);
+	ASSERT_EQ(set.add("evt.type = open"), 3);
+	ASSERT_EQ(set.size(), 4);
+
+	// the three 'or' share a single node
+	ASSERT_EQ(cf->subexpr_cache().size(), 3);
+
+	auto& res = set.run(evt);
+	ASSERT_EQ(res.size(), 1);
+	ASSERT_EQ(res[0], 0b0011);
+	ASSERT_TRUE(set.matched(0));
+	ASSERT_TRUE(set.matched(1));
+	ASSERT_FALSE(set.matched(2));
+	ASSERT_FALSE(set.matched(3));
+
+	// the 'or' is evaluated once, the other filters read its result
+	EXPECT_EQ(cf->metrics->m_num_compare_cache, 2);
+	EXPECT_EQ(cf->metrics->m_num_compare, 9);
+
+	// results are not shared across events
+	cf->metrics->reset();
+	evt->set_num(evt->get_num() + 1);
+	set.run(evt);
+	ASSERT_EQ(res[0], 0b0011);
+	EXPECT_EQ(cf->metrics->m_num_compare_cache, 2);
+}
+
+TEST_F(sinsp_with_test_input, filter_set_many_filters) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_getcwd_failed_entry_event();
+	auto ff = std::make_shared<sinsp_filter_factory>(&m_inspector, m_default_filterlist);
+	sinsp_filter_set set(ff);
+
+	for(size_t i = 0; i < 100; i++) {
+		auto pid = i % 3 == 0 ? 1 : 1000 + i;
+		set.add("evt.type = getcwd and proc.pid = " + std::to_string(pid));
+	}
+
+	auto& res = set.run(evt);
+	ASSERT_EQ(res.size(), 2);
+	for(size_t i = 0; i < set.size(); i++) {
+		ASSERT_EQ(set.matched(i), i % 3 == 0) << i;
+	}
+
+	ASSERT_THROW(set.add("evt.type = "), sinsp_exception);
+	ASSERT_EQ(set.size(), 100);
+}
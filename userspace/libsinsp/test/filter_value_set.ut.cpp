@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libsinsp/filter_value_set.h>
+
+#include <string>
+#include <vector>
+
+static filter_value_t to_value(const std::string& str) {
+	return filter_value_t((uint8_t*)str.data(), (uint32_t)str.size());
+}
+
+TEST(filter_value_set, contains) {
+	std::vector<std::string> values;
+	for(int i = 0; i < 1000; i++) {
+		values.push_back("/usr/bin/proc" + std::to_string(i));
+	}
+	values.push_back("");
+
+	filter_value_set set;
+	for(const auto& v : values) {
+		set.insert(to_value(v));
+	}
+	// duplicates are ignored
+	set.insert(to_value(values[0]));
+	ASSERT_EQ(set.size(), values.size());
+
+	for(const auto& v : values) {
+		// a copy, so that bytes are compared and not pointers
+		std::string copy = v;
+		ASSERT_TRUE(set.contains(to_value(copy))) << v;
+	}
+
+	ASSERT_FALSE(set.contains(to_value("/usr/bin/proc1000")));
+	ASSERT_FALSE(set.contains(to_value("/usr/bin/proc")));
+	ASSERT_FALSE(set.contains(to_value("a much longer value than all the others in the set")));
+}
+
+TEST(filter_value_set, clear) {
+	std::string a = "a";
+	std::string bb = "bb";
+
+	filter_value_set set;
+	ASSERT_TRUE(set.empty());
+	ASSERT_FALSE(set.contains(to_value(a)));
+
+	set.insert(to_value(a));
+	ASSERT_TRUE(set.contains(to_value(a)));
+
+	set.clear();
+	ASSERT_TRUE(set.empty());
+	ASSERT_FALSE(set.contains(to_value(a)));
+
+	// the length checks are reset too
+	set.insert(to_value(bb));
+	ASSERT_FALSE(set.contains(to_value(a)));
+	ASSERT_TRUE(set.contains(to_value(bb)));
+}
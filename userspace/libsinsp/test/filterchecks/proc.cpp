@@ -305,3 +305,15 @@ TEST_F(sinsp_with_test_input, PROC_FILTER_stdin_stdout_stderr) {
 	ASSERT_EQ(get_field_as_string(evt, "proc.stderr.name"), tuple_str);
 }
 #endif
+
+TEST_F(sinsp_with_test_input, PROC_FILTER_thread_is_partial) {
+	DEFAULT_TREE
+
+	auto evt = generate_random_event(p2_t1_tid);
+	ASSERT_EQ(get_field_as_string(evt, "thread.is_partial"), "false");
+
+	/* the placeholder of an asynchronous lookup */
+	m_inspector.m_thread_manager->find_thread(p2_t1_tid, true)->m_partial = true;
+	evt = generate_random_event(p2_t1_tid);
+	ASSERT_EQ(get_field_as_string(evt, "thread.is_partial"), "true");
+}
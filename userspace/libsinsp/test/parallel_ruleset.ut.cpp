@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/parallel_ruleset.h>
+#include <gtest/gtest.h>
+#include <sinsp_with_test_input.h>
+
+TEST_F(sinsp_with_test_input, parallel_ruleset_ordered_matches) {
+	add_default_init_thread();
+	open_inspector();
+
+	// few pending events, so that submit() has to wait for the workers
+	sinsp_parallel_ruleset ruleset(&m_inspector, m_default_filterlist, 2, 4);
+	ASSERT_EQ(ruleset.num_workers(), 2);
+	ASSERT_EQ(ruleset.add("evt.type = getcwd", "%evt.num %proc.name"), 0);
+	ASSERT_EQ(ruleset.add("evt.type = getcwd and proc.name = init"), 1);
+	ASSERT_EQ(ruleset.add("evt.type = open and proc.name = init"), 2);
+	ASSERT_EQ(ruleset.size(), 3);
+
+	std::vector<uint64_t> evtnums;
+	std::vector<sinsp_parallel_ruleset::match> matches;
+	for(int i = 0; i < 20; i++) {
+		auto evt = generate_getcwd_failed_entry_event();
+		evtnums.push_back(evt->get_num());
+		ruleset.submit(evt);
+		ruleset.poll(matches);
+	}
+	ruleset.flush(matches);
+
+	ASSERT_EQ(matches.size(), 40);
+	for(size_t i = 0; i < evtnums.size(); i++) {
+		const auto& m0 = matches[2 * i];
+		const auto& m1 = matches[2 * i + 1];
+		ASSERT_EQ(m0.m_evtnum, evtnums[i]);
+		ASSERT_EQ(m0.m_filter, 0);
+		ASSERT_EQ(m0.m_output, std::to_string(evtnums[i]) + " init");
+		ASSERT_EQ(m1.m_evtnum, evtnums[i]);
+		ASSERT_EQ(m1.m_filter, 1);
+		ASSERT_EQ(m1.m_output, "");
+	}
+	ASSERT_EQ(ruleset.stats().m_num_submitted, 20);
+	ASSERT_EQ(ruleset.stats().m_num_evaluated, 20);
+	ASSERT_EQ(ruleset.stats().m_num_matches, 40);
+
+	// nothing left to deliver
+	matches.clear();
+	ASSERT_FALSE(ruleset.poll(matches));
+}
+
+TEST_F(sinsp_with_test_input, parallel_ruleset_state_snapshot) {
+	add_default_init_thread();
+	open_inspector();
+
+	sinsp_parallel_ruleset ruleset(&m_inspector, m_default_filterlist, 1);
+	ASSERT_EQ(ruleset.add("proc.name = init", "%proc.name %evt.type"), 0);
+
+	// the thread changes after the event is submitted, the worker still sees
+	// the values it had when the event was parsed
+	auto tinfo = m_inspector.m_thread_manager->find_thread(INIT_TID, true);
+	ASSERT_NE(tinfo, nullptr);
+	ruleset.submit(generate_getcwd_failed_entry_event());
+	tinfo->m_comm = "changed";
+
+	std::vector<sinsp_parallel_ruleset::match> matches;
+	ruleset.flush(matches);
+	ASSERT_EQ(matches.size(), 1);
+	ASSERT_EQ(matches[0].m_output, "init getcwd");
+
+	matches.clear();
+	ruleset.submit(generate_getcwd_failed_entry_event());
+	ruleset.flush(matches);
+	ASSERT_TRUE(matches.empty());
+}
+
+TEST_F(sinsp_with_test_input, parallel_ruleset_unsupported) {
+	add_default_init_thread();
+	open_inspector();
+
+	// without workers, the events are evaluated as they are submitted
+	sinsp_parallel_ruleset ruleset(&m_inspector, m_default_filterlist, 0);
+	ASSERT_EQ(ruleset.num_workers(), 0);
+
+	// these comparisons read the state instead of the extracted values
+	ASSERT_THROW(ruleset.add("fd.ip = 127.0.0.1"), sinsp_exception);
+	ASSERT_THROW(ruleset.add("evt.type = open and fd.net = 10.0.0.0/8"), sinsp_exception);
+	ASSERT_THROW(ruleset.add("proc.aname = bash"), sinsp_exception);
+	ASSERT_THROW(ruleset.add("fd.cnet = 10.0.0.0/8"), sinsp_exception);
+	ASSERT_THROW(ruleset.add("evt.type ="), sinsp_exception);
+	ASSERT_EQ(ruleset.size(), 0);
+
+	ASSERT_EQ(ruleset.add("proc.aname[1] = bash or proc.name = init"), 0);
+	ruleset.submit(generate_getcwd_failed_entry_event());
+	std::vector<sinsp_parallel_ruleset::match> matches;
+	ASSERT_TRUE(ruleset.poll(matches));
+	ASSERT_EQ(matches.size(), 1);
+
+	ASSERT_THROW(ruleset.add("proc.name = bash"), sinsp_exception);
+	ASSERT_EQ(ruleset.size(), 1);
+}
@@ -1031,7 +1031,7 @@ TEST_F(sinsp_with_test_input, plugin_subtables_array) {
 	// obtain a pointer to the subtable (check typing too)
 	auto subtable_acc = field->second.into<libsinsp::state::base_table*>();
 	auto subtable =
-	        dynamic_cast<libsinsp::state::stl_container_table_adapter<std::vector<std::string>>*>(
+	        dynamic_cast<libsinsp::state::stl_container_table_adapter<sinsp_shared_strvec>*>(
 	                entry->read_field(subtable_acc));
 	ASSERT_NE(subtable, nullptr);
 	ASSERT_EQ(subtable->name(), std::string("env"));
@@ -178,6 +178,22 @@ TEST(prefix_search_test, root_dir_match) {
 	ASSERT_TRUE(found);
 }
 
+TEST(prefix_search_test, non_normalized_paths) {
+	path_prefix_search tree;
+	tree.add_search_path("/var/run");
+	tree.add_search_path("etc//");
+
+	// These paths can't be matched by looking up their prefixes as they are, they must give
+	// the same results as the normalized ones.
+	ASSERT_TRUE(tree.match("/var//run/docker"));
+	ASSERT_TRUE(tree.match("var/run"));
+	ASSERT_TRUE(tree.match("/var/run/"));
+	ASSERT_TRUE(tree.match("/etc/passwd"));
+	ASSERT_FALSE(tree.match("//var"));
+	ASSERT_FALSE(tree.match("/"));
+	ASSERT_FALSE(tree.match(""));
+}
+
 TEST(prefix_search_test, maps) {
 	path_prefix_map<uint32_t> tree;
 	uint32_t val;
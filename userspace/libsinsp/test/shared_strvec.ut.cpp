@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libsinsp/shared_strvec.h>
+
+TEST(shared_strvec, copies_and_interning) {
+	size_t interned = sinsp_shared_strvec::interned_count();
+
+	sinsp_shared_strvec a;
+	ASSERT_TRUE(a.empty());
+	ASSERT_EQ(a.shared_id(), nullptr);
+	ASSERT_EQ(a.byte_size(), 0);
+
+	a = std::vector<std::string>{"PATH=/bin", "HOME=/root"};
+	ASSERT_EQ(a.size(), 2);
+	ASSERT_EQ(a[1], "HOME=/root");
+	ASSERT_EQ(sinsp_shared_strvec::interned_count(), interned + 1);
+
+	// copies share the values
+	sinsp_shared_strvec b = a;
+	ASSERT_EQ(b.shared_id(), a.shared_id());
+
+	// values assigned separately are interned
+	sinsp_shared_strvec c = std::vector<std::string>{"PATH=/bin", "HOME=/root"};
+	ASSERT_EQ(c.shared_id(), a.shared_id());
+	ASSERT_EQ(sinsp_shared_strvec::interned_count(), interned + 1);
+
+	sinsp_shared_strvec d = std::vector<std::string>{"PATH=/bin"};
+	ASSERT_NE(d.shared_id(), a.shared_id());
+	ASSERT_EQ(sinsp_shared_strvec::interned_count(), interned + 2);
+
+	// writes only change the written vector
+	b.push_back("TERM=xterm");
+	ASSERT_NE(b.shared_id(), a.shared_id());
+	ASSERT_EQ(b.size(), 3);
+	ASSERT_EQ(a.size(), 2);
+	ASSERT_EQ(c, a);
+	ASSERT_NE(b, a);
+
+	// a written vector is not interned, but still shared by its copies
+	sinsp_shared_strvec e = b;
+	ASSERT_EQ(e.shared_id(), b.shared_id());
+	e.edit()[0] = "PATH=/usr/bin";
+	ASSERT_EQ(b[0], "PATH=/bin");
+	ASSERT_EQ(e[0], "PATH=/usr/bin");
+
+	// interned vectors are released with their last reference
+	a.clear();
+	c.clear();
+	ASSERT_EQ(sinsp_shared_strvec::interned_count(), interned + 1);
+	d = std::vector<std::string>{};
+	ASSERT_TRUE(d.empty());
+	ASSERT_EQ(sinsp_shared_strvec::interned_count(), interned);
+}
@@ -22,6 +22,7 @@ limitations under the License.
 #include <libsinsp/state/table_registry.h>
 #include <libsinsp/sinsp.h>
 #include <cstring>
+#include <set>
 #include <string>
 
 #if defined(__has_feature)
@@ -303,6 +304,57 @@ TEST(dynamic_struct, mem_ownership) {
 	ASSERT_NE(tmpstr1, tmpstr2);
 }
 
+TEST(dynamic_struct, packed_layout) {
+	struct sample_struct : public libsinsp::state::extensible_struct {
+		sample_struct(const std::shared_ptr<libsinsp::state::dynamic_field_infos>& i):
+		        extensible_struct(i) {}
+	};
+
+	auto fields = libsinsp::state::dynamic_field_infos::make<sample_struct>();
+	ASSERT_EQ(fields->block_size(), 0);
+
+	// fields are aligned to their size and packed in definition order
+	auto acc_u8 = fields->add_field("u8", SS_PLUGIN_ST_UINT8).into<uint8_t>();
+	ASSERT_EQ(fields->block_size(), 1);
+	auto acc_u32 = fields->add_field("u32", SS_PLUGIN_ST_UINT32).into<uint32_t>();
+	ASSERT_EQ(fields->block_size(), 8);
+	auto acc_s16 = fields->add_field("s16", SS_PLUGIN_ST_INT16).into<int16_t>();
+	ASSERT_EQ(fields->block_size(), 10);
+	auto acc_str = fields->add_field("str", SS_PLUGIN_ST_STRING).into<std::string>();
+	ASSERT_EQ(fields->block_size(), 16 + sizeof(std::string));
+
+	sample_struct s(fields);
+	s.write_field(acc_u8, (uint8_t)0xff);
+	s.write_field(acc_u32, (uint32_t)0xdeadbeef);
+	s.write_field(acc_s16, (int16_t)-2);
+	s.write_field(acc_str, std::string(100, 'x'));
+
+	// fields defined after the first write grow the storage of the struct
+	auto acc_b = fields->add_field("b", SS_PLUGIN_ST_BOOL).into<bool>();
+	auto acc_s64 = fields->add_field("s64", SS_PLUGIN_ST_INT64).into<int64_t>();
+	bool b = true;
+	s.read_field(acc_b, b);
+	ASSERT_FALSE(b);
+	s.write_field(acc_s64, (int64_t)-42);
+	s.write_field(acc_b, true);
+
+	sample_struct copy(s);
+	for(auto e : {&s, &copy}) {
+		ASSERT_EQ(e->read_field(acc_u8), 0xff);
+		ASSERT_EQ(e->read_field(acc_u32), 0xdeadbeef);
+		ASSERT_EQ(e->read_field(acc_s16), -2);
+		ASSERT_EQ(e->read_field(acc_str), std::string(100, 'x'));
+		ASSERT_EQ(e->read_field(acc_b), true);
+		ASSERT_EQ(e->read_field(acc_s64), -42);
+	}
+
+	// moving leaves the source without fields
+	sample_struct moved(std::move(s));
+	ASSERT_EQ(moved.read_field(acc_str), std::string(100, 'x'));
+	moved = std::move(copy);
+	ASSERT_EQ(moved.read_field(acc_s64), -42);
+}
+
 TEST(table_registry, defs_and_access) {
 	class sample_table : public libsinsp::state::extensible_table<uint64_t> {
 	public:
@@ -615,6 +667,68 @@ TEST(thread_manager, fdtable_access) {
 	ASSERT_EQ(subtable->entries_count(), 0);
 }
 
+TEST(thread_manager, fdtable_small_and_large_fds) {
+	sinsp inspector;
+	auto table = dynamic_cast<libsinsp::state::extensible_table<int64_t>*>(
+	        inspector.get_table_registry()->get_table<int64_t>("threads"));
+	ASSERT_NE(table->add_entry(0, table->new_entry()), nullptr);
+	auto& fdtable = dynamic_cast<sinsp_threadinfo*>(table->get_entry(0).get())->get_fdtable();
+	auto new_fdinfo = [&]() {
+		return std::shared_ptr<sinsp_fdinfo>(
+		        dynamic_cast<sinsp_fdinfo*>(fdtable.new_entry().release()));
+	};
+
+	// fds below the direct-indexing limit, above it and negative ones
+	std::set<int64_t> fds = {0, 1, 2, 1023, 1024, 100000, -5};
+	for(auto fd : fds) {
+		ASSERT_NE(fdtable.add(fd, new_fdinfo()), nullptr);
+	}
+	ASSERT_EQ(fdtable.size(), fds.size());
+	for(auto fd : fds) {
+		ASSERT_NE(fdtable.find(fd), nullptr) << fd;
+		ASSERT_EQ(fdtable.find(fd)->m_fd, fd);
+	}
+	ASSERT_EQ(fdtable.find(3), nullptr);
+	ASSERT_EQ(fdtable.find(1025), nullptr);
+	ASSERT_EQ(fdtable.find(-1), nullptr);
+
+	// replacing an fd
+	auto fdinfo = new_fdinfo();
+	auto fdinfo_ptr = fdinfo.get();
+	ASSERT_EQ(fdtable.add(2, std::move(fdinfo)), fdinfo_ptr);
+	ASSERT_EQ(fdtable.find(2), fdinfo_ptr);
+	ASSERT_EQ(fdtable.size(), fds.size());
+
+	std::set<int64_t> looped;
+	ASSERT_TRUE(fdtable.loop([&](int64_t fd, sinsp_fdinfo& info) {
+		EXPECT_EQ(info.m_fd, fd);
+		looped.insert(fd);
+		return true;
+	}));
+	ASSERT_EQ(looped, fds);
+
+	ASSERT_TRUE(fdtable.erase(1023));
+	ASSERT_FALSE(fdtable.erase(1023));
+	ASSERT_TRUE(fdtable.erase(-5));
+	ASSERT_FALSE(fdtable.erase(5000));
+	ASSERT_EQ(fdtable.size(), fds.size() - 2);
+
+	fdtable.retain([](int64_t fd, const sinsp_fdinfo&) { return fd % 2 == 0; });
+	looped.clear();
+	ASSERT_TRUE(fdtable.const_loop([&](int64_t fd, const sinsp_fdinfo&) {
+		looped.insert(fd);
+		return true;
+	}));
+	ASSERT_EQ(looped, std::set<int64_t>({0, 2, 1024, 100000}));
+	ASSERT_EQ(fdtable.size(), 4);
+	ASSERT_EQ(fdtable.find(1), nullptr);
+
+	fdtable.clear();
+	ASSERT_EQ(fdtable.size(), 0);
+	ASSERT_EQ(fdtable.find(0), nullptr);
+	ASSERT_EQ(fdtable.find(1024), nullptr);
+}
+
 TEST(thread_manager, env_vars_access) {
 	sinsp inspector;
 	auto& reg = inspector.get_table_registry();
@@ -646,7 +760,7 @@ TEST(thread_manager, env_vars_access) {
 	// getting the "env" tables from the newly created threads
 	auto subtable_acc = field->second.into<libsinsp::state::base_table*>();
 	auto subtable =
-	        dynamic_cast<libsinsp::state::stl_container_table_adapter<std::vector<std::string>>*>(
+	        dynamic_cast<libsinsp::state::stl_container_table_adapter<sinsp_shared_strvec>*>(
 	                entry->read_field(subtable_acc));
 	ASSERT_NE(subtable, nullptr);
 	EXPECT_EQ(subtable->name(), std::string("env"));
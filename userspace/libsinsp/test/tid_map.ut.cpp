@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+
+#include <libsinsp/tid_map.h>
+
+#include <map>
+#include <random>
+
+TEST(tid_map, put_get_erase) {
+	tid_map<int64_t> map;
+	ASSERT_EQ(map.get(1), nullptr);
+	ASSERT_EQ(map.find(1), nullptr);
+	map.erase(1);
+
+	for(int64_t tid = -10; tid < 1000; tid++) {
+		map.put(tid, std::make_shared<int64_t>(tid));
+	}
+	ASSERT_EQ(map.size(), 1010);
+	for(int64_t tid = -10; tid < 1000; tid++) {
+		ASSERT_NE(map.get(tid), nullptr);
+		ASSERT_EQ(*map.get(tid), tid);
+	}
+	ASSERT_EQ(map.get(1000), nullptr);
+
+	// replacing an entry
+	map.put(5, std::make_shared<int64_t>(50));
+	ASSERT_EQ(map.size(), 1010);
+	ASSERT_EQ(*map.get(5), 50);
+
+	for(int64_t tid = 0; tid < 1000; tid += 2) {
+		map.erase(tid);
+	}
+	ASSERT_EQ(map.size(), 510);
+	for(int64_t tid = 0; tid < 1000; tid++) {
+		ASSERT_EQ(map.get(tid) != nullptr, tid % 2 == 1) << tid;
+	}
+
+	map.clear();
+	ASSERT_EQ(map.size(), 0);
+	ASSERT_EQ(map.get(1), nullptr);
+	map.put(1, std::make_shared<int64_t>(1));
+	ASSERT_EQ(*map.get(1), 1);
+}
+
+TEST(tid_map, stable_references) {
+	tid_map<int64_t> map;
+	const auto& ref = map.put(42, std::make_shared<int64_t>(42));
+	auto obj = ref;
+	ASSERT_EQ(obj.use_count(), 2);
+
+	// growing the table and moving slots around doesn't move the pointers
+	for(int64_t tid = 0; tid < 10000; tid++) {
+		if(tid != 42) {
+			map.put(tid, std::make_shared<int64_t>(tid));
+		}
+	}
+	for(int64_t tid = 0; tid < 10000; tid += 3) {
+		if(tid != 42) {
+			map.erase(tid);
+		}
+	}
+	ASSERT_EQ(&ref, map.find(42));
+	ASSERT_EQ(ref.get(), obj.get());
+
+	// erasing releases the object
+	map.erase(42);
+	ASSERT_EQ(obj.use_count(), 1);
+}
+
+TEST(tid_map, random_operations) {
+	// compare against a reference map on a random mix of operations on
+	// clustered tids, so that the backward-shift deletion is exercised
+	std::mt19937_64 rng(1234);
+	std::uniform_int_distribution<int64_t> tids(0, 4096);
+	std::map<int64_t, int64_t> expected;
+	tid_map<int64_t> map;
+
+	for(int i = 0; i < 200000; i++) {
+		int64_t tid = tids(rng);
+		switch(rng() % 3) {
+		case 0:
+		case 1:
+			map.put(tid, std::make_shared<int64_t>(i));
+			expected[tid] = i;
+			break;
+		default:
+			map.erase(tid);
+			expected.erase(tid);
+			break;
+		}
+	}
+
+	ASSERT_EQ(map.size(), expected.size());
+	for(int64_t tid = 0; tid <= 4096; tid++) {
+		auto it = expected.find(tid);
+		if(it == expected.end()) {
+			ASSERT_EQ(map.get(tid), nullptr) << tid;
+		} else {
+			ASSERT_NE(map.get(tid), nullptr) << tid;
+			ASSERT_EQ(*map.get(tid), it->second) << tid;
+		}
+	}
+
+	std::map<int64_t, int64_t> looped;
+	ASSERT_TRUE(map.loop([&](int64_t tid, const std::shared_ptr<int64_t>& v) {
+		looped[tid] = *v;
+		return true;
+	}));
+	ASSERT_EQ(looped, expected);
+
+	size_t n = 0;
+	ASSERT_FALSE(map.loop([&](int64_t, const std::shared_ptr<int64_t>&) { return ++n < 10; }));
+	ASSERT_EQ(n, 10);
+}
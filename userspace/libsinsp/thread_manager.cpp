@@ -902,6 +902,7 @@ const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t ti
 		}
 
 		bool thread_fetched = false;
+		bool lookup_queued = false;
 
 		if(main_thread) {
 			m_n_main_thread_lookups++;
@@ -914,7 +915,14 @@ const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t ti
 			}
 
 			const uint64_t ts_start = sinsp_utils::get_current_time_ns();
-			thread_fetched = scap_proc_get(m_scap_platform, tid, scan_sockets) == SCAP_SUCCESS;
+			if(m_async_lookup) {
+				// The placeholder added below is completed later, its duration is
+				// accounted when the lookup completes.
+				m_async_lookup->request(tid, scan_sockets);
+				lookup_queued = true;
+			} else {
+				thread_fetched = scap_proc_get(m_scap_platform, tid, scan_sockets) == SCAP_SUCCESS;
+			}
 			const uint64_t ts_end = sinsp_utils::get_current_time_ns();
 
 			m_n_proc_lookups_duration_ns += (ts_end - ts_start);
@@ -930,7 +938,8 @@ const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t ti
 			}
 		}
 
-		// Add a fake entry to avoid a continuous lookup.
+		// Add a fake entry to avoid a continuous lookup. With the asynchronous lookups,
+		// it is a placeholder until the thread is read.
 		if(!thread_fetched) {
 			auto fake_tinfo = m_threadinfo_factory.create();
 			fake_tinfo->m_tid = tid;
@@ -943,6 +952,7 @@ const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t ti
 			fake_tinfo->m_uid = 0xffffffff;
 			fake_tinfo->m_gid = 0xffffffff;
 			fake_tinfo->m_loginuid = 0xffffffff;
+			fake_tinfo->m_partial = lookup_queued;
 			add_thread(std::move(fake_tinfo), true);
 		}
 
@@ -1014,6 +1024,10 @@ void sinsp_thread_manager::set_max_thread_table_size(uint32_t value) {
 	m_max_thread_table_size = value;
 }
 
+void sinsp_thread_manager::start_async_lookups(const std::shared_ptr<sinsp_thread_pool>& tpool) {
+	m_async_lookup = std::make_unique<sinsp_async_thread_lookup>(m_scap_platform, tpool);
+}
+
 static constexpr uint64_t make_key(uint64_t ptid, uint64_t tid) {
 	constexpr uint64_t mask32 = 0xFFFFFFFFULL;
 	return ((ptid & mask32) << 32) | (tid & mask32);
@@ -24,8 +24,10 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <libscap/scap_savefile_api.h>
+#include <libsinsp/async_thread_lookup.h>
 #include <libsinsp/fdtable.h>
 #include <libsinsp/state/table.h>
 #include <libsinsp/event.h>
@@ -155,6 +157,22 @@ public:
 
 	threadinfo_map_t* get_threads() { return &m_threadtable; }
 
+	// Cache hints for the entries the next events are going to use, see
+	// sinsp::set_decode_workers(). They don't change the table.
+	inline void prefetch_thread_slot(int64_t tid) const { m_threadtable.prefetch(tid); }
+	inline void prefetch_thread(int64_t tid) const {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(m_threadtable.get(tid));
+#endif
+	}
+	inline void prefetch_fd(int64_t tid, int64_t fd) {
+		sinsp_threadinfo* tinfo = m_threadtable.get(tid);
+		const sinsp_fdtable* fdtable = tinfo != nullptr ? tinfo->get_fd_table() : nullptr;
+		if(fdtable != nullptr) {
+			fdtable->prefetch(fd);
+		}
+	}
+
 	std::set<uint16_t> m_server_ports;
 
 	void set_max_thread_table_size(uint32_t value);
@@ -168,6 +186,30 @@ public:
 		m_n_proc_lookups_duration_ns = 0;
 	}
 
+	/*!
+	  \brief Read the threads missing from the table from /proc on a routine of `tpool`,
+	  instead of the calling thread: get_thread() adds them right away as partial
+	  placeholders. See sinsp::set_async_thread_lookups().
+	*/
+	void start_async_lookups(const std::shared_ptr<sinsp_thread_pool>& tpool);
+
+	// Stops the lookups, waiting for the one in progress. Pending ones are dropped.
+	void stop_async_lookups() { m_async_lookup.reset(); }
+
+	inline bool has_async_lookups() const { return m_async_lookup != nullptr; }
+
+	// Returns the lookups completed since the last call, for the caller to add them.
+	std::vector<std::unique_ptr<sinsp_async_thread_lookup::result>> collect_async_lookups() {
+		if(!m_async_lookup || !m_async_lookup->has_results()) {
+			return {};
+		}
+		return m_async_lookup->collect();
+	}
+
+	void add_async_lookup_duration(uint64_t duration_ns) {
+		m_n_proc_lookups_duration_ns += duration_ns;
+	}
+
 	void set_m_max_n_proc_lookups(int32_t val) { m_max_n_proc_lookups = val; }
 	void set_m_max_n_proc_socket_lookups(int32_t val) { m_max_n_proc_socket_lookups = val; }
 	/*!
@@ -319,6 +361,7 @@ private:
 	int32_t m_max_n_proc_socket_lookups = -1;
 	uint64_t m_proc_lookup_period = 0;
 	uint64_t m_last_proc_lookup_period_start = 0;
+	std::unique_ptr<sinsp_async_thread_lookup> m_async_lookup;
 
 	const std::shared_ptr<sinsp_threadinfo>
 	        m_nullptr_tinfo_ret;  // needed for returning a reference
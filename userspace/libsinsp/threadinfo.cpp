@@ -180,6 +180,7 @@ void sinsp_threadinfo::init() {
 	m_exe_ino_ctime_duration_clone_ts = 0;
 	m_exe_ino_ctime_duration_pidns_start = 0;
 	m_filtered_out = false;
+	m_partial = false;
 	m_exe_writable = false;
 	m_exe_upper_layer = false;
 	m_exe_lower_layer = false;
@@ -425,7 +426,11 @@ void sinsp_threadinfo::set_args(const char* args, size_t len) {
 }
 
 void sinsp_threadinfo::set_args(const std::vector<std::string>& args) {
-	m_args = args;
+	set_args(std::vector<std::string>(args));
+}
+
+void sinsp_threadinfo::set_args(std::vector<std::string>&& args) {
+	m_args = std::move(args);
 	m_cmd_line = get_comm();
 	if(!m_cmd_line.empty()) {
 		for(const auto& arg : m_args) {
@@ -472,15 +477,16 @@ bool sinsp_threadinfo::set_env_from_proc() {
 		return false;
 	}
 
-	m_env.clear();
+	std::vector<std::string> envs;
 	while(environment) {
 		std::string env;
 		getline(environment, env, '\0');
 		if(!env.empty()) {
-			m_env.emplace_back(env);
+			envs.emplace_back(std::move(env));
 		}
 	}
 
+	m_env = std::move(envs);
 	return true;
 }
 
@@ -33,7 +33,9 @@ struct iovec {
 #include <memory>
 #include <libsinsp/sinsp_fdtable_factory.h>
 #include <libsinsp/fdtable.h>
+#include <libsinsp/shared_strvec.h>
 #include <libsinsp/thread_group_info.h>
+#include <libsinsp/tid_map.h>
 #include <libsinsp/state/table.h>
 #include <libsinsp/state/table_adapters.h>
 #include <libsinsp/event.h>
@@ -370,9 +372,9 @@ public:
 	bool m_exe_lower_layer;  ///< True if the executable file belongs to lower layer in overlayfs
 	bool m_exe_from_memfd;   ///< True if the executable is stored in fileless memory referenced by
 	                         ///< memfd
-	std::vector<std::string> m_args;  ///< Command line arguments (e.g. "-d1")
-	std::vector<std::string> m_env;   ///< Environment variables
-	cgroups_t m_cgroups;              ///< subsystem-cgroup pairs
+	sinsp_shared_strvec m_args;  ///< Command line arguments (e.g. "-d1")
+	sinsp_shared_strvec m_env;   ///< Environment variables
+	cgroups_t m_cgroups;         ///< subsystem-cgroup pairs
 	uint32_t m_flags;   ///< The thread flags. See the PPM_CL_* declarations in ppm_events_public.h.
 	int64_t m_fdlimit;  ///< The maximum number of FDs this thread can open
 	uint32_t m_uid;     ///< uid
@@ -409,6 +411,8 @@ public:
 	std::string m_cmd_line;
 	bool m_filtered_out;  ///< True if this thread is filtered out by the inspector filter from
 	                      ///< saving to a capture
+	bool m_partial;  ///< True if this thread is a placeholder, waiting for its information to be
+	                 ///< read from /proc in the background (see sinsp::set_async_thread_lookups)
 
 	//
 	// State for multi-event processing
@@ -459,6 +463,7 @@ public:
 	void update_cwd(std::string_view cwd);
 	void set_args(const char* args, size_t len);
 	void set_args(const std::vector<std::string>& args);
+	void set_args(std::vector<std::string>&& args);
 	void set_env(const char* env, size_t len, bool can_load_from_proc);
 	void set_cgroups(const char* cgroups, size_t len);
 	void set_cgroups(const std::vector<std::string>& cgroups);
@@ -562,25 +567,18 @@ public:
 	typedef std::function<bool(sinsp_threadinfo&)> visitor_t;
 	typedef std::shared_ptr<sinsp_threadinfo> ptr_t;
 
-	inline const ptr_t& put(const ptr_t& tinfo) {
-		m_threads[tinfo->m_tid] = tinfo;
-		return m_threads[tinfo->m_tid];
-	}
+	inline const ptr_t& put(const ptr_t& tinfo) { return m_threads.put(tinfo->m_tid, tinfo); }
 
-	inline sinsp_threadinfo* get(uint64_t tid) {
-		auto it = m_threads.find(tid);
-		if(it == m_threads.end()) {
-			return nullptr;
-		}
-		return it->second.get();
-	}
+	inline sinsp_threadinfo* get(uint64_t tid) const { return m_threads.get(tid); }
+
+	inline void prefetch(uint64_t tid) const { m_threads.prefetch(tid); }
 
 	inline const ptr_t& get_ref(uint64_t tid) {
-		auto it = m_threads.find(tid);
-		if(it == m_threads.end()) {
+		const ptr_t* ref = m_threads.find(tid);
+		if(ref == nullptr) {
 			return m_nullptr_ret;
 		}
-		return it->second;
+		return *ref;
 	}
 
 	inline void erase(uint64_t tid) { m_threads.erase(tid); }
@@ -588,35 +586,20 @@ public:
 	inline void clear() { m_threads.clear(); }
 
 	bool const_loop_shared_pointer(const_shared_ptr_visitor_t callback) {
-		for(auto& it : m_threads) {
-			if(!callback(it.second)) {
-				return false;
-			}
-		}
-		return true;
+		return m_threads.loop([&](int64_t, const ptr_t& tinfo) { return callback(tinfo); });
 	}
 
 	bool const_loop(const_visitor_t callback) const {
-		for(const auto& it : m_threads) {
-			if(!callback(*it.second)) {
-				return false;
-			}
-		}
-		return true;
+		return m_threads.loop([&](int64_t, const ptr_t& tinfo) { return callback(*tinfo); });
 	}
 
 	bool loop(visitor_t callback) {
-		for(auto& it : m_threads) {
-			if(!callback(*it.second)) {
-				return false;
-			}
-		}
-		return true;
+		return m_threads.loop([&](int64_t, const ptr_t& tinfo) { return callback(*tinfo); });
 	}
 
 	inline size_t size() const { return m_threads.size(); }
 
 protected:
-	std::unordered_map<int64_t, ptr_t> m_threads;
+	tid_map<sinsp_threadinfo> m_threads;
 	const ptr_t m_nullptr_ret;  // needed for returning a reference
 };
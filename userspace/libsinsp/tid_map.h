@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//
+// Map of thread ids to shared objects, used as the thread table. It is looked
+// up on almost every event, and may hold hundreds of thousands of entries, so:
+// - the entries are kept in a flat open-addressing table (linear probing,
+//   backward-shift deletion, no tombstones), every slot has the tid and a raw
+//   pointer to its object, so a lookup hits one slot and then the object;
+// - the shared pointers are stored in pooled chunks and recycled on erase, so
+//   inserting and erasing entries doesn't allocate once the pool is warm, and
+//   the references returned by put() and find() stay valid until the entry is
+//   erased, even if the table is grown.
+//
+template<typename T>
+class tid_map {
+public:
+	using ptr_t = std::shared_ptr<T>;
+
+	tid_map() = default;
+	tid_map(const tid_map&) = delete;
+	tid_map& operator=(const tid_map&) = delete;
+	tid_map(tid_map&&) = default;
+	tid_map& operator=(tid_map&&) = default;
+
+	// Inserts the object, or replaces the one of the same tid.
+	const ptr_t& put(int64_t tid, const ptr_t& val) {
+		slot* s = find_slot(tid);
+		if(s != nullptr) {
+			*s->ref = val;
+			s->raw = val.get();
+			return *s->ref;
+		}
+
+		if((m_size + 1) * 2 > m_slots.size()) {
+			grow();
+		}
+		ptr_t* ref = alloc_ref();
+		*ref = val;
+		insert_slot(m_slots, m_shift, {tid, val.get(), ref});
+		m_size++;
+		return *ref;
+	}
+
+	inline T* get(int64_t tid) const {
+		const slot* s = find_slot(tid);
+		return s != nullptr ? s->raw : nullptr;
+	}
+
+	// Hints the cache about the slot a lookup of `tid` starts from.
+	inline void prefetch(int64_t tid) const {
+#if defined(__GNUC__) || defined(__clang__)
+		if(m_size != 0) {
+			__builtin_prefetch(&m_slots[bucket(tid, m_shift)]);
+		}
+#endif
+	}
+
+	inline const ptr_t* find(int64_t tid) const {
+		const slot* s = find_slot(tid);
+		return s != nullptr ? s->ref : nullptr;
+	}
+
+	void erase(int64_t tid) {
+		slot* s = find_slot(tid);
+		if(s == nullptr) {
+			return;
+		}
+		s->ref->reset();
+		m_free.push_back(s->ref);
+		m_size--;
+
+		// Shift back the following entries of the cluster that would not be
+		// found anymore after emptying this slot.
+		size_t mask = m_slots.size() - 1;
+		size_t hole = s - m_slots.data();
+		for(size_t i = (hole + 1) & mask; m_slots[i].ref != nullptr; i = (i + 1) & mask) {
+			size_t home = bucket(m_slots[i].tid, m_shift);
+			if(((i - home) & mask) >= ((i - hole) & mask)) {
+				m_slots[hole] = m_slots[i];
+				hole = i;
+			}
+		}
+		m_slots[hole] = slot{};
+	}
+
+	// Removes all the entries and releases the memory.
+	void clear() {
+		m_slots.clear();
+		m_shift = 64;
+		m_size = 0;
+		m_chunks.clear();
+		m_free.clear();
+	}
+
+	inline size_t size() const { return m_size; }
+
+	// Calls `f(tid, ptr)` for every entry, in no particular order, until it
+	// returns false. The map must not be modified meanwhile.
+	template<typename F>
+	bool loop(F&& f) const {
+		for(const auto& s : m_slots) {
+			if(s.ref != nullptr && !f(s.tid, *s.ref)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	struct slot {
+		int64_t tid = 0;
+		T* raw = nullptr;
+		ptr_t* ref = nullptr;  // nullptr marks an empty slot
+	};
+
+	static constexpr size_t s_min_slots = 64;
+	static constexpr size_t s_chunk_size = 1024;
+
+	// Fibonacci hashing: tids are mostly sequential, the multiplication spreads
+	// them on the high bits, which select the slot.
+	static inline size_t bucket(int64_t tid, uint32_t shift) {
+		return (size_t)(((uint64_t)tid * UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+	}
+
+	inline slot* find_slot(int64_t tid) const {
+		if(m_size == 0) {
+			return nullptr;
+		}
+		size_t mask = m_slots.size() - 1;
+		for(size_t i = bucket(tid, m_shift);; i = (i + 1) & mask) {
+			const slot& s = m_slots[i];
+			if(s.ref == nullptr) {
+				return nullptr;
+			}
+			if(s.tid == tid) {
+				return const_cast<slot*>(&s);
+			}
+		}
+	}
+
+	static void insert_slot(std::vector<slot>& slots, uint32_t shift, const slot& s) {
+		size_t mask = slots.size() - 1;
+		size_t i = bucket(s.tid, shift);
+		while(slots[i].ref != nullptr) {
+			i = (i + 1) & mask;
+		}
+		slots[i] = s;
+	}
+
+	void grow() {
+		size_t nslots = m_slots.empty() ? s_min_slots : m_slots.size() * 2;
+		uint32_t shift = m_slots.empty() ? 64 - 6 : m_shift - 1;
+		std::vector<slot> slots(nslots);
+		for(const auto& s : m_slots) {
+			if(s.ref != nullptr) {
+				insert_slot(slots, shift, s);
+			}
+		}
+		m_slots.swap(slots);
+		m_shift = shift;
+	}
+
+	ptr_t* alloc_ref() {
+		if(m_free.empty()) {
+			m_chunks.emplace_back(new ptr_t[s_chunk_size]);
+			for(size_t i = s_chunk_size; i > 0; i--) {
+				m_free.push_back(&m_chunks.back()[i - 1]);
+			}
+		}
+		ptr_t* ref = m_free.back();
+		m_free.pop_back();
+		return ref;
+	}
+
+	std::vector<slot> m_slots;
+	uint32_t m_shift = 64;
+	size_t m_size = 0;
+	std::vector<std::unique_ptr<ptr_t[]>> m_chunks;
+	std::vector<ptr_t*> m_free;
+};